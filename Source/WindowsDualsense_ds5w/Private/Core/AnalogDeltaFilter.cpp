@@ -0,0 +1,82 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/AnalogDeltaFilter.h"
+#include "HAL/PlatformTime.h"
+#include "InputCoreTypes.h"
+#include "Core/InputLatencyStats.h"
+#include "Core/Structs/FGamepadState.h"
+
+FAnalogDeltaFilter::FAnalogDeltaFilter():
+	LastValues{},
+	LastCycles{},
+	bHasLastValues(false),
+	DispatchedEvents(0),
+	SuppressedEvents(0)
+{
+}
+
+void FAnalogDeltaFilter::Configure(const FAnalogDispatchSettings& InSettings)
+{
+	Settings = InSettings;
+	Reset();
+}
+
+void FAnalogDeltaFilter::Reset()
+{
+	bHasLastValues = false;
+}
+
+void FAnalogDeltaFilter::Dispatch(FGenericApplicationMessageHandler& MessageHandler, const FPlatformUserId UserId,
+                                  const FInputDeviceId InputDeviceId, const FGamepadState& State)
+{
+	static const FName AxisNames[FAnalogDispatchSettings::Count] = {
+		FGamepadKeyNames::LeftAnalogX,
+		FGamepadKeyNames::LeftAnalogY,
+		FGamepadKeyNames::RightAnalogX,
+		FGamepadKeyNames::RightAnalogY,
+		FGamepadKeyNames::LeftTriggerAnalog,
+		FGamepadKeyNames::RightTriggerAnalog,
+	};
+
+	const float Values[FAnalogDispatchSettings::Count] = {
+		State.LeftAnalogX, State.LeftAnalogY, State.RightAnalogX, State.RightAnalogY,
+		State.LeftTrigger, State.RightTrigger
+	};
+
+	const uint64 NowCycles = Settings.bDeltaOnly ? FPlatformTime::Cycles64() : 0;
+	const uint64 KeepAliveCycles = Settings.KeepAliveSeconds > 0.0f
+		                               ? static_cast<uint64>(Settings.KeepAliveSeconds / FPlatformTime::GetSecondsPerCycle64())
+		                               : 0;
+
+	uint32 Dispatched = 0;
+	for (int32 Axis = 0; Axis < FAnalogDispatchSettings::Count; ++Axis)
+	{
+		const float Value = Values[Axis];
+		if (Settings.bDeltaOnly && bHasLastValues)
+		{
+			const float Last = LastValues[Axis];
+			const bool bMoved = FMath::Abs(Value - Last) > Settings.Epsilon[Axis];
+			// Coming back to rest is always sent, so a small final step never leaves an axis off-center.
+			const bool bRested = Value == 0.0f && Last != 0.0f;
+			const bool bKeepAlive = KeepAliveCycles != 0 && NowCycles - LastCycles[Axis] >= KeepAliveCycles;
+			if (!bMoved && !bRested && !bKeepAlive)
+			{
+				continue;
+			}
+		}
+
+		MessageHandler.OnControllerAnalog(AxisNames[Axis], UserId, InputDeviceId, Value);
+		LastValues[Axis] = Value;
+		LastCycles[Axis] = NowCycles;
+		++Dispatched;
+	}
+	bHasLastValues = true;
+
+	const uint32 Suppressed = FAnalogDispatchSettings::Count - Dispatched;
+	DispatchedEvents += Dispatched;
+	SuppressedEvents += Suppressed;
+	INC_DWORD_STAT_BY(STAT_DualSense_AnalogEvents, Dispatched);
+	INC_DWORD_STAT_BY(STAT_DualSense_AnalogSuppressed, Suppressed);
+}
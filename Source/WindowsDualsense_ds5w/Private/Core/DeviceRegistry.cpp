@@ -5,9 +5,11 @@
 #include "Core/DeviceRegistry.h"
 #include "Async/Async.h"
 #include "Async/TaskGraphInterfaces.h"
-#include "Core/HIDPollingRunnable.h"
+#include "Core/HIDWatchdogRunnable.h"
 #include "Core/HIDDeviceInfo.h"
+#if PLATFORM_WINDOWS
 #include "Windows/WindowsApplication.h"
+#endif
 #include "Core/DualSense/DualSenseLibrary.h"
 #include "Core/DualShock/DualShockLibrary.h"
 #include "GameFramework/InputSettings.h"
@@ -21,12 +23,56 @@ TSharedPtr<FDeviceRegistry> FDeviceRegistry::Instance;
 TMap<FString, FInputDeviceId> FDeviceRegistry::KnownDevicePaths;
 TMap<FString, FInputDeviceId> FDeviceRegistry::HistoryDevices;
 TMap<FInputDeviceId, ISonyGamepadInterface*> FDeviceRegistry::LibraryInstances;
-TMap<int32, TUniquePtr<FHIDPollingRunnable>> FDeviceRegistry::ActiveConnectionWatchers;
+TUniquePtr<FHIDWatchdogRunnable> FDeviceRegistry::ConnectionWatchdog;
+std::atomic_bool FDeviceRegistry::bDevicesChangedPending{false};
+
+void FDeviceRegistry::UpdateDeviceNotifications()
+{
+	const TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport = FHIDDeviceInfo::GetTransport();
+	if (!Transport || ObservedTransport.Pin() == Transport)
+	{
+		return;
+	}
+
+	StopDeviceNotifications();
+	ObservedTransport = Transport;
+
+	// A new transport may expose a different set of devices, so always enumerate it once.
+	bDevicesChangedPending.store(true, std::memory_order_release);
+	if (Transport->StartDeviceNotifications([]()
+	{
+		bDevicesChangedPending.store(true, std::memory_order_release);
+	}))
+	{
+		NotificationTransport = Transport;
+	}
+}
+
+void FDeviceRegistry::StopDeviceNotifications()
+{
+	if (NotificationTransport)
+	{
+		NotificationTransport->StopDeviceNotifications();
+		NotificationTransport.Reset();
+	}
+}
 
 bool PrimaryTick = true;
 float AccumulateSecurity = 0;
 void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 {
+	UpdateDeviceNotifications();
+
+	// A library that lost its device only flags it; releasing it and its handle happens here.
+	for (const TPair<FInputDeviceId, ISonyGamepadInterface*>& LibraryInstance : LibraryInstances)
+	{
+		if (!LibraryInstance.Value->IsConnected())
+		{
+			bDevicesChangedPending.store(true, std::memory_order_release);
+			break;
+		}
+	}
+
 	AccumulateSecurity += DeltaTime;
 	if (bIsDeviceDetectionInProgress && AccumulateSecurity >= 1.f)
 	{
@@ -36,7 +82,13 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 	if (!PrimaryTick)
 	{
 		AccumulatorDelta += DeltaTime;
-		if (AccumulatorDelta < 2.0f || bIsDeviceDetectionInProgress)
+		if (bIsDeviceDetectionInProgress)
+		{
+			return;
+		}
+
+		const bool bPollingDue = AccumulatorDelta >= 2.0f && (!NotificationTransport || bRetryDetection);
+		if (!bDevicesChangedPending.exchange(false, std::memory_order_acq_rel) && !bPollingDue)
 		{
 			return;
 		}
@@ -45,6 +97,9 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 	}
 
 	PrimaryTick = false;
+	bDevicesChangedPending.store(false, std::memory_order_release);
+	bRetryDetection = false;
+	AccumulateSecurity = 0;
 	bIsDeviceDetectionInProgress = true;
 
 	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakManager = AsWeak()]()
@@ -74,7 +129,9 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 				{
 					const FString& Path = KnownDevice.Key;
 					const FInputDeviceId& DeviceId = KnownDevice.Value;
-					if (!CurrentlyConnectedPaths.Contains(Path))
+					const bool bLibraryLost = Manager->LibraryInstances.Contains(DeviceId) &&
+						!Manager->LibraryInstances[DeviceId]->IsConnected();
+					if (!CurrentlyConnectedPaths.Contains(Path) || bLibraryLost)
 					{
 						if (Manager->LibraryInstances.Contains(DeviceId))
 						{
@@ -101,8 +158,9 @@ void FDeviceRegistry::DetectedChangeConnections(float DeltaTime)
 						Context.Output = FOutputContext();
 						Context.Handle = HidManagerObj->CreateHandle(&Context);
 
-						if (Context.Handle == INVALID_HANDLE_VALUE)
+						if (Context.Handle == IHidTransport::InvalidHandle())
 						{
+							Manager->bRetryDetection = true;
 							continue;
 						}
 
@@ -127,13 +185,17 @@ TSharedPtr<FDeviceRegistry> FDeviceRegistry::Get()
 
 FDeviceRegistry::~FDeviceRegistry()
 {
-	TArray<int32> WatcherKeys;
-	ActiveConnectionWatchers.GetKeys(WatcherKeys);
+	StopDeviceNotifications();
 
-	for (const int32 ControllerId : WatcherKeys)
+	TArray<FInputDeviceId> DeviceIds;
+	LibraryInstances.GetKeys(DeviceIds);
+
+	for (const FInputDeviceId& DeviceId : DeviceIds)
 	{
-		RemoveLibraryInstance(ControllerId);
+		RemoveLibraryInstance(DeviceId.GetId());
 	}
+
+	ConnectionWatchdog.Reset();
 }
 
 ISonyGamepadInterface* FDeviceRegistry::GetLibraryInstance(const FInputDeviceId& DeviceId)
@@ -166,10 +228,14 @@ void FDeviceRegistry::RemoveLibraryInstance(int32 ControllerId)
 		return;
 	}
 
+	// Stop pinging before the library closes the handle the watchdog uses.
+	if (ConnectionWatchdog)
+	{
+		ConnectionWatchdog->RemoveDevice(ControllerId);
+	}
+
 	LibraryInstances[GamepadId]->ShutdownLibrary();
 	LibraryInstances.Remove(GamepadId);
-
-	const int32 NumRemoved = ActiveConnectionWatchers.Remove(ControllerId);
 }
 
 void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
@@ -245,20 +311,21 @@ void FDeviceRegistry::CreateLibraryInstance(FDeviceContext& Context)
 	}
 
 
-	if (ActiveConnectionWatchers.Contains(Context.UniqueInputDeviceId.GetId()))
+	if (!ConnectionWatchdog)
 	{
-		ActiveConnectionWatchers.Remove(Context.UniqueInputDeviceId.GetId());
+		ConnectionWatchdog = MakeUnique<FHIDWatchdogRunnable>([](int32)
+		{
+			bDevicesChangedPending.store(true, std::memory_order_release);
+		});
+		ConnectionWatchdog->StartThread();
 	}
 
-	auto WatcherRunnable = MakeUnique<FHIDPollingRunnable>(
-		MoveTemp(Context.Handle),
+	ConnectionWatchdog->AddDevice(
+		Context.UniqueInputDeviceId.GetId(),
+		FHIDDeviceInfo::GetTransport(Context),
+		Context.Handle,
 		std::chrono::milliseconds(150)
 	);
-	if (WatcherRunnable)
-	{
-		WatcherRunnable->StartThread();
-		ActiveConnectionWatchers.Add(Context.UniqueInputDeviceId.GetId(), MoveTemp(WatcherRunnable));
-	}
 }
 
 void FDeviceRegistry::RemoveAllLibraryInstance()
@@ -3,17 +3,26 @@
 // Planned Release Year: 2025
 
 #include "Core/DualSense/DualSenseLibrary.h"
-#include "Async/Async.h"
-#include "Async/TaskGraphInterfaces.h"
+#include "Core/MotionBatch.h"
 #include "Core/HIDDeviceInfo.h"
 #include "InputCoreTypes.h"
+#include "Core/GamepadButtons.h"
+#include "Core/PlayStationInputDecoder.h"
 #include "Helpers/ValidateHelpers.h"
 #include "Core/PlayStationOutputComposer.h"
+#include "Core/TriggerEffectCache.h"
 #include "Core/Structs/FOutputContext.h"
+#include "Misc/ScopeExit.h"
 
 bool UDualSenseLibrary::InitializeLibrary(const FDeviceContext& Context)
 {
 	HIDDeviceContexts = Context;
+	LatencyStats = MakeShared<FInputLatencyStats, ESPMode::ThreadSafe>();
+	Writer = MakeUnique<FHIDWriterRunnable>(HIDDeviceContexts, &FPlayStationOutputComposer::ComposeDualSense, LatencyStats);
+	Writer->StartThread();
+	DecodeReport = FPlayStationInputDecoder::GetDecoder(HIDDeviceContexts.DeviceType, HIDDeviceContexts.ConnectionType);
+	Reader = MakeUnique<FHIDReaderRunnable>(HIDDeviceContexts);
+	Reader->StartThread();
 	if (HIDDeviceContexts.ConnectionType == Bluetooth)
 	{
 		FOutputContext* EnableReport = &HIDDeviceContexts.Output; // Create a clean/empty report
@@ -27,17 +36,26 @@ bool UDualSenseLibrary::InitializeLibrary(const FDeviceContext& Context)
 		EnableReport->PlayerLed.Brightness = 0x00;
 
 		SendOut();
-		// Small delay here is sometimes needed, but often not.
-		FPlatformProcess::Sleep(0.01f);
 	}
 
+	// The writer may merge this state with the enable report above; its feature flags include
+	// the ones the enable report sets, so the controller is enabled either way.
 	StopAll();
 	return true;
 }
 
 void UDualSenseLibrary::ShutdownLibrary()
 {
-	ButtonStates.Reset();
+	ButtonMask = 0;
+	bHasInputState = false;
+	DecodedSequence = 0;
+	AnalogFilter.Reset();
+	if (Writer.IsValid() && Reader.IsValid() && Reader->IsDisconnected())
+	{
+		Writer->DiscardPending();
+	}
+	Reader.Reset();
+	FHIDWriterRunnable::Release(Writer);
 	FPlayStationOutputComposer::FreeContext(&HIDDeviceContexts);
 }
 
@@ -48,12 +66,17 @@ bool UDualSenseLibrary::IsConnected()
 
 void UDualSenseLibrary::SendOut()
 {
-	if (!HIDDeviceContexts.IsConnected)
+	if (!HIDDeviceContexts.IsConnected || !Writer.IsValid())
 	{
 		return;
 	}
 
-	FPlayStationOutputComposer::OutputDualSense(&HIDDeviceContexts);
+	SCOPE_CYCLE_COUNTER(STAT_DualSense_SendOut);
+	Writer->Submit(HIDDeviceContexts.Output);
+	if (FInputLatencyStats::IsEnabled() && LatencyStats.IsValid())
+	{
+		LatencyStats->OutputSubmits.fetch_add(1, std::memory_order_relaxed);
+	}
 }
 
 void UDualSenseLibrary::Settings(const FSettings<FFeatureReport>& Settings)
@@ -95,330 +118,241 @@ void UDualSenseLibrary::Settings(const FDualSenseFeatureReport& Settings)
 	SendOut();
 }
 
-void UDualSenseLibrary::CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-                                         const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-                                         const FName ButtonName, const bool IsButtonPressed)
+void UDualSenseLibrary::DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                        const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+                                        const uint32 Buttons)
 {
-	const bool PreviousState = ButtonStates.Contains(ButtonName) ? ButtonStates[ButtonName] : false;
-	if (IsButtonPressed && !PreviousState)
+	if (Buttons == ButtonMask)
 	{
-		InMessageHandler.Get().OnControllerButtonPressed(ButtonName, UserId, InputDeviceId, false);
+		return;
 	}
 
-	if (!IsButtonPressed && PreviousState)
+	SCOPE_CYCLE_COUNTER(STAT_DualSense_DispatchButtons);
+	const bool bMeasure = FInputLatencyStats::IsEnabled() && LatencyStats.IsValid();
+	const uint64 StartCycles = bMeasure ? FPlatformTime::Cycles64() : 0;
+
+	const int32 Events = FGamepadButtons::DispatchChanges(InMessageHandler.Get(), UserId, InputDeviceId, ButtonMask, Buttons);
+	ButtonMask = Buttons;
+
+	INC_DWORD_STAT_BY(STAT_DualSense_ButtonEvents, Events);
+	if (bMeasure)
 	{
-		InMessageHandler.Get().OnControllerButtonReleased(ButtonName, UserId, InputDeviceId, false);
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+		LatencyStats->ButtonEvents.fetch_add(Events, std::memory_order_relaxed);
+		if (DispatchReportCycles != 0)
+		{
+			LatencyStats->InputToEvent.RecordCycles(DispatchReportCycles, EndCycles);
+		}
+		LatencyStats->DispatchTime.RecordCycles(StartCycles, EndCycles);
 	}
-
-	ButtonStates.Add(ButtonName, IsButtonPressed);
 }
 
 void UDualSenseLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
                                     const FPlatformUserId UserId, const FInputDeviceId InputDeviceId)
 {
-	FDeviceContext* Context = &HIDDeviceContexts;
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NewContext = MoveTemp(Context)]()
-	{
-		FHIDDeviceInfo::Read(NewContext);
-	});
-
-	const size_t Padding = HIDDeviceContexts.ConnectionType == Bluetooth ? 2 : 1;
-	const unsigned char* HIDInput = &HIDDeviceContexts.Buffer[Padding];
-
-	const float LeftAnalogX = static_cast<char>(static_cast<short>(HIDInput[0x00] - 128));
-	const float LeftAnalogY = static_cast<char>(static_cast<short>(HIDInput[0x01] - 127) * -1);
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftAnalogX, UserId, InputDeviceId,
-	                                          LeftAnalogX / 128.0f);
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftAnalogY, UserId, InputDeviceId,
-	                                          LeftAnalogY / 128.0f);
-
-	const float RightAnalogX = static_cast<char>(static_cast<short>(HIDInput[0x02] - 128));
-	const float RightAnalogY = static_cast<char>(static_cast<short>(HIDInput[0x03] - 127) * -1);
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightAnalogX, UserId, InputDeviceId,
-	                                          RightAnalogX / 128.0f);
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightAnalogY, UserId, InputDeviceId,
-	                                          RightAnalogY / 128.0f);
-
-	const float TriggerL = HIDInput[0x04] / 256.0f;
-	const float TriggerR = HIDInput[0x05] / 256.0f;
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftTriggerAnalog, UserId, InputDeviceId, TriggerL);
-	InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightTriggerAnalog, UserId, InputDeviceId, TriggerR);
-
-	uint8_t ButtonsMask = HIDInput[0x07] & 0xF0;
-	const bool bCross = ButtonsMask & BTN_CROSS;
-	const bool bSquare = ButtonsMask & BTN_SQUARE;
-	const bool bCircle = ButtonsMask & BTN_CIRCLE;
-	const bool bTriangle = ButtonsMask & BTN_TRIANGLE;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonBottom, bCross);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonLeft, bSquare);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonRight, bCircle);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonTop, bTriangle);
-
-	switch (HIDInput[0x07] & 0x0F)
-	{
-	case 0x0:
-		ButtonsMask |= BTN_DPAD_UP;
-		break;
-	case 0x4:
-		ButtonsMask |= BTN_DPAD_DOWN;
-		break;
-	case 0x6:
-		ButtonsMask |= BTN_DPAD_LEFT;
-		break;
-	case 0x2:
-		ButtonsMask |= BTN_DPAD_RIGHT;
-		break;
-	case 0x5:
-		ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_DOWN;
-		break;
-	case 0x7:
-		ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_UP;
-		break;
-	case 0x1:
-		ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_UP;
-		break;
-	case 0x3:
-		ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_DOWN;
-		break;
-	default: ;
-	}
-	const bool bDPadLeft = ButtonsMask & BTN_DPAD_LEFT;
-	const bool bDPadDown = ButtonsMask & BTN_DPAD_DOWN;
-	const bool bDPadRight = ButtonsMask & BTN_DPAD_RIGHT;
-	const bool bDPadUp = ButtonsMask & BTN_DPAD_UP;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadUp, bDPadUp);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadDown, bDPadDown);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadLeft, bDPadLeft);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadRight, bDPadRight);
-
-	// Shoulders
-	const bool bLeftShoulder = HIDInput[0x08] & BTN_LEFT_SHOLDER;
-	const bool bRightShoulder = HIDInput[0x08] & BTN_RIGHT_SHOLDER;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftShoulder, bLeftShoulder);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightShoulder, bRightShoulder);
-
-	// Push Stick
-	const bool PushLeftStick = HIDInput[0x08] & BTN_LEFT_STICK;
-	const bool PushRightStick = HIDInput[0x08] & BTN_RIGHT_STICK;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushLeftStick"), PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushRightStick"), PushRightStick);
-
-	// mapped urenal native gamepad Push Stick
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftThumb, PushLeftStick);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightThumb, PushRightStick);
-
-	// Function & Special Actions
-	const bool Playstation = HIDInput[0x09] & BTN_PLAYSTATION_LOGO;
-	const bool TouchPad = HIDInput[0x09] & BTN_PAD_BUTTON;
-	const bool Mic = HIDInput[0x09] & BTN_MIC_BUTTON;
-	const bool bFn1 = HIDInput[0x09] & BTN_FN1;
-	const bool bFn2 = HIDInput[0x09] & BTN_FN2;
-	const bool bPaddleLeft = HIDInput[0x09] & BTN_PADDLE_LEFT;
-	const bool bPaddleRight = HIDInput[0x09] & BTN_PADDLE_RIGHT;
-
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Mic"), Mic);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_TouchButtom"), TouchPad);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Button"), Playstation);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_FunctionL"), bFn1);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_FunctionR"), bFn2);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PaddleL"), bPaddleLeft);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PaddleR"), bPaddleRight);
-
-	const bool Start = HIDInput[0x08] & BTN_START;
-	const bool Select = HIDInput[0x08] & BTN_SELECT;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Menu"), Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Share"), Select);
-
-	// mapped urenal native gamepad Start and Select
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialRight, Start);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialLeft, Select);
-
-
-	const bool bLeftTriggerThreshold = HIDInput[0x08] & BTN_LEFT_TRIGGER;
-	const bool bRightTriggerThreshold = HIDInput[0x08] & BTN_RIGHT_TRIGGER;
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftTriggerThreshold,
-	                 bLeftTriggerThreshold);
-	CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightTriggerThreshold,
-	                 bRightTriggerThreshold);
-	if (bEnableTouch)
-	{
-		FTouchPoint1 Touch;
-		const UINT32 Touchpad1Raw = *reinterpret_cast<const UINT32*>(&HIDInput[0x20]);
-		Touch.Y = (Touchpad1Raw & 0xFFF00000) >> 20;
-		Touch.X = (Touchpad1Raw & 0x000FFF00) >> 8;
-		Touch.Down = (Touchpad1Raw & (1 << 7)) == 0;
-		Touch.Id = (Touchpad1Raw & 127);
-
-		// // Evaluate touch state 2
-		FTouchPoint2 Touch2;
-		const UINT32 Touchpad2Raw = *reinterpret_cast<const UINT32*>(&HIDInput[0x20]);
-		Touch2.Y = (Touchpad2Raw & 0xFFF00000) >> 20;
-		Touch2.X = (Touchpad2Raw & 0x000FFF00) >> 8;
-		Touch2.Down = (Touchpad2Raw & (1 << 7)) == 0;
-		Touch2.Id = (Touchpad2Raw & 127);
-
-		if (Touch.Down) // pressed
+	SCOPE_CYCLE_COUNTER(STAT_DualSense_UpdateInput);
+	const bool bMeasure = FInputLatencyStats::IsEnabled() && LatencyStats.IsValid();
+	const uint64 UpdateStartCycles = bMeasure ? FPlatformTime::Cycles64() : 0;
+	ON_SCOPE_EXIT
+	{
+		if (bMeasure)
 		{
-			InMessageHandler->OnTouchStarted(
-				nullptr,
-				FVector2D(Touch.X, Touch.Y),
-				1.0f,
-				Touch.Id,
-				UserId,
-				InputDeviceId
-			);
+			LatencyStats->ParseTime.RecordCycles(UpdateStartCycles, FPlatformTime::Cycles64());
 		}
-		else
+	};
+
+	if (!Reader.IsValid())
+	{
+		return;
+	}
+
+	if (Reader->IsDisconnected() || (Writer.IsValid() && Writer->HasFailed()))
+	{
+		if (HIDDeviceContexts.IsConnected)
 		{
-			// OnTouchEnded
-			InMessageHandler->OnTouchEnded(
-				FVector2D(Touch.X, Touch.Y),
-				Touch.Id,
-				UserId,
-				InputDeviceId
-			);
+			// The handle stays open until the registry has removed it from the watchdog.
+			if (Writer.IsValid())
+			{
+				Writer->DiscardPending();
+			}
+			FHIDWriterRunnable::Release(Writer);
+			FHIDDeviceInfo::MarkDisconnected(&HIDDeviceContexts);
 		}
+		return;
+	}
 
-		if (Touch2.Down) // pressed
+	// Buttons are evaluated for every report in arrival order so short taps are never lost,
+	// while analog values only need the most recent snapshot.
+	FGamepadState& State = InputState;
+	FInputReport Pending;
+	while (Reader->Dequeue(Pending))
+	{
+		INC_DWORD_STAT(STAT_DualSense_ReportsConsumed);
+		if (bMeasure)
 		{
-			InMessageHandler->OnTouchStarted(
-				nullptr,
-				FVector2D(Touch2.X, Touch2.Y),
-				1.0f,
-				Touch2.Id,
-				UserId,
-				InputDeviceId
-			);
+			LatencyStats->ReadLatency.RecordCycles(Pending.HostCycles, FPlatformTime::Cycles64());
+			LatencyStats->ReportsConsumed.fetch_add(1, std::memory_order_relaxed);
 		}
-		else
+
+		// Reports already covered by a newer snapshot were applied in a previous update.
+		if (bDispatchToMessageHandler && Pending.Sequence > DecodedSequence)
 		{
-			// OnTouchEnded
-			InMessageHandler->OnTouchEnded(
-				FVector2D(Touch2.X, Touch2.Y),
-				Touch2.Id,
-				UserId,
-				InputDeviceId
-			);
+			DecodeReport(Pending.Data, State);
+			DecodedSequence = Pending.Sequence;
+			DispatchReportCycles = Pending.HostCycles;
+			DispatchButtons(InMessageHandler, UserId, InputDeviceId, State.Buttons);
+			if (bEnableTouchGestures)
+			{
+				TouchGestures.AddSample(State.Touch, FPlatformTime::ToSeconds64(Pending.HostCycles));
+			}
 		}
 	}
 
-	if (bEnableAccelerometerAndGyroscope)
+	// Also covers reports that were published while the channel was full.
+	const FInputReport& Latest = Reader->ReadLatest();
+	if (Latest.Sequence == 0)
 	{
-		FGyro Gyro;
-		Gyro.X = static_cast<int16_t>((HIDInput[16]) | (HIDInput[17] << 8));
-		Gyro.Y = static_cast<int16_t>((HIDInput[18]) | (HIDInput[19] << 8));
-		Gyro.Z = static_cast<int16_t>((HIDInput[20]) | (HIDInput[21] << 8));
-
-		FAccelerometer Acc;
-		Acc.X = static_cast<int16_t>((HIDInput[22]) | (HIDInput[23] << 8));
-		Acc.Y = static_cast<int16_t>((HIDInput[24]) | (HIDInput[25] << 8));
-		Acc.Z = static_cast<int16_t>((HIDInput[26]) | (HIDInput[27] << 8));
-
-		if (bIsCalibrating)
-		{
-			AccumulatedGyro.X += Gyro.X;
-			AccumulatedGyro.Y += Gyro.Y;
-			AccumulatedGyro.Z += Gyro.Z;
-
-			AccumulatedAccel.X += Acc.X;
-			AccumulatedAccel.Y += Acc.Y;
-			AccumulatedAccel.Z += Acc.Z;
-
-
-			Bounds.Gyro_X_Bounds.X = FMath::Min(Bounds.Gyro_X_Bounds.X, Gyro.X);
-			Bounds.Gyro_X_Bounds.Y = FMath::Max(Bounds.Gyro_X_Bounds.Y, Gyro.X);
-
-			Bounds.Gyro_Y_Bounds.X = FMath::Min(Bounds.Gyro_Y_Bounds.X, Gyro.Y);
-			Bounds.Gyro_Y_Bounds.Y = FMath::Max(Bounds.Gyro_Y_Bounds.Y, Gyro.Y);
+		return;
+	}
 
-			Bounds.Gyro_Z_Bounds.X = FMath::Min(Bounds.Gyro_Z_Bounds.X, Gyro.Z);
-			Bounds.Gyro_Z_Bounds.Y = FMath::Max(Bounds.Gyro_Z_Bounds.Y, Gyro.Z);
+	// The snapshot can trail the channel by the report being published as it was drained.
+	if (Latest.Sequence > DecodedSequence)
+	{
+		DecodeReport(Latest.Data, State);
+		DecodedSequence = Latest.Sequence;
+	}
+	MotionOrientation = Latest.Orientation;
+	MotionDelta = bHasInputState ? FMotionIntegral::Delta(ConsumedMotion, Latest.Motion) : FMotionDelta();
+	ConsumedMotion = Latest.Motion;
+	bHasInputState = true;
 
-			Bounds.Accel_X_Bounds.X = FMath::Min(Bounds.Accel_X_Bounds.X, Acc.X);
-			Bounds.Accel_X_Bounds.Y = FMath::Max(Bounds.Accel_X_Bounds.Y, Acc.X);
+	SetHasPhoneConnected(State.bHeadsetConnected);
+	SetLevelBattery(State.BatteryLevel * 10.0f, State.bFullyCharged, State.bCharging);
 
-			Bounds.Accel_Y_Bounds.X = FMath::Min(Bounds.Accel_Y_Bounds.X, Acc.Y);
-			Bounds.Accel_Y_Bounds.Y = FMath::Max(Bounds.Accel_Y_Bounds.Y, Acc.Y);
+	if (bDispatchToMessageHandler)
+	{
+		DispatchReportCycles = Latest.HostCycles;
+		DispatchButtons(InMessageHandler, UserId, InputDeviceId, State.Buttons);
 
-			Bounds.Accel_Z_Bounds.X = FMath::Min(Bounds.Accel_Z_Bounds.X, Acc.Z);
-			Bounds.Accel_Z_Bounds.Y = FMath::Max(Bounds.Accel_Z_Bounds.Y, Acc.Z);
+		AnalogFilter.Dispatch(InMessageHandler.Get(), UserId, InputDeviceId, State);
 
-			CalibrationSampleCount++;
+		if (bEnableTouchGestures)
+		{
+			// Skipped by the recognizer when it was the last report dequeued.
+			TouchGestures.AddSample(State.Touch, FPlatformTime::ToSeconds64(Latest.HostCycles));
+			TouchGestures.Dispatch(InMessageHandler.Get(), UserId, InputDeviceId);
 		}
+	}
 
-		if (bHasMotionSensorBaseline)
+	if (bEnableTouch && bDispatchToMessageHandler)
+	{
+		// Touches are indexed by finger slot: the tracking id of the controller grows with
+		// every contact, past the touch indices the engine knows about.
+		for (int32 Index = 0; Index < 2; ++Index)
 		{
-			Gyro.X -= GyroBaseline.X;
-			Gyro.Y -= GyroBaseline.Y;
-			Gyro.Z -= GyroBaseline.Z;
-			
-			float FinalGyroValueX = 0.0f;
-			if (FMath::Abs(Gyro.X) > (Bounds.Gyro_X_Bounds.Y - Bounds.Gyro_X_Bounds.X) * SensorsDeadZone)
+			const FGamepadTouchState& Touch = State.Touch[Index];
+			FGamepadTouchState& Previous = DispatchedTouch[Index];
+			if (Previous.bDown && (!Touch.bDown || Touch.Id != Previous.Id))
 			{
-				FinalGyroValueX = Gyro.X;
+				InMessageHandler->OnTouchEnded(FVector2D(Previous.X, Previous.Y), Index, UserId, InputDeviceId);
+				Previous.bDown = false;
 			}
 
-			float FinalGyroValueY = 0.0f;
-			if (FMath::Abs(Gyro.Y) > (Bounds.Gyro_Y_Bounds.Y - Bounds.Gyro_Y_Bounds.X) * SensorsDeadZone)
+			if (Touch.bDown && !Previous.bDown)
 			{
-				FinalGyroValueY = Gyro.Y;
+				InMessageHandler->OnTouchStarted(nullptr, FVector2D(Touch.X, Touch.Y), 1.0f, Index, UserId,
+				                                 InputDeviceId);
 			}
-
-			float FinalGyroValueZ = 0.0f;
-			if (FMath::Abs(Gyro.Z) > (Bounds.Gyro_Z_Bounds.Y - Bounds.Gyro_Z_Bounds.X) * SensorsDeadZone)
+			else if (Touch.bDown && (Touch.X != Previous.X || Touch.Y != Previous.Y))
 			{
-				FinalGyroValueZ = Gyro.Z;
+				InMessageHandler->OnTouchMoved(FVector2D(Touch.X, Touch.Y), 1.0f, Index, UserId, InputDeviceId);
 			}
+			Previous = Touch;
+		}
+	}
 
-			Acc.X -= AccelBaseline.X;
-			Acc.Y -= AccelBaseline.Y;
-			Acc.Z -= AccelBaseline.Z;
+	ApplyMotionCalibration();
+}
 
-			float FinalAccelValueX = 0.0f;
-			if (FMath::Abs(Acc.X) > (Bounds.Accel_X_Bounds.Y - Bounds.Accel_X_Bounds.X) * SensorsDeadZone)
-			{
-				FinalAccelValueX = Acc.X;
-			}
+int32 UDualSenseLibrary::AddMotionToBatch(FMotionBatch& Batch)
+{
+	if (!bEnableAccelerometerAndGyroscope || !bHasMotionSensorBaseline || !bDispatchToMessageHandler || !bHasInputState)
+	{
+		return INDEX_NONE;
+	}
 
-			float FinalAccelValueY = 0.0f;
-			if (FMath::Abs(Acc.Y) > (Bounds.Accel_Y_Bounds.Y - Bounds.Accel_Y_Bounds.X) * SensorsDeadZone)
-			{
-				FinalAccelValueY = Acc.Y;
-			}
+	// Averages over every sample read since the last tick, rather than the last one alone.
+	const FGamepadState& State = InputState;
+	const FVector Gyro = MotionDelta.Seconds > 0.0
+		                     ? MotionDelta.AverageGyro
+		                     : FVector(State.Gyro[0], State.Gyro[1], State.Gyro[2]);
+	const FVector Accel = MotionDelta.Samples > 0
+		                      ? MotionDelta.AverageAccel
+		                      : FVector(State.Accel[0], State.Accel[1], State.Accel[2]);
+	return Batch.Add(Gyro, Accel, GyroBaseline, AccelBaseline, GyroNoiseRange * SensorsDeadZone,
+	                 AccelNoiseRange * SensorsDeadZone);
+}
 
-			float FinalAccelValueZ = 0.0f;
-			if (FMath::Abs(Acc.Z) > (Bounds.Accel_Z_Bounds.Y - Bounds.Accel_Z_Bounds.X) *
-				SensorsDeadZone)
-			{
-				FinalAccelValueZ = Acc.Z;
-			}
+void UDualSenseLibrary::DispatchMotion(const FMotionBatch& Batch, const int32 Slot,
+                                       const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                       const FPlatformUserId UserId, const FInputDeviceId InputDeviceId)
+{
+	const FVector Gyroscope = Batch.GetGyro(Slot);
+	const FVector Accelerometer = Batch.GetAccel(Slot);
+
+	// Pitch, yaw and roll of the fused orientation, in degrees.
+	const FRotator Orientation = MotionOrientation.Rotator();
+	const FVector Tilts = FVector(Orientation.Pitch, Orientation.Yaw, Orientation.Roll);
+	// The accelerometer reaches here with its resting baseline removed, so gravity comes from
+	// the fused orientation instead: the world down axis seen from the controller.
+	const FVector Gravity = MotionOrientation.UnrotateVector(FVector(0.0, 0.0, -9.81));
+	InMessageHandler.Get().OnMotionDetected(Tilts, Gyroscope, Gravity, Accelerometer, UserId, InputDeviceId);
+}
 
-			Gyro.X = FinalGyroValueX;
-			Gyro.Y = FinalGyroValueY;
-			Gyro.Z = FinalGyroValueZ;
+bool UDualSenseLibrary::GetGamepadState(FGamepadState& OutState) const
+{
+	if (!bHasInputState)
+	{
+		return false;
+	}
 
-			Acc.X = FinalAccelValueX;
-			Acc.Y = FinalAccelValueY;
-			Acc.Z = FinalAccelValueZ;
+	OutState = InputState;
+	return true;
+}
 
-			const float GravityMagnitude = FMath::Sqrt(
-				FMath::Square(Acc.X + FMath::Square(Acc.Y)) + FMath::Square(static_cast<float>(Acc.Z))
-			);
+bool UDualSenseLibrary::GetMotionOrientation(FQuat& OutOrientation) const
+{
+	if (!bHasInputState)
+	{
+		return false;
+	}
 
-			const FVector Tilts = FVector(Acc.X + Gyro.X, Acc.Y + Gyro.Y, Acc.Z + Gyro.Z);
-			const FVector Gravity = (FVector(Acc.X, Acc.Y, Acc.Z) / GravityMagnitude) * 9.81f;
+	OutOrientation = MotionOrientation;
+	return true;
+}
 
-			const FVector Gyroscope = FVector(Gyro.X, Gyro.Y, Gyro.Z);
-			const FVector Accelerometer = FVector(Acc.X, Acc.Y, Acc.Z);
-			InMessageHandler.Get().OnMotionDetected(Tilts, Gyroscope, Gravity, Accelerometer, UserId, InputDeviceId);
-		}
+bool UDualSenseLibrary::GetMotionDelta(FMotionDelta& OutDelta) const
+{
+	if (!bHasInputState)
+	{
+		return false;
 	}
 
-	SetHasPhoneConnected(HIDInput[0x35] & 0x01);
-	SetLevelBattery(((HIDInput[0x34] & 0x0F) * 100) / 8, (HIDInput[0x35] & 0x00), (HIDInput[0x36] & 0x20));
+	OutDelta = MotionDelta;
+	return true;
+}
+
+void UDualSenseLibrary::ResetMotionOrientation()
+{
+	if (Reader.IsValid())
+	{
+		Reader->ResetOrientation();
+	}
+}
+
+void UDualSenseLibrary::EnableMessageHandlerDispatch(const bool bEnable)
+{
+	bDispatchToMessageHandler = bEnable;
 }
 
 void UDualSenseLibrary::SetVibration(const FForceFeedbackValues& Vibration)
@@ -474,11 +408,13 @@ void UDualSenseLibrary::SetHapticFeedback(int32 Hand, const FHapticFeedbackValue
 	if (Hand == static_cast<int32>(EControllerHand::Left) || Hand == static_cast<int32>(EControllerHand::AnyHand))
 	{
 		HidOutput->LeftTrigger.Frequency = FValidateHelpers::To255(Values->Frequency);
+		HidOutput->LeftTrigger.Encoded = FTriggerEffectBlob();
 	}
 
 	if (Hand == static_cast<int32>(EControllerHand::Right) || Hand == static_cast<int32>(EControllerHand::AnyHand))
 	{
 		HidOutput->RightTrigger.Frequency = FValidateHelpers::To255(Values->Frequency);
+		HidOutput->RightTrigger.Encoded = FTriggerEffectBlob();
 	}
 
 	SendOut();
@@ -529,6 +465,7 @@ void UDualSenseLibrary::SetTriggers(const FInputDeviceProperty* Values)
 			HidOutput->LeftTrigger.Mode = 0x02;
 			HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
 			HidOutput->LeftTrigger.Strengths.StrengthZones = StrengthZones;
+			HidOutput->LeftTrigger.Encoded = FTriggerEffectBlob();
 		}
 
 		if (
@@ -539,6 +476,7 @@ void UDualSenseLibrary::SetTriggers(const FInputDeviceProperty* Values)
 			HidOutput->RightTrigger.Mode = 0x02;
 			HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
 			HidOutput->RightTrigger.Strengths.StrengthZones = StrengthZones;
+			HidOutput->RightTrigger.Encoded = FTriggerEffectBlob();
 		}
 	}
 
@@ -548,239 +486,81 @@ void UDualSenseLibrary::SetTriggers(const FInputDeviceProperty* Values)
 void UDualSenseLibrary::SetAutomaticGun(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
                                         const EControllerHand& Hand, bool KeepEffect)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	unsigned char PositionalAmplitudes[10];
-	PositionalAmplitudes[0] = BeginStrength;
-	PositionalAmplitudes[1] = BeginStrength;
-	PositionalAmplitudes[2] = BeginStrength;
-	PositionalAmplitudes[3] = BeginStrength;
-	PositionalAmplitudes[4] = MiddleStrength;
-	PositionalAmplitudes[5] = MiddleStrength;
-	PositionalAmplitudes[6] = MiddleStrength;
-	PositionalAmplitudes[7] = MiddleStrength;
-	PositionalAmplitudes[8] = KeepEffect ? 8 : EndStrength;
-	PositionalAmplitudes[9] = KeepEffect ? 8 : EndStrength;
-
-	unsigned char Strengths[10];
-	for (int i = 0; i < 10; i++)
-	{
-		Strengths[i] = static_cast<uint64_t>(PositionalAmplitudes[i] * 8.0f);
-	}
-
-	int64 StrengthZones = 0;
-	int32 ActiveZones = 0;
-	for (int i = 0; i < 10; i++)
-	{
-		if (PositionalAmplitudes[i] > 0)
-		{
-			const uint64_t StrengthValue = static_cast<uint64_t>((Strengths[i] - 1) & 0x07);
-			StrengthZones |= static_cast<int64>(StrengthValue << (3 * i));
-			ActiveZones |= (1 << i);
-		}
-	}
-
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x26;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.StrengthZones = StrengthZones;
-		HidOutput->LeftTrigger.Frequency = FValidateHelpers::To255(0.05f);
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->RightTrigger.Mode = 0x26;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.StrengthZones = StrengthZones;
-		HidOutput->RightTrigger.Frequency = FValidateHelpers::To255(0.05f);
-	}
-
-	SendOut();
+	SetTriggerEffect(FTriggerEffectCache::AutomaticGun(BeginStrength, MiddleStrength, EndStrength, KeepEffect), Hand);
 }
 
 void UDualSenseLibrary::SetContinuousResistance(int32 StartPosition, int32 Strength, const EControllerHand& Hand)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x01;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = FValidateHelpers::To255(StartPosition, 8);
-		HidOutput->LeftTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength, 9);
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->RightTrigger.Mode = 0x01;
-		HidOutput->RightTrigger.Strengths.ActiveZones = FValidateHelpers::To255(StartPosition, 8);
-		HidOutput->RightTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength, 9);
-	}
-
-	SendOut();
+	SetTriggerEffect(FTriggerEffectCache::ContinuousResistance(StartPosition, Strength), Hand);
 }
 
 void UDualSenseLibrary::SetResistance(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
                                       const EControllerHand& Hand)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	unsigned char PositionalAmplitudes[10];
-	PositionalAmplitudes[0] = BeginStrength;
-	PositionalAmplitudes[1] = BeginStrength;
-	PositionalAmplitudes[2] = BeginStrength;
-	PositionalAmplitudes[3] = BeginStrength;
-	PositionalAmplitudes[4] = MiddleStrength;
-	PositionalAmplitudes[5] = MiddleStrength;
-	PositionalAmplitudes[6] = MiddleStrength;
-	PositionalAmplitudes[7] = MiddleStrength;
-	PositionalAmplitudes[8] = EndStrength;
-	PositionalAmplitudes[9] = EndStrength;
-
-	int32 ActiveZones = 0;
-	int16 StrengthValues = 0;
-	for (int i = 0; i < 3; i++)
-	{
-		if (PositionalAmplitudes[i] > 0)
-		{
-			const int8_t StrengthValue = static_cast<int8_t>((PositionalAmplitudes[i] - 1) & 0x07);
-			StrengthValues |= (StrengthValue << (3 * i));
-			ActiveZones |= static_cast<int16>(1 << i);
-		}
-	}
-
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x21;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.StrengthZones = StrengthValues;
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->RightTrigger.Mode = 0x21;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.StrengthZones = StrengthValues;
-	}
-
-	SendOut();
+	SetTriggerEffect(FTriggerEffectCache::Resistance(BeginStrength, MiddleStrength, EndStrength), Hand);
 }
 
 void UDualSenseLibrary::SetWeapon(int32 StartPosition, int32 EndPosition, int32 Strength,
                                   const EControllerHand& Hand)
 {
-	const uint32_t ActiveZones = (1 << StartPosition) | (1 << EndPosition);
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x25;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength);
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->RightTrigger.Mode = 0x25;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.StrengthZones = FValidateHelpers::To255(Strength);
-	}
-
-	SendOut();
+	SetTriggerEffect(FTriggerEffectCache::Weapon(StartPosition, EndPosition, Strength), Hand);
 }
 
 void UDualSenseLibrary::SetGalloping(int32 StartPosition, int32 EndPosition, int32 FirstFoot, int32 SecondFoot,
                                      float Frequency, const EControllerHand& Hand)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	const uint32_t ActiveZones = (1 << StartPosition) | (1 << EndPosition);
-	const uint32_t TimeAndRatio = (SecondFoot & 0x07) << (3 * 0) | (FirstFoot & 0x07);
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x23;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.TimeAndRatio = TimeAndRatio;
-		HidOutput->LeftTrigger.Frequency = FValidateHelpers::To255(Frequency);
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->RightTrigger.Mode = 0x23;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.TimeAndRatio = TimeAndRatio;
-		HidOutput->RightTrigger.Frequency = FValidateHelpers::To255(Frequency);
-	}
-
-	SendOut();
+	SetTriggerEffect(FTriggerEffectCache::Galloping(StartPosition, EndPosition, FirstFoot, SecondFoot, Frequency), Hand);
 }
 
 void UDualSenseLibrary::SetMachine(int32 StartPosition, int32 EndPosition, int32 AmplitudeBegin,
                                    int32 AmplitudeEnd, float Frequency, float Period,
                                    const EControllerHand& Hand)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	const uint32_t ActiveZones = ((1 << StartPosition) | (1 << EndPosition));
-	const uint32_t Strengths = (((AmplitudeBegin & 0x07) << (3 * 0)) | ((AmplitudeEnd & 0x07) << (3 * 1)));
+	SetTriggerEffect(
+		FTriggerEffectCache::Machine(StartPosition, EndPosition, AmplitudeBegin, AmplitudeEnd, Frequency, Period), Hand);
+}
 
-	if (Period < 0.0f || Period > 3.f)
-	{
-		Period = 3.f;
-	}
+void UDualSenseLibrary::SetBow(int32 StartPosition, int32 EndPosition, int32 BegingStrength, int32 EndStrength,
+                               const EControllerHand& Hand)
+{
+	SetTriggerEffect(FTriggerEffectCache::Bow(StartPosition, EndPosition, BegingStrength, EndStrength), Hand);
+}
 
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x27;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.StrengthZones = Strengths;
-		HidOutput->LeftTrigger.Strengths.Period = FValidateHelpers::To255(Period);
-		HidOutput->LeftTrigger.Frequency = FValidateHelpers::To255(Frequency);
-	}
+void UDualSenseLibrary::StopTrigger(const EControllerHand& Hand)
+{
+	SetTriggerEffect(FTriggerEffectCache::Off(), Hand);
+}
 
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
+void UDualSenseLibrary::SetTriggerEffect(const FTriggerEffectBlob& Effect, const EControllerHand& Hand)
+{
+	if (!Effect.IsValid())
 	{
-		HidOutput->RightTrigger.Mode = 0x27;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.StrengthZones = Strengths;
-		HidOutput->RightTrigger.Strengths.Period = FValidateHelpers::To255(Period);
-		HidOutput->RightTrigger.Frequency = FValidateHelpers::To255(Frequency);
+		return;
 	}
 
-	SendOut();
-}
-
-void UDualSenseLibrary::SetBow(int32 StartPosition, int32 EndPosition, int32 BegingStrength, int32 EndStrength,
-                               const EControllerHand& Hand)
-{
 	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	const uint32_t ActiveZones = ((1 << StartPosition) | (1 << EndPosition));
-	const uint32_t Strengths = ((((BegingStrength - 1) & 0x07) << (3 * 0)) | (((EndStrength - 1) & 0x07) << (3 * 1)));
 	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
 	{
-		HidOutput->LeftTrigger.Mode = 0x22;
-		HidOutput->LeftTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->LeftTrigger.Strengths.StrengthZones = Strengths;
+		FTriggerEffectCache::Apply(Effect, HidOutput->LeftTrigger);
 	}
 
 	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
 	{
-		HidOutput->RightTrigger.Mode = 0x22;
-		HidOutput->RightTrigger.Strengths.ActiveZones = ActiveZones;
-		HidOutput->RightTrigger.Strengths.StrengthZones = Strengths;
+		FTriggerEffectCache::Apply(Effect, HidOutput->RightTrigger);
 	}
 
 	SendOut();
 }
 
-void UDualSenseLibrary::StopTrigger(const EControllerHand& Hand)
+void UDualSenseLibrary::PlayTriggerSequence(const TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe>& Sequence,
+                                            const EControllerHand& Hand)
 {
-	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
-	if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
-	{
-		HidOutput->LeftTrigger.Mode = 0x0;
-	}
-
-	if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
+	if (!HIDDeviceContexts.IsConnected || !Writer.IsValid())
 	{
-		HidOutput->RightTrigger.Mode = 0x0;
+		return;
 	}
 
-	SendOut();
+	Writer->PlayTriggerSequence(Sequence, Hand);
 }
 
 void UDualSenseLibrary::StopAll()
@@ -865,48 +645,72 @@ void UDualSenseLibrary::EnableMotionSensor(bool bIsMotionSensor)
 
 bool UDualSenseLibrary::GetMotionSensorCalibrationStatus(float& OutProgress)
 {
+	ApplyMotionCalibration();
 	if (!bIsCalibrating)
 	{
 		OutProgress = 1.0f;
 		return false;
 	}
 
-	const double ElapsedTime = FPlatformTime::Seconds() - CalibrationStartTime;
-	OutProgress = FMath::Clamp(ElapsedTime / CalibrationDuration, 0.0, 1.0);
+	OutProgress = Reader.IsValid() ? FMath::Clamp(Reader->GetCalibrationProgress(), 0.0f, 1.0f) : 0.0f;
+	return true;
+}
 
-	if (ElapsedTime >= CalibrationDuration)
+void UDualSenseLibrary::StartMotionSensorCalibration(float Duration, float DeadZone)
+{
+	if (!Reader.IsValid())
 	{
-		if (CalibrationSampleCount > 0)
-		{
-			GyroBaseline.X = AccumulatedGyro.X / CalibrationSampleCount;
-			GyroBaseline.Y = AccumulatedGyro.Y / CalibrationSampleCount;
-			GyroBaseline.Z = AccumulatedGyro.Z / CalibrationSampleCount;
-
-			AccelBaseline.X = AccumulatedAccel.X / CalibrationSampleCount;
-			AccelBaseline.Y = AccumulatedAccel.Y / CalibrationSampleCount;
-			AccelBaseline.Z = AccumulatedAccel.Z / CalibrationSampleCount;
-		}
-		bIsCalibrating = false;
-		bHasMotionSensorBaseline = true;
-		return false;
+		return;
 	}
 
-	return true;
+	SensorsDeadZone = FMath::Clamp(DeadZone, 0.0f, 1.f);
+	CalibrationsAtStart = Reader->GetCompletedCalibrations();
+	bIsCalibrating = true;
+	Reader->StartCalibration(FMath::Clamp(Duration, 1.0f, 10.0f));
 }
 
-void UDualSenseLibrary::StartMotionSensorCalibration(float Duration, float DeadZone)
+void UDualSenseLibrary::EnableTouchGestures(const bool bEnable)
 {
-	bIsCalibrating = true;
-	CalibrationSampleCount = 0;
+	bEnableTouchGestures = bEnable;
+	TouchGestures.Reset();
+}
 
-	GyroBaseline = FVector::ZeroVector;
-	AccelBaseline = FVector::ZeroVector;
-	AccumulatedGyro = FVector::ZeroVector;
-	AccumulatedAccel = FVector::ZeroVector;
+void UDualSenseLibrary::EnableMotionAutoCalibration(const bool bEnable)
+{
+	if (Reader.IsValid())
+	{
+		Reader->SetAutoCalibration(bEnable);
+	}
+}
 
-	SensorsDeadZone = FMath::Clamp(DeadZone, 0.0f, 1.f);
-	CalibrationDuration = FMath::Clamp(Duration, 1.0f, 10.0f);
-	CalibrationStartTime = FPlatformTime::Seconds();
+void UDualSenseLibrary::ApplyMotionCalibration()
+{
+	if (!Reader.IsValid())
+	{
+		return;
+	}
+
+	FMotionCalibration Calibration;
+	if (Reader->GetCalibration(Calibration, AppliedCalibrationVersion))
+	{
+		GyroBaseline = Calibration.GyroMean;
+		GyroNoiseRange = Calibration.GyroStdDev * 6.0;
+
+		// Resting only measures the gyroscope. The accelerometer baseline, and with it motion
+		// events, only come from a requested calibration, so the accelerometer always reaches
+		// OnMotionDetected with gravity removed and the dead zone applied.
+		if (Calibration.bExplicit)
+		{
+			AccelBaseline = Calibration.AccelMean;
+			AccelNoiseRange = Calibration.AccelStdDev * 6.0;
+			bHasMotionSensorBaseline = true;
+		}
+	}
+
+	if (bIsCalibrating && Reader->GetCompletedCalibrations() != CalibrationsAtStart)
+	{
+		bIsCalibrating = false;
+	}
 }
 
 void UDualSenseLibrary::SetHasPhoneConnected(const bool HasConnected)
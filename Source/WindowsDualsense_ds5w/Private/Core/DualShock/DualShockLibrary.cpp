@@ -4,13 +4,14 @@
 
 
 #include "Core/DualShock/DualShockLibrary.h"
-#include "Async/Async.h"
-#include "Async/TaskGraphInterfaces.h"
 #include "Core/HIDDeviceInfo.h"
 #include "InputCoreTypes.h"
+#include "Core/GamepadButtons.h"
+#include "Core/PlayStationInputDecoder.h"
 #include "Helpers/ValidateHelpers.h"
 #include "Core/PlayStationOutputComposer.h"
 #include "Core/Structs/FOutputContext.h"
+#include "Misc/ScopeExit.h"
 
 void UDualShockLibrary::Settings(const FSettings<FFeatureReport>& Settings)
 {
@@ -23,13 +24,28 @@ void UDualShockLibrary::Settings(const FDualShockFeatureReport& Settings)
 bool UDualShockLibrary::InitializeLibrary(const FDeviceContext& Context)
 {
 	HIDDeviceContexts = Context;
+	LatencyStats = MakeShared<FInputLatencyStats, ESPMode::ThreadSafe>();
+	Writer = MakeUnique<FHIDWriterRunnable>(HIDDeviceContexts, &FPlayStationOutputComposer::ComposeDualShock, LatencyStats);
+	Writer->StartThread();
+	DecodeReport = FPlayStationInputDecoder::GetDecoder(HIDDeviceContexts.DeviceType, HIDDeviceContexts.ConnectionType);
+	Reader = MakeUnique<FHIDReaderRunnable>(HIDDeviceContexts);
+	Reader->StartThread();
 	SetLightbar(FColor::Blue, 0.0f, 0.0f);
 	return true;
 }
 
 void UDualShockLibrary::ShutdownLibrary()
 {
-	ButtonStates.Reset();
+	ButtonMask = 0;
+	bHasInputState = false;
+	DecodedSequence = 0;
+	AnalogFilter.Reset();
+	if (Writer.IsValid() && Reader.IsValid() && Reader->IsDisconnected())
+	{
+		Writer->DiscardPending();
+	}
+	Reader.Reset();
+	FHIDWriterRunnable::Release(Writer);
 	FPlayStationOutputComposer::FreeContext(&HIDDeviceContexts);
 }
 
@@ -40,146 +56,190 @@ bool UDualShockLibrary::IsConnected()
 
 void UDualShockLibrary::SendOut()
 {
-	if (!HIDDeviceContexts.IsConnected)
+	if (!HIDDeviceContexts.IsConnected || !Writer.IsValid())
 	{
 		return;
 	}
-	
-	FPlayStationOutputComposer::OutputDualShock(&HIDDeviceContexts);
+
+	SCOPE_CYCLE_COUNTER(STAT_DualSense_SendOut);
+	Writer->Submit(HIDDeviceContexts.Output);
+	if (FInputLatencyStats::IsEnabled() && LatencyStats.IsValid())
+	{
+		LatencyStats->OutputSubmits.fetch_add(1, std::memory_order_relaxed);
+	}
 }
 
-void UDualShockLibrary::CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-	const FPlatformUserId UserId, const FInputDeviceId InputDeviceId, const FName ButtonName,
-	const bool IsButtonPressed)
+void UDualShockLibrary::DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+                                        const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+                                        const uint32 Buttons)
 {
-	const bool PreviousState = ButtonStates.Contains(ButtonName) ? ButtonStates[ButtonName] : false;
-	if (IsButtonPressed && !PreviousState)
+	if (Buttons == ButtonMask)
 	{
-		InMessageHandler.Get().OnControllerButtonPressed(ButtonName, UserId, InputDeviceId, false);
+		return;
 	}
 
-	if (!IsButtonPressed && PreviousState)
+	SCOPE_CYCLE_COUNTER(STAT_DualSense_DispatchButtons);
+	const bool bMeasure = FInputLatencyStats::IsEnabled() && LatencyStats.IsValid();
+	const uint64 StartCycles = bMeasure ? FPlatformTime::Cycles64() : 0;
+
+	const int32 Events = FGamepadButtons::DispatchChanges(InMessageHandler.Get(), UserId, InputDeviceId, ButtonMask, Buttons);
+	ButtonMask = Buttons;
+
+	INC_DWORD_STAT_BY(STAT_DualSense_ButtonEvents, Events);
+	if (bMeasure)
 	{
-		InMessageHandler.Get().OnControllerButtonReleased(ButtonName, UserId, InputDeviceId, false);
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+		LatencyStats->ButtonEvents.fetch_add(Events, std::memory_order_relaxed);
+		if (DispatchReportCycles != 0)
+		{
+			LatencyStats->InputToEvent.RecordCycles(DispatchReportCycles, EndCycles);
+		}
+		LatencyStats->DispatchTime.RecordCycles(StartCycles, EndCycles);
 	}
-
-	ButtonStates.Add(ButtonName, IsButtonPressed);
 }
 
 void UDualShockLibrary::UpdateInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
 	const FPlatformUserId UserId, const FInputDeviceId InputDeviceId)
 {
-		FDeviceContext* Context = &HIDDeviceContexts;
-		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [NewContext = MoveTemp(Context)]()
+		SCOPE_CYCLE_COUNTER(STAT_DualSense_UpdateInput);
+		const bool bMeasure = FInputLatencyStats::IsEnabled() && LatencyStats.IsValid();
+		const uint64 UpdateStartCycles = bMeasure ? FPlatformTime::Cycles64() : 0;
+		ON_SCOPE_EXIT
+		{
+			if (bMeasure)
+			{
+				LatencyStats->ParseTime.RecordCycles(UpdateStartCycles, FPlatformTime::Cycles64());
+			}
+		};
+
+		if (!Reader.IsValid())
+		{
+			return;
+		}
+
+		if (Reader->IsDisconnected() || (Writer.IsValid() && Writer->HasFailed()))
+		{
+			if (HIDDeviceContexts.IsConnected)
+			{
+				// The handle stays open until the registry has removed it from the watchdog.
+				if (Writer.IsValid())
+				{
+					Writer->DiscardPending();
+				}
+				FHIDWriterRunnable::Release(Writer);
+				FHIDDeviceInfo::MarkDisconnected(&HIDDeviceContexts);
+			}
+			return;
+		}
+
+		// Buttons are evaluated for every report in arrival order so short taps are never lost,
+		// while analog values only need the most recent snapshot.
+		FGamepadState& State = InputState;
+		FInputReport Pending;
+		while (Reader->Dequeue(Pending))
+		{
+			INC_DWORD_STAT(STAT_DualSense_ReportsConsumed);
+			if (bMeasure)
+			{
+				LatencyStats->ReadLatency.RecordCycles(Pending.HostCycles, FPlatformTime::Cycles64());
+				LatencyStats->ReportsConsumed.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// Reports already covered by a newer snapshot were applied in a previous update.
+			if (bDispatchToMessageHandler && Pending.Sequence > DecodedSequence)
+			{
+				DecodeReport(Pending.Data, State);
+				DecodedSequence = Pending.Sequence;
+				DispatchReportCycles = Pending.HostCycles;
+				DispatchButtons(InMessageHandler, UserId, InputDeviceId, State.Buttons);
+				if (bEnableTouchGestures)
+				{
+					TouchGestures.AddSample(State.Touch, FPlatformTime::ToSeconds64(Pending.HostCycles));
+				}
+			}
+		}
+
+		// Also covers reports that were published while the channel was full.
+		const FInputReport& Latest = Reader->ReadLatest();
+		if (Latest.Sequence == 0)
 		{
-				FHIDDeviceInfo::Read(NewContext);
-		});
-		
-		const unsigned char* HIDInput;
-		if (HIDDeviceContexts.ConnectionType == Bluetooth)
+			return;
+		}
+
+		// The snapshot can trail the channel by the report being published as it was drained.
+		if (Latest.Sequence > DecodedSequence)
 		{
-			HIDInput = &HIDDeviceContexts.BufferDS4[3];
+			DecodeReport(Latest.Data, State);
+			DecodedSequence = Latest.Sequence;
 		}
-		else
+		MotionOrientation = Latest.Orientation;
+		MotionDelta = bHasInputState ? FMotionIntegral::Delta(ConsumedMotion, Latest.Motion) : FMotionDelta();
+		ConsumedMotion = Latest.Motion;
+		bHasInputState = true;
+		if (!bDispatchToMessageHandler)
 		{
-			HIDInput = &HIDDeviceContexts.Buffer[1];
+			return;
 		}
-	
-		// Triggers
-		const bool bLeftTriggerThreshold = HIDInput[0x05] & BTN_LEFT_TRIGGER;
-		const bool bRightTriggerThreshold = HIDInput[0x05] & BTN_RIGHT_TRIGGER;
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftTriggerThreshold, bLeftTriggerThreshold);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightTriggerThreshold, bRightTriggerThreshold);
-
-		// Triggers Analog 1D
-		const float TriggerL = HIDInput[0x07] / 256.0f;
-		const float TriggerR = HIDInput[0x08] / 256.0f;
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftTriggerAnalog, UserId, InputDeviceId, TriggerL);
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightTriggerAnalog, UserId, InputDeviceId, TriggerR);
-
-		// Analogs
-		const float LeftAnalogX = static_cast<char>(static_cast<short>(HIDInput[0x00] - 128));
-		const float LeftAnalogY = static_cast<char>(static_cast<short>(HIDInput[0x01] - 127) * -1);
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftAnalogX, UserId, InputDeviceId, LeftAnalogX / 128.0f);
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::LeftAnalogY, UserId, InputDeviceId, LeftAnalogY / 128.0f);
-
-		const float RightAnalogX = static_cast<char>(static_cast<short>(HIDInput[0x02] - 128));
-		const float RightAnalogY = static_cast<char>(static_cast<short>(HIDInput[0x03] - 127) * -1);
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightAnalogX, UserId, InputDeviceId, RightAnalogX / 128.0f);
-		InMessageHandler.Get().OnControllerAnalog(FGamepadKeyNames::RightAnalogY, UserId, InputDeviceId, RightAnalogY / 128.0f);
-
-		uint8_t ButtonsMask = HIDInput[0x04] & 0xF0;
-		const bool bCross = ButtonsMask & BTN_CROSS;
-		const bool bSquare = ButtonsMask & BTN_SQUARE;
-		const bool bCircle = ButtonsMask & BTN_CIRCLE;
-		const bool bTriangle = ButtonsMask & BTN_TRIANGLE;
-
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonBottom, bCross);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonLeft, bSquare);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonRight, bCircle);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::FaceButtonTop, bTriangle);
-
-		switch (HIDInput[0x04] & 0x0F)
+
+		DispatchReportCycles = Latest.HostCycles;
+		DispatchButtons(InMessageHandler, UserId, InputDeviceId, State.Buttons);
+		AnalogFilter.Dispatch(InMessageHandler.Get(), UserId, InputDeviceId, State);
+
+		if (bEnableTouchGestures)
 		{
-			case 0x0:
-				ButtonsMask |= BTN_DPAD_UP;
-				break;
-			case 0x4:
-				ButtonsMask |= BTN_DPAD_DOWN;
-				break;
-			case 0x6:
-				ButtonsMask |= BTN_DPAD_LEFT;
-				break;
-			case 0x2:
-				ButtonsMask |= BTN_DPAD_RIGHT;
-				break;
-			case 0x5:
-				ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_DOWN;
-				break;
-			case 0x7:
-				ButtonsMask |= BTN_DPAD_LEFT | BTN_DPAD_UP;
-				break;
-			case 0x1:
-				ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_UP;
-				break;
-			case 0x3:
-				ButtonsMask |= BTN_DPAD_RIGHT | BTN_DPAD_DOWN;
-				break;
-			default: ;
+			// Skipped by the recognizer when it was the last report dequeued.
+			TouchGestures.AddSample(State.Touch, FPlatformTime::ToSeconds64(Latest.HostCycles));
+			TouchGestures.Dispatch(InMessageHandler.Get(), UserId, InputDeviceId);
 		}
-		const bool bDPadLeft = ButtonsMask & BTN_DPAD_LEFT;
-		const bool bDPadDown = ButtonsMask & BTN_DPAD_DOWN;
-		const bool bDPadRight = ButtonsMask & BTN_DPAD_RIGHT;
-		const bool bDPadUp = ButtonsMask & BTN_DPAD_UP;
-		
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadUp, bDPadUp);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadDown, bDPadDown);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadLeft, bDPadLeft);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::DPadRight, bDPadRight);
-
-		// Shoulders
-		const bool bLeftShoulder = HIDInput[0x05] & BTN_LEFT_SHOLDER;
-		const bool bRightShoulder = HIDInput[0x05] & BTN_RIGHT_SHOLDER;
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftShoulder, bLeftShoulder);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightShoulder, bRightShoulder);
-		
-		// Push Stick
-		const bool PushLeftStick = HIDInput[0x05] & BTN_LEFT_STICK;
-		const bool PushRightStick = HIDInput[0x05] & BTN_RIGHT_STICK;
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushLeftStick"), PushLeftStick);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_PushRightStick"), PushRightStick);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::LeftThumb, PushLeftStick);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::RightThumb, PushRightStick);
-
-		const bool Start = HIDInput[0x05] & BTN_START;
-		const bool Select = HIDInput[0x05] & BTN_SELECT;
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Menu"), Start);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FName("PS_Share"), Select);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialRight, Start);
-		CheckButtonInput(InMessageHandler, UserId, InputDeviceId, FGamepadKeyNames::SpecialLeft, Select);
 }
 
 
+bool UDualShockLibrary::GetGamepadState(FGamepadState& OutState) const
+{
+	if (!bHasInputState)
+	{
+		return false;
+	}
+
+	OutState = InputState;
+	return true;
+}
+
+bool UDualShockLibrary::GetMotionOrientation(FQuat& OutOrientation) const
+{
+	if (!bHasInputState)
+	{
+		return false;
+	}
+
+	OutOrientation = MotionOrientation;
+	return true;
+}
+
+bool UDualShockLibrary::GetMotionDelta(FMotionDelta& OutDelta) const
+{
+	if (!bHasInputState)
+	{
+		return false;
+	}
+
+	OutDelta = MotionDelta;
+	return true;
+}
+
+void UDualShockLibrary::ResetMotionOrientation()
+{
+	if (Reader.IsValid())
+	{
+		Reader->ResetOrientation();
+	}
+}
+
+void UDualShockLibrary::EnableMessageHandlerDispatch(const bool bEnable)
+{
+	bDispatchToMessageHandler = bEnable;
+}
+
 void UDualShockLibrary::SetVibration(const FForceFeedbackValues& Values)
 {
 	FOutputContext* HidOutput = &HIDDeviceContexts.Output;
@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/GamepadButtons.h"
+#include "InputCoreTypes.h"
+
+namespace
+{
+	/**
+	 * Key names a single mask bit is reported as. Some buttons are mirrored on the native
+	 * gamepad keys as well as on the plugin's own keys.
+	 */
+	struct FButtonKeyNames
+	{
+		FName Primary;
+		FName Alias;
+	};
+
+	/**
+	 * Key names indexed by bit. Built on first use, once the name table is available.
+	 */
+	const FButtonKeyNames* GetButtonKeyNames()
+	{
+		static const FButtonKeyNames Names[FGamepadButtons::Count] = {
+			{FGamepadKeyNames::FaceButtonLeft, NAME_None},
+			{FGamepadKeyNames::FaceButtonBottom, NAME_None},
+			{FGamepadKeyNames::FaceButtonRight, NAME_None},
+			{FGamepadKeyNames::FaceButtonTop, NAME_None},
+			{FGamepadKeyNames::DPadUp, NAME_None},
+			{FGamepadKeyNames::DPadDown, NAME_None},
+			{FGamepadKeyNames::DPadLeft, NAME_None},
+			{FGamepadKeyNames::DPadRight, NAME_None},
+			{FGamepadKeyNames::LeftShoulder, NAME_None},
+			{FGamepadKeyNames::RightShoulder, NAME_None},
+			{FGamepadKeyNames::LeftTriggerThreshold, NAME_None},
+			{FGamepadKeyNames::RightTriggerThreshold, NAME_None},
+			{FName("PS_Share"), FGamepadKeyNames::SpecialLeft},
+			{FName("PS_Menu"), FGamepadKeyNames::SpecialRight},
+			{FName("PS_PushLeftStick"), FGamepadKeyNames::LeftThumb},
+			{FName("PS_PushRightStick"), FGamepadKeyNames::RightThumb},
+			{FName("PS_Button"), NAME_None},
+			{FName("PS_TouchButtom"), NAME_None},
+			{FName("PS_Mic"), NAME_None},
+			{NAME_None, NAME_None},
+			{FName("PS_FunctionL"), NAME_None},
+			{FName("PS_FunctionR"), NAME_None},
+			{FName("PS_PaddleL"), NAME_None},
+			{FName("PS_PaddleR"), NAME_None},
+		};
+		return Names;
+	}
+}
+
+int32 FGamepadButtons::DispatchChanges(FGenericApplicationMessageHandler& MessageHandler, const FPlatformUserId UserId,
+                                       const FInputDeviceId InputDeviceId, const uint32 Previous, const uint32 Current)
+{
+	uint32 Changed = (Previous ^ Current) & ((1u << Count) - 1u);
+	if (Changed == 0)
+	{
+		return 0;
+	}
+
+	const FButtonKeyNames* Names = GetButtonKeyNames();
+	int32 Events = 0;
+	while (Changed != 0)
+	{
+		const uint32 Bit = FMath::CountTrailingZeros(Changed);
+		Changed &= Changed - 1;
+
+		const bool bPressed = (Current >> Bit) & 1u;
+		for (const FName& Name : {Names[Bit].Primary, Names[Bit].Alias})
+		{
+			if (Name.IsNone())
+			{
+				continue;
+			}
+
+			if (bPressed)
+			{
+				MessageHandler.OnControllerButtonPressed(Name, UserId, InputDeviceId, false);
+			}
+			else
+			{
+				MessageHandler.OnControllerButtonReleased(Name, UserId, InputDeviceId, false);
+			}
+			++Events;
+		}
+	}
+	return Events;
+}
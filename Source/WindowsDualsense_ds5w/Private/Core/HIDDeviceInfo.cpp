@@ -3,309 +3,141 @@
 // Planned Release Year: 2025
 
 #include "Core/HIDDeviceInfo.h"
-#include <hidsdi.h>
-#include <setupapi.h>
+#include "Misc/ScopeLock.h"
+#include "Core/Transport/LinuxHidrawTransport.h"
+#include "Core/Transport/LoopbackHidTransport.h"
+#include "Core/Transport/WindowsHidTransport.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/IInputInterface.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
 
-void FHIDDeviceInfo::Detect(TArray<FDeviceContext>& Devices)
+namespace
 {
-	GUID HidGuid;
-	HidD_GetHidGuid(&HidGuid);
-
-	const HDEVINFO DeviceInfoSet = SetupDiGetClassDevs(&HidGuid, nullptr, nullptr,
-	                                                   DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
-	if (DeviceInfoSet == INVALID_HANDLE_VALUE)
+	FCriticalSection& GetTransportLock()
 	{
-		UE_LOG(LogTemp, Error, TEXT("HIDManager: Falha ao obter informações dos dispositivos HID."));
-		return;
+		static FCriticalSection TransportLock;
+		return TransportLock;
 	}
 
-	SP_DEVICE_INTERFACE_DATA DeviceInterfaceData = {};
-	DeviceInterfaceData.cbSize = sizeof(SP_DEVICE_INTERFACE_DATA);
-
-	TMap<int32, WCHAR> DevicePaths;
-	DevicePaths.Empty();
-	for (DWORD DeviceIndex = 0; SetupDiEnumDeviceInterfaces(DeviceInfoSet, nullptr, &HidGuid, DeviceIndex,
-	                                                        &DeviceInterfaceData); DeviceIndex++)
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& GetTransportSlot()
 	{
-		DWORD RequiredSize = 0;
-
-		SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, nullptr, 0, &RequiredSize, nullptr);
-
-		const auto DetailDataBuffer = static_cast<PSP_DEVICE_INTERFACE_DETAIL_DATA>(malloc(RequiredSize));
-		if (!DetailDataBuffer)
-		{
-			UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to allocate memory for device details."));
-			continue;
-		}
-
-		DetailDataBuffer->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA);
-		if (SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, DetailDataBuffer, RequiredSize,
-		                                    nullptr, nullptr))
-		{
-			const HANDLE TempDeviceHandle = CreateFileW(
-				DetailDataBuffer->DevicePath,
-				GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr
-			);
-			
-			if (
-				TempDeviceHandle != INVALID_HANDLE_VALUE
-			)
-			{
-				HIDD_ATTRIBUTES Attributes = {};
-				Attributes.Size = sizeof(HIDD_ATTRIBUTES);
-
-				if (HidD_GetAttributes(TempDeviceHandle, &Attributes))
-				{
-					if (
-						Attributes.VendorID == 0x054C &&
-						(
-							Attributes.ProductID == 0x0CE6 ||
-							Attributes.ProductID == 0x0DF2 ||
-							Attributes.ProductID == 0x05C4 ||
-							Attributes.ProductID == 0x09CC
-						)
-					)
-					{
-						FDeviceContext Context = {};
-						WCHAR DeviceProductString[260];
-						if (!HidD_GetProductString(TempDeviceHandle, DeviceProductString, 260))
-						{
-							UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to obtain device path for the DualSense."));
-							continue;
-						}
-
-						if (DevicePaths.Contains(DeviceIndex))
-						{
-							continue;
-						}
-						
-						memcpy_s(Context.Path, 260, DetailDataBuffer->DevicePath, 260);
-						DevicePaths.Add(DeviceIndex, *Context.Path);
-						switch (Attributes.ProductID)
-						{
-							case 0x05C4:
-							case 0x09CC:
-								Context.DeviceType = DualShock4;
-								break;
-							case 0x0DF2:
-								Context.DeviceType = DualSenseEdge;
-								break;
-							default: Context.DeviceType = DualSense;
-						}
-						
-						Context.IsConnected = true;
-						Context.ConnectionType = Usb;
-						Context.Handle = TempDeviceHandle;
-						FString DevicePath(Context.Path);
-						if (DevicePath.Contains(TEXT("{00001124-0000-1000-8000-00805f9b34fb}")) ||
-							DevicePath.Contains(TEXT("bth")) ||
-							DevicePath.Contains(TEXT("BTHENUM")))
-						{
-							unsigned char FeatureBuffer[78];
-							FeatureBuffer[0] = 0x05;
-							if (!HidD_GetFeature(TempDeviceHandle, FeatureBuffer, 78)) {
-								UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to HidD_GetFeature."));
-							}
-							Context.ConnectionType = Bluetooth;
-						}
-						Devices.Add(Context);
-					}
-				}
-				CloseHandle(TempDeviceHandle);
-			}
-		}
-		free(DetailDataBuffer);
+		static TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport;
+		return Transport;
 	}
-
-	SetupDiDestroyDeviceInfoList(DeviceInfoSet);
 }
 
+TSharedPtr<IHidTransport, ESPMode::ThreadSafe> FHIDDeviceInfo::CreatePlatformTransport()
+{
+#if PLATFORM_WINDOWS
+	return MakeShared<FWindowsHidTransport, ESPMode::ThreadSafe>();
+#elif PLATFORM_LINUX
+	return MakeShared<FLinuxHidrawTransport, ESPMode::ThreadSafe>();
+#else
+	// No native backend on this platform: an empty loopback keeps every operation well defined.
+	return MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+#endif
+}
 
+void FHIDDeviceInfo::SetTransport(const TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& InTransport)
+{
+	FScopeLock Lock(&GetTransportLock());
+	GetTransportSlot() = InTransport.IsValid() ? InTransport : CreatePlatformTransport();
+}
 
-void FHIDDeviceInfo::Read(FDeviceContext* Context)
+TSharedPtr<IHidTransport, ESPMode::ThreadSafe> FHIDDeviceInfo::GetTransport()
 {
-	if (!Context)
-	{
-		UE_LOG(LogTemp, Error, TEXT("Context nto found!"));
-		return;
-	}
-	
-	if (Context->Handle == INVALID_HANDLE_VALUE)
+	FScopeLock Lock(&GetTransportLock());
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& Transport = GetTransportSlot();
+	if (!Transport.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Invalid device handle before attempting to read"));
-		return;
-	}
-	
-	if (!Context->IsConnected)
-	{
-		InvalidateHandle(Context);
-		UE_LOG(LogTemp, Error, TEXT("Dualsense: DeviceContext->Connected, false"));
-		return;
-	}
-	
-	HidD_FlushQueue(Context->Handle);
-
-	
-	// if (!PollResults.Contains(Context->UniqueInputDeviceId))
-	// {
-	// 	
-	// 	PollResults.Add(Context->UniqueInputDeviceId, TPair<EPollResult, FPollState>(EPollResult::NoIoThisTick, State));
-	// }
-
-	// TPair<EPollResult, FPollState>& PollResult = FHIDDeviceInfo::PollResults[Context->UniqueInputDeviceId];
-	
-	DWORD BytesRead = 0;
-	if (Context->ConnectionType == Bluetooth && Context->DeviceType == EDeviceType::DualShock4)
-	{
-		const size_t InputReportLength = Context->ConnectionType == Bluetooth ? 547 : 64;
-		if (sizeof(Context->BufferDS4) < InputReportLength)
-		{
-			InvalidateHandle(Context);
-			return;
-		}
-		
-		const EPollResult Response = PollTick(Context->Handle, Context->BufferDS4, InputReportLength, BytesRead);
-		if (Response == EPollResult::Disconnected)
-		{
-			InvalidateHandle(Context);
-		}
-		return;
+		Transport = CreatePlatformTransport();
 	}
+	return Transport;
+}
 
-	const size_t InputReportLength = Context->ConnectionType == Bluetooth ? 78 : 64;
-	if (sizeof(Context->Buffer) < InputReportLength)
-	{
-		InvalidateHandle(Context);
-		return;
-	}
+TSharedPtr<IHidTransport, ESPMode::ThreadSafe> FHIDDeviceInfo::GetTransport(const FDeviceContext& Context)
+{
+	return Context.Transport.IsValid() ? Context.Transport : GetTransport();
+}
 
-	const EPollResult Response = PollTick(Context->Handle, Context->Buffer, InputReportLength, BytesRead);
-	if (Response == EPollResult::Disconnected)
+void FHIDDeviceInfo::Detect(TArray<FDeviceContext>& Devices)
+{
+	const TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport = GetTransport();
+	Transport->Detect(Devices);
+	for (FDeviceContext& Context : Devices)
 	{
-		InvalidateHandle(Context);
+		Context.Transport = Transport;
 	}
 }
 
 void FHIDDeviceInfo::Write(FDeviceContext* Context)
 {
-	if (Context->Handle == INVALID_HANDLE_VALUE)
+	if (Context->Handle == IHidTransport::InvalidHandle())
 	{
 		return;
 	}
-	
-	size_t InReportLength = Context->DeviceType == DualShock4 ? 32 : 74;
-	size_t OutputReportLength = Context->ConnectionType == Bluetooth ? 78 : InReportLength;
 
-	DWORD BytesWritten = 0;
-	if (!WriteFile(Context->Handle, Context->BufferOutput, OutputReportLength, &BytesWritten, nullptr))
+	const size_t OutputReportLength = GetOutputReportLength(*Context);
+	if (!GetTransport(*Context)->Write(Context->Handle, Context->BufferOutput, OutputReportLength))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed DualShock to write output data to device. report %llu error Code: %d"),
-			OutputReportLength, GetLastError());
-		InvalidateHandle(Context);
+		UE_LOG(LogTemp, Error, TEXT("Failed to write output data to device. report %llu"),
+			static_cast<uint64>(OutputReportLength));
+		MarkDisconnected(Context);
 	}
 }
 
-HANDLE FHIDDeviceInfo::CreateHandle(FDeviceContext* DeviceContext)
+size_t FHIDDeviceInfo::GetOutputReportLength(const FDeviceContext& Context)
 {
-	const HANDLE DeviceHandle = CreateFileW(
-			DeviceContext->Path,
-			GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr
-		);
-
-	if (DeviceHandle == INVALID_HANDLE_VALUE)
+	if (Context.ConnectionType == Bluetooth)
 	{
-		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open device handle for the DualSense."));
-		return INVALID_HANDLE_VALUE;
+		return 78;
 	}
-	
-	return DeviceHandle;
+	return Context.DeviceType == DualShock4 ? 32 : 74;
 }
 
-void FHIDDeviceInfo::InvalidateHandle(FDeviceContext* Context)
+void* FHIDDeviceInfo::CreateHandle(FDeviceContext* DeviceContext)
 {
-	IPlatformInputDeviceMapper::Get().Internal_SetInputDeviceConnectionState(Context->UniqueInputDeviceId, EInputDeviceConnectionState::Disconnected);
-	if (!Context)
+	if (!DeviceContext->Transport.IsValid())
 	{
-		return;
-	}
-	
-	if (Context->Handle != INVALID_HANDLE_VALUE)
-	{
-		CloseHandle(Context->Handle);
-		Context->Handle = INVALID_HANDLE_VALUE;
-		Context->IsConnected = false;
-		
-		ZeroMemory(Context->Path, sizeof(Context->Path));
-		ZeroMemory(Context->Buffer, sizeof(Context->Buffer));
-		ZeroMemory(Context->BufferDS4, sizeof(Context->BufferDS4));
-		ZeroMemory(Context->BufferOutput, sizeof(Context->BufferOutput));
-
-		UE_LOG(LogTemp, Log, TEXT("HIDManager: Invalidate Handle."));
+		DeviceContext->Transport = GetTransport();
 	}
+	return DeviceContext->Transport->Open(*DeviceContext);
 }
 
-void FHIDDeviceInfo::InvalidateHandle(HANDLE Handle)
+void FHIDDeviceInfo::InvalidateHandle(FDeviceContext* Context)
 {
-	if (Handle != INVALID_HANDLE_VALUE)
+	if (!Context)
 	{
-		CloseHandle(Handle);
+		return;
 	}
-}
 
-EPollResult FHIDDeviceInfo::PollTick(HANDLE Handle, BYTE* Buffer, DWORD Length, DWORD& OutBytesRead)
-{
-	// const auto Now = std::chrono::steady_clock::now();
-	//
-	// const bool NeedPing =
-	// 	(Now - State.LastSuccess > Policy.WakeThreshold) &&
-	// 	(Now - State.LastPing    >= Policy.MinInterval);
-	//
-	// if (NeedPing)
-	// {
-	// 	DWORD Err = ERROR_SUCCESS;
-	// 	if (!PingOnce(Handle, &Err))
-	// 	{
-	// 		if (ShouldTreatAsDisconnected(Err)) {
-	// 			return EPollResult::Disconnected;
-	// 		}
-	// 	}
-	// 	State.LastPing = Now;
-	// }
-	
-	DWORD Err = ERROR_SUCCESS;
-	PingOnce(Handle, &Err);
-	
-	OutBytesRead = 0;
-	if (!ReadFile(Handle, Buffer, Length, &OutBytesRead, nullptr))
+	IPlatformInputDeviceMapper::Get().Internal_SetInputDeviceConnectionState(Context->UniqueInputDeviceId, EInputDeviceConnectionState::Disconnected);
+	if (Context->Handle != IHidTransport::InvalidHandle())
 	{
-		const DWORD Error = GetLastError();
-		if (ShouldTreatAsDisconnected(Error))
+		if (Context->Handle)
 		{
-			return EPollResult::Disconnected;
+			GetTransport(*Context)->Close(Context->Handle);
 		}
+		Context->Handle = IHidTransport::InvalidHandle();
+		Context->Transport.Reset();
+		Context->IsConnected = false;
 
-		InvalidateHandle(Handle);
-		// Transient read/keep-alive issue
-		// State.LastSuccess = Now - Policy.WakeThreshold - std::chrono::milliseconds(1);
-		// return EPollResult::TransientError;
-	}
+		FMemory::Memzero(Context->Path, sizeof(Context->Path));
+		FMemory::Memzero(Context->Buffer, sizeof(Context->Buffer));
+		FMemory::Memzero(Context->BufferDS4, sizeof(Context->BufferDS4));
+		FMemory::Memzero(Context->BufferOutput, sizeof(Context->BufferOutput));
 
-	// State.LastSuccess = Now;
-	return EPollResult::ReadOk;
+		UE_LOG(LogTemp, Log, TEXT("HIDManager: Invalidate Handle."));
+	}
 }
 
-
-bool FHIDDeviceInfo::PingOnce(HANDLE Handle, DWORD* OutLastError)
+void FHIDDeviceInfo::MarkDisconnected(FDeviceContext* Context)
 {
-	// UE_LOG(LogTemp, Warning, TEXT("Ping..."));
-	FILE_STANDARD_INFO Info;
-	if (!GetFileInformationByHandleEx(Handle, FileStandardInfo, &Info, sizeof(Info)))
+	if (!Context || !Context->IsConnected)
 	{
-		if (OutLastError) *OutLastError = GetLastError();
-		return false;
+		return;
 	}
-	if (OutLastError) *OutLastError = ERROR_SUCCESS;
-	return true;
+
+	IPlatformInputDeviceMapper::Get().Internal_SetInputDeviceConnectionState(Context->UniqueInputDeviceId, EInputDeviceConnectionState::Disconnected);
+	Context->IsConnected = false;
+	UE_LOG(LogTemp, Log, TEXT("HIDManager: Device marked as disconnected."));
 }
@@ -0,0 +1,385 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/HIDReaderRunnable.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Core/HIDDeviceInfo.h"
+#include "Core/PlayStationCrc32.h"
+#include "Core/PlayStationInputDecoder.h"
+
+std::atomic_bool FHIDReaderRunnable::bCrcValidation{true};
+
+FHIDReaderRunnable::FHIDReaderRunnable(const FDeviceContext& InContext):
+	Transport(FHIDDeviceInfo::GetTransport(InContext)),
+	Context(InContext),
+	ReportLength(0),
+	ReadStream(nullptr),
+	Thread(nullptr),
+	bAttached(false),
+	Reports(ChannelCapacity),
+	History(
+		InContext.DeviceType == DualShock4 ? 16.0 / 3.0 / 1000000.0 : 1.0 / 3.0 / 1000000.0,
+		InContext.DeviceType == DualShock4 ? 16 : 32
+	),
+	ReportsRead(0),
+	DeviceTimestampPeriod(InContext.DeviceType == DualShock4 ? 16.0 / 3.0 / 1000000.0 : 1.0 / 3.0 / 1000000.0),
+	DeviceTimestampMask(InContext.DeviceType == DualShock4 ? 0xFFFFu : 0xFFFFFFFFu),
+	bAutoCalibration(true),
+	GyroBias(FVector::ZeroVector),
+	Motion(),
+	LastMotionTimestamp(0),
+	bHasMotionTimestamp(false),
+	bOrientationResetRequested(false),
+	FusionGain(FMotionFusionFilter::DefaultGain),
+	bAutoCalibrationRequested(true),
+	RequestedCalibrationSeconds(-1.0),
+	CalibrationProgress(-1.0f),
+	CalibrationVersion(0),
+	CompletedCalibrations(0),
+	bStopRequested(false),
+	bDisconnected(false),
+	DroppedReports(0),
+	CrcFailures(0)
+{
+	if (Context.DeviceType == DualShock4 && Context.ConnectionType == Bluetooth)
+	{
+		ReportLength = 547;
+	}
+	else
+	{
+		ReportLength = Context.ConnectionType == Bluetooth ? 78 : 64;
+	}
+}
+
+FHIDReaderRunnable::~FHIDReaderRunnable()
+{
+	Stop();
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (ReadStream)
+	{
+		if (bAttached)
+		{
+			Transport->DetachReader(ReadStream);
+			bAttached = false;
+		}
+		Transport->CloseReader(ReadStream);
+		ReadStream = nullptr;
+	}
+}
+
+bool FHIDReaderRunnable::Init()
+{
+	return ReadStream != nullptr;
+}
+
+uint32 FHIDReaderRunnable::Run()
+{
+	uint32 TransientErrors = 0;
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		size_t Length = 0;
+		unsigned char* Buffer = GetReportBuffer(Length);
+		size_t BytesRead = 0;
+		const EPollResult Result = Transport->ReadReport(ReadStream, Buffer, Length, BytesRead);
+		if (Result == EPollResult::TransientError)
+		{
+			// A failure that keeps coming back would otherwise spin this thread; past the
+			// bound the device is considered lost.
+			if (++TransientErrors >= IHidTransport::MaxTransientErrors)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("HIDReader: %u consecutive read errors."), TransientErrors);
+				OnDisconnected();
+				return 1;
+			}
+			FPlatformProcess::Sleep(IHidTransport::TransientErrorBackoffSeconds);
+			continue;
+		}
+		TransientErrors = 0;
+
+		if (Result == EPollResult::Disconnected)
+		{
+			OnDisconnected();
+			return 1;
+		}
+
+		if (Result == EPollResult::ReadOk)
+		{
+			OnReport(BytesRead);
+		}
+	}
+
+	return 0;
+}
+
+unsigned char* FHIDReaderRunnable::GetReportBuffer(size_t& OutLength)
+{
+	// The write slot is owned by the reading thread until it is published, so the device can
+	// fill it directly without any intermediate copy.
+	OutLength = ReportLength;
+	return Snapshot.GetWriteBuffer().Data;
+}
+
+void FHIDReaderRunnable::OnReport(const size_t BytesRead)
+{
+	if (BytesRead == 0)
+	{
+		return;
+	}
+
+	FInputReport& Report = Snapshot.GetWriteBuffer();
+	Report.Length = static_cast<uint32>(BytesRead);
+	if (Context.ConnectionType == Bluetooth && IsCrcValidationEnabled() && !HasValidCrc(Context, Report))
+	{
+		// The slot is not published, so the next read simply overwrites it.
+		CrcFailures.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Report.HostCycles = FPlatformTime::Cycles64();
+	Report.Sequence = ++ReportsRead;
+	Report.DeviceTimestamp = ExtractDeviceTimestamp(Context, Report);
+	FuseMotion(Report);
+	if (!Reports.Enqueue(Report))
+	{
+		DroppedReports.fetch_add(1, std::memory_order_relaxed);
+	}
+	Snapshot.SwapWriteBuffers();
+}
+
+void FHIDReaderRunnable::OnDisconnected()
+{
+	UE_LOG(LogTemp, Log, TEXT("HIDReader: device is no longer connected. Shutting down the reader"));
+	bDisconnected.store(true, std::memory_order_release);
+}
+
+uint32 FHIDReaderRunnable::ExtractDeviceTimestamp(const FDeviceContext& Context, const FInputReport& Report)
+{
+	if (Context.DeviceType == DualShock4)
+	{
+		// 16-bit counter at bytes 9-10 of the payload, after the report id and Bluetooth header.
+		const uint32 Offset = (Context.ConnectionType == Bluetooth
+			                       ? FDualShockBluetoothReportLayout::Padding
+			                       : FDualShockUsbReportLayout::Padding) + FDualShockUsbReportLayout::Timestamp;
+		if (Report.Length < Offset + 2)
+		{
+			return 0;
+		}
+		return Report.Data[Offset] | (Report.Data[Offset + 1] << 8);
+	}
+
+	// 32-bit counter at bytes 27-30 of the payload, after the report id and Bluetooth header.
+	const uint32 Offset = (Context.ConnectionType == Bluetooth
+		                       ? FDualSenseBluetoothReportLayout::Padding
+		                       : FDualSenseUsbReportLayout::Padding) + FDualSenseUsbReportLayout::Timestamp;
+	if (Report.Length < Offset + 4)
+	{
+		return 0;
+	}
+	return Report.Data[Offset] | (Report.Data[Offset + 1] << 8) | (Report.Data[Offset + 2] << 16) |
+		(static_cast<uint32>(Report.Data[Offset + 3]) << 24);
+}
+
+bool FHIDReaderRunnable::ReadMotion(const FDeviceContext& Context, const FInputReport& Report, int16 (&OutGyro)[3],
+                                    int16 (&OutAccel)[3])
+{
+	uint32 Offset;
+	int32 GyroOffset;
+	int32 AccelOffset;
+	if (Context.DeviceType == DualShock4)
+	{
+		const bool bBluetooth = Context.ConnectionType == Bluetooth;
+		if (Report.Data[0] != (bBluetooth ? 0x11 : 0x01))
+		{
+			return false;
+		}
+		Offset = bBluetooth ? FDualShockBluetoothReportLayout::Padding : FDualShockUsbReportLayout::Padding;
+		GyroOffset = FDualShockUsbReportLayout::Gyro;
+		AccelOffset = FDualShockUsbReportLayout::Accel;
+	}
+	else
+	{
+		const bool bBluetooth = Context.ConnectionType == Bluetooth;
+		if (Report.Data[0] != (bBluetooth ? 0x31 : 0x01))
+		{
+			return false;
+		}
+		Offset = bBluetooth ? FDualSenseBluetoothReportLayout::Padding : FDualSenseUsbReportLayout::Padding;
+		GyroOffset = FDualSenseUsbReportLayout::Gyro;
+		AccelOffset = FDualSenseUsbReportLayout::Accel;
+	}
+
+	if (Report.Length < Offset + FMath::Max(GyroOffset, AccelOffset) + 6)
+	{
+		return false;
+	}
+
+	const unsigned char* Payload = Report.Data + Offset;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		OutGyro[Axis] = static_cast<int16>(Payload[GyroOffset + Axis * 2] | (Payload[GyroOffset + Axis * 2 + 1] << 8));
+		OutAccel[Axis] = static_cast<int16>(Payload[AccelOffset + Axis * 2] | (Payload[AccelOffset + Axis * 2 + 1] << 8));
+	}
+	return true;
+}
+
+void FHIDReaderRunnable::FuseMotion(FInputReport& Report)
+{
+	if (bOrientationResetRequested.exchange(false, std::memory_order_relaxed))
+	{
+		Fusion.Reset();
+		bHasMotionTimestamp = false;
+	}
+
+	const bool bAutoCalibrationNow = bAutoCalibrationRequested.load(std::memory_order_relaxed);
+	if (bAutoCalibrationNow != bAutoCalibration)
+	{
+		bAutoCalibration = bAutoCalibrationNow;
+		Calibrator.SetAutoCalibration(bAutoCalibration);
+	}
+
+	const double CalibrationSeconds = RequestedCalibrationSeconds.exchange(-1.0, std::memory_order_relaxed);
+	if (CalibrationSeconds >= 0.0)
+	{
+		Calibrator.Begin(CalibrationSeconds);
+	}
+
+	int16 Gyro[3];
+	int16 Accel[3];
+	if (ReadMotion(Context, Report, Gyro, Accel))
+	{
+		// Without a previous sample the step is zero, which only initializes the filter.
+		const double DeltaSeconds = bHasMotionTimestamp
+			                            ? ((Report.DeviceTimestamp - LastMotionTimestamp) & DeviceTimestampMask) *
+			                            DeviceTimestampPeriod
+			                            : 0.0;
+		// Gaps are not sensor time the controller was observed for.
+		const double SampleSeconds = DeltaSeconds <= FMotionFusionFilter::MaxStepSeconds ? DeltaSeconds : 0.0;
+
+		FMotionCalibration Calibration;
+		const bool bCalibrated = Calibrator.Add(Gyro, Accel, SampleSeconds, Calibration);
+		if (Calibrator.GetProgress() >= 0.0)
+		{
+			CalibrationProgress.store(static_cast<float>(Calibrator.GetProgress()), std::memory_order_relaxed);
+		}
+		if (bCalibrated)
+		{
+			GyroBias = Calibration.GyroMean;
+			Fusion.SetGyroBias(FVector3f(GyroBias));
+			{
+				FScopeLock ScopeLock(&CalibrationLock);
+				if (Calibration.bExplicit)
+				{
+					LatestCalibration = Calibration;
+				}
+				else
+				{
+					// Resting only tells about the gyroscope; keep the accelerometer of the last
+					// requested calibration.
+					LatestCalibration.GyroMean = Calibration.GyroMean;
+					LatestCalibration.GyroStdDev = Calibration.GyroStdDev;
+				}
+			}
+			if (Calibration.bExplicit)
+			{
+				CalibrationProgress.store(1.0f, std::memory_order_relaxed);
+				CompletedCalibrations.fetch_add(1, std::memory_order_relaxed);
+			}
+			CalibrationVersion.fetch_add(1, std::memory_order_release);
+		}
+
+		const FVector GyroSample(Gyro[0], Gyro[1], Gyro[2]);
+		Motion.GyroSeconds += GyroSample * SampleSeconds;
+		Motion.AngleDegrees += (GyroSample - GyroBias) * (SampleSeconds / FMotionFusionFilter::GyroCountsPerDegree);
+		Motion.AccelSum += FVector(Accel[0], Accel[1], Accel[2]);
+		Motion.Seconds += SampleSeconds;
+		++Motion.Samples;
+
+		Fusion.SetGain(FusionGain.load(std::memory_order_relaxed));
+		Fusion.Update(Gyro, Accel, DeltaSeconds);
+		LastMotionTimestamp = Report.DeviceTimestamp;
+		bHasMotionTimestamp = true;
+	}
+	Report.Orientation = Fusion.GetOrientation();
+	Report.Motion = Motion;
+}
+
+bool FHIDReaderRunnable::GetCalibration(FMotionCalibration& OutCalibration, uint32& InOutVersion)
+{
+	const uint32 Version = CalibrationVersion.load(std::memory_order_acquire);
+	if (Version == InOutVersion)
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&CalibrationLock);
+	OutCalibration = LatestCalibration;
+	InOutVersion = Version;
+	return true;
+}
+
+bool FHIDReaderRunnable::HasValidCrc(const FDeviceContext& Context, const FInputReport& Report)
+{
+	// 0x31 is the full DualSense report and 0x11 the full DualShock 4 report.
+	const unsigned char FullReportId = Context.DeviceType == DualShock4 ? 0x11 : 0x31;
+	if (Report.Data[0] != FullReportId)
+	{
+		return true;
+	}
+
+	if (Report.Length < CrcCoveredLength + 4)
+	{
+		return false;
+	}
+
+	const unsigned char* Trailer = &Report.Data[CrcCoveredLength];
+	const uint32 Expected = Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<uint32>(Trailer[3]) << 24);
+	const uint32 Actual = FPlayStationCrc32::Finalize(
+		FPlayStationCrc32::Update(FPlayStationCrc32::InputSeedState, Report.Data, CrcCoveredLength));
+	return Actual == Expected;
+}
+
+void FHIDReaderRunnable::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	if (ReadStream && !bAttached)
+	{
+		Transport->CancelRead(ReadStream);
+	}
+}
+
+void FHIDReaderRunnable::StartThread()
+{
+	ReadStream = Transport->OpenReader(Context);
+	if (!ReadStream)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDReader: Failed to open the read stream for the device."));
+		bDisconnected.store(true, std::memory_order_release);
+		return;
+	}
+
+	if (Transport->AttachReader(ReadStream, *this))
+	{
+		bAttached = true;
+		return;
+	}
+
+	const FString ThreadName = FString::Printf(TEXT("FHIDReaderRunnable_%p"), this);
+	Thread = FRunnableThread::Create(this, *ThreadName, 0, TPri_AboveNormal);
+}
+
+void FHIDReaderRunnable::Exit()
+{
+	UE_LOG(LogTemp, Log, TEXT("HIDReader: thread is exiting."));
+}
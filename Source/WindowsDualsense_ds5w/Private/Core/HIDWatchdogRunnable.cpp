@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/HIDWatchdogRunnable.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+FHIDWatchdogRunnable::FHIDWatchdogRunnable(TFunction<void(int32 DeviceId)> InOnDisconnected):
+	OnDisconnected(MoveTemp(InOnDisconnected)),
+	WakeEvent(FPlatformProcess::GetSynchEventFromPool(false)),
+	Thread(nullptr),
+	bStopRequested(false)
+{
+}
+
+FHIDWatchdogRunnable::~FHIDWatchdogRunnable()
+{
+	Stop();
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+uint32 FHIDWatchdogRunnable::Run()
+{
+	TArray<int32> Disconnected;
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		double WaitSeconds = -1.0;
+		{
+			FScopeLock ScopeLock(&Lock);
+			while (Schedule.Num() > 0 && !bStopRequested.load(std::memory_order_relaxed))
+			{
+				const double Now = FPlatformTime::Seconds();
+				if (Schedule.HeapTop().DueTime > Now)
+				{
+					WaitSeconds = Schedule.HeapTop().DueTime - Now;
+					break;
+				}
+
+				FScheduledPing Ping;
+				Schedule.HeapPop(Ping);
+
+				const FWatchedDevice* Device = Devices.Find(Ping.DeviceId);
+				if (!Device || Device->Generation != Ping.Generation)
+				{
+					continue;
+				}
+
+				if (Device->Transport->Ping(Device->Handle) == EPollResult::Disconnected)
+				{
+					UE_LOG(LogTemp, Log, TEXT("Ping failed: device %d is no longer connected. Removing it from the watchdog."), Ping.DeviceId);
+					Devices.Remove(Ping.DeviceId);
+					Disconnected.Add(Ping.DeviceId);
+					continue;
+				}
+
+				// Keep a stable cadence, but skip the slots that were missed after a stall.
+				Ping.DueTime += Device->IntervalSeconds;
+				if (Ping.DueTime <= Now)
+				{
+					Ping.DueTime = Now + Device->IntervalSeconds;
+				}
+				Schedule.HeapPush(Ping);
+			}
+		}
+
+		for (const int32 DeviceId : Disconnected)
+		{
+			if (OnDisconnected)
+			{
+				OnDisconnected(DeviceId);
+			}
+		}
+		Disconnected.Reset();
+
+		if (bStopRequested.load(std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		if (WaitSeconds < 0.0)
+		{
+			WakeEvent->Wait();
+		}
+		else
+		{
+			WakeEvent->Wait(FMath::Max(1, FMath::CeilToInt(WaitSeconds * 1000.0)));
+		}
+	}
+
+	return 0;
+}
+
+void FHIDWatchdogRunnable::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FHIDWatchdogRunnable::StartThread()
+{
+	Thread = FRunnableThread::Create(this, TEXT("FHIDWatchdogRunnable"), 0, TPri_BelowNormal);
+}
+
+void FHIDWatchdogRunnable::AddDevice(const int32 DeviceId,
+                                     const TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& DeviceTransport,
+                                     void* DeviceHandle, const std::chrono::milliseconds Interval)
+{
+	if (!DeviceTransport.IsValid() || DeviceHandle == IHidTransport::InvalidHandle())
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		FWatchedDevice& Device = Devices.FindOrAdd(DeviceId);
+		Device.Transport = DeviceTransport;
+		Device.Handle = DeviceHandle;
+		Device.IntervalSeconds = FMath::Max(0.001, Interval.count() / 1000.0);
+		Device.Generation = ++NextGeneration;
+
+		FScheduledPing Ping;
+		Ping.DueTime = FPlatformTime::Seconds() + Device.IntervalSeconds;
+		Ping.DeviceId = DeviceId;
+		Ping.Generation = Device.Generation;
+		Schedule.HeapPush(Ping);
+	}
+
+	WakeEvent->Trigger();
+}
+
+void FHIDWatchdogRunnable::RemoveDevice(const int32 DeviceId)
+{
+	FScopeLock ScopeLock(&Lock);
+	Devices.Remove(DeviceId);
+}
+
+int32 FHIDWatchdogRunnable::GetNumDevices() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Devices.Num();
+}
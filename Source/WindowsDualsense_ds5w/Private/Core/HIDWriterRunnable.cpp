@@ -0,0 +1,311 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/HIDWriterRunnable.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Core/HIDDeviceInfo.h"
+#include "Core/InputLatencyStats.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Core/TriggerEffectSequence.h"
+
+FHIDWriterRunnable::FHIDWriterRunnable(const FDeviceContext& InContext, void (*InComposer)(FDeviceContext*),
+                                       TSharedPtr<FInputLatencyStats, ESPMode::ThreadSafe> InStats,
+                                       const double InWriteIntervalSeconds):
+	Transport(FHIDDeviceInfo::GetTransport(InContext)),
+	Context(InContext),
+	Composer(InComposer),
+	Stats(MoveTemp(InStats)),
+	WriteIntervalSeconds(FMath::Max(0.0, InWriteIntervalSeconds)),
+	LastWriteSeconds(0.0),
+	RefreshIntervalSeconds(InContext.ConnectionType == Bluetooth ? BluetoothRefreshIntervalSeconds : 0.0),
+	LastSent{},
+	bHasSent(false),
+	Latest(InContext.Output),
+	Pending(InContext.Output),
+	bDirty(false),
+	bSequenceRequested{false, false},
+	WakeEvent(FPlatformProcess::GetSynchEventFromPool(false)),
+	FinishedEvent(FPlatformProcess::GetSynchEventFromPool(true)),
+	Thread(nullptr),
+	bStopRequested(false),
+	bFailed(false),
+	bDiscardPending(false),
+	SubmittedCount(0),
+	WrittenCount(0),
+	SkippedCount(0)
+{
+}
+
+FHIDWriterRunnable::~FHIDWriterRunnable()
+{
+	Stop();
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(FinishedEvent);
+	FinishedEvent = nullptr;
+}
+
+namespace
+{
+	/**
+	 * Writers whose thread did not exit within the release timeout.
+	 */
+	FCriticalSection ParkedWritersLock;
+	TArray<TUniquePtr<FHIDWriterRunnable>> ParkedWriters;
+}
+
+void FHIDWriterRunnable::Release(TUniquePtr<FHIDWriterRunnable>& Writer)
+{
+	{
+		FScopeLock ScopeLock(&ParkedWritersLock);
+		ParkedWriters.RemoveAll([](const TUniquePtr<FHIDWriterRunnable>& Parked)
+		{
+			return Parked->FinishedEvent->Wait(0);
+		});
+	}
+
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	Writer->Stop();
+	if (Writer->Thread && !Writer->FinishedEvent->Wait(FTimespan::FromSeconds(ReleaseTimeoutSeconds)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDWriter: Device did not accept the last output report in time, releasing the writer later."));
+		FScopeLock ScopeLock(&ParkedWritersLock);
+		ParkedWriters.Add(MoveTemp(Writer));
+		return;
+	}
+
+	Writer.Reset();
+}
+
+void FHIDWriterRunnable::ReleaseParked()
+{
+	TArray<TUniquePtr<FHIDWriterRunnable>> Writers;
+	{
+		FScopeLock ScopeLock(&ParkedWritersLock);
+		Writers = MoveTemp(ParkedWriters);
+	}
+	Writers.Reset();
+}
+
+uint32 FHIDWriterRunnable::Run()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		double Timeout = -1.0;
+		if (IsPlayingSequence())
+		{
+			Timeout = FMath::Max(WriteIntervalSeconds, 0.001);
+		}
+		if (RefreshIntervalSeconds > 0.0 && bHasSent)
+		{
+			const double UntilRefresh = FMath::Max(0.0, LastWriteSeconds + RefreshIntervalSeconds - FPlatformTime::Seconds());
+			Timeout = Timeout < 0.0 ? UntilRefresh : FMath::Min(Timeout, UntilRefresh);
+		}
+
+		if (Timeout < 0.0)
+		{
+			WakeEvent->Wait();
+		}
+		else
+		{
+			WakeEvent->Wait(FTimespan::FromSeconds(Timeout));
+		}
+
+		if (bStopRequested.load(std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		const bool bRefresh = RefreshIntervalSeconds > 0.0 && bHasSent &&
+			FPlatformTime::Seconds() - LastWriteSeconds >= RefreshIntervalSeconds;
+
+		// Let every change made within the interval land in the same report.
+		const double Remaining = LastWriteSeconds + WriteIntervalSeconds - FPlatformTime::Seconds();
+		if (Remaining > 0.0)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(Remaining));
+		}
+
+		if (!WritePending(bRefresh))
+		{
+			bFailed.store(true, std::memory_order_release);
+			return 1;
+		}
+	}
+
+	if (!bDiscardPending.load(std::memory_order_acquire) && !WritePending())
+	{
+		bFailed.store(true, std::memory_order_release);
+		return 1;
+	}
+	return 0;
+}
+
+void FHIDWriterRunnable::Exit()
+{
+	FinishedEvent->Trigger();
+}
+
+bool FHIDWriterRunnable::WritePending(const bool bRefresh)
+{
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		bool bSequenceChanged = false;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Sequences); ++Index)
+		{
+			if (bSequenceRequested[Index])
+			{
+				Sequences[Index].Data = MoveTemp(RequestedSequences[Index]);
+				Sequences[Index].bStarted = false;
+				bSequenceRequested[Index] = false;
+				bSequenceChanged = true;
+			}
+		}
+
+		if (!bDirty && !bRefresh && !bSequenceChanged && !IsPlayingSequence())
+		{
+			return true;
+		}
+
+		if (bDirty)
+		{
+			Latest = Pending;
+			bDirty = false;
+		}
+	}
+
+	Context.Output = Latest;
+	ApplyTriggerSequences(FPlatformTime::Seconds());
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Composer(&Context);
+	if (!bRefresh && bHasSent && FPlayStationOutputComposer::HasSamePayload(Context, LastSent))
+	{
+		FMemory::Memcpy(Context.BufferOutput, LastSent, sizeof(LastSent));
+		SkippedCount.fetch_add(1, std::memory_order_relaxed);
+		if (FInputLatencyStats::IsEnabled() && Stats.IsValid())
+		{
+			Stats->OutputSkips.fetch_add(1, std::memory_order_relaxed);
+		}
+		return true;
+	}
+
+	const bool bWritten = Transport->Write(Context.Handle, Context.BufferOutput,
+	                                       FHIDDeviceInfo::GetOutputReportLength(Context));
+	LastWriteSeconds = FPlatformTime::Seconds();
+	if (!bWritten)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDWriter: Failed to write output data to device."));
+		return false;
+	}
+
+	FMemory::Memcpy(LastSent, Context.BufferOutput, sizeof(LastSent));
+	bHasSent = true;
+	WrittenCount.fetch_add(1, std::memory_order_relaxed);
+	if (FInputLatencyStats::IsEnabled() && Stats.IsValid())
+	{
+		Stats->OutputWrite.RecordCycles(StartCycles, FPlatformTime::Cycles64());
+		Stats->OutputWrites.fetch_add(1, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+void FHIDWriterRunnable::ApplyTriggerSequences(const double NowSeconds)
+{
+	FHapticTriggers* Triggers[UE_ARRAY_COUNT(Sequences)] = {&Context.Output.LeftTrigger, &Context.Output.RightTrigger};
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Sequences); ++Index)
+	{
+		FSequencePlayback& Playback = Sequences[Index];
+		if (Playback.Data.IsValid() && !Playback.bStarted)
+		{
+			// The clock starts with the first report, so it always carries the first key, even
+			// for a sequence with a single key at time zero.
+			Playback.StartSeconds = NowSeconds;
+			Playback.bStarted = true;
+		}
+		if (Playback.Data.IsValid() && !Playback.Data->Evaluate(NowSeconds - Playback.StartSeconds, *Triggers[Index]))
+		{
+			// Over: the trigger goes back to the effect of the submitted state.
+			Playback.Data.Reset();
+		}
+	}
+}
+
+void FHIDWriterRunnable::PlayTriggerSequence(TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe> Sequence,
+                                             const EControllerHand Hand)
+{
+	if (HasFailed())
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		if (Hand == EControllerHand::Left || Hand == EControllerHand::AnyHand)
+		{
+			RequestedSequences[0] = Sequence;
+			bSequenceRequested[0] = true;
+		}
+		if (Hand == EControllerHand::Right || Hand == EControllerHand::AnyHand)
+		{
+			RequestedSequences[1] = Sequence;
+			bSequenceRequested[1] = true;
+		}
+	}
+	WakeEvent->Trigger();
+}
+
+void FHIDWriterRunnable::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FHIDWriterRunnable::StartThread()
+{
+	if (Context.Handle == IHidTransport::InvalidHandle())
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDWriter: Invalid device handle, output reports will not be written."));
+		bFailed.store(true, std::memory_order_release);
+		return;
+	}
+
+	const FString ThreadName = FString::Printf(TEXT("FHIDWriterRunnable_%p"), this);
+	Thread = FRunnableThread::Create(this, *ThreadName, 0, TPri_AboveNormal);
+}
+
+void FHIDWriterRunnable::Submit(const FOutputContext& Output)
+{
+	if (HasFailed())
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		Pending = Output;
+		bDirty = true;
+	}
+	SubmittedCount.fetch_add(1, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
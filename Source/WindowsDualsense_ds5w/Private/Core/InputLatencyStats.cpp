@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/InputLatencyStats.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_STAT(STAT_DualSense_UpdateInput);
+DEFINE_STAT(STAT_DualSense_DispatchButtons);
+DEFINE_STAT(STAT_DualSense_SendOut);
+DEFINE_STAT(STAT_DualSense_ReportsConsumed);
+DEFINE_STAT(STAT_DualSense_ButtonEvents);
+DEFINE_STAT(STAT_DualSense_AnalogEvents);
+DEFINE_STAT(STAT_DualSense_AnalogSuppressed);
+
+std::atomic_bool FInputLatencyStats::bEnabled{false};
+
+FLatencyHistogram::FLatencyHistogram():
+	Count(0),
+	Sum(0),
+	MaxValue(0)
+{
+	for (std::atomic<uint32>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+uint32 FLatencyHistogram::GetBucketIndex(const uint64 Value)
+{
+	if (Value < SubBucketCount)
+	{
+		return static_cast<uint32>(Value);
+	}
+
+	const uint32 Exponent = FMath::Min<uint32>(FPlatformMath::FloorLog2_64(Value), MaxExponent);
+	if (Exponent == MaxExponent && Value >= (2ull << MaxExponent))
+	{
+		return NumBuckets - 1;
+	}
+
+	const uint32 SubBucket = static_cast<uint32>(Value >> (Exponent - SubBucketBits)) & (SubBucketCount - 1);
+	return (Exponent - SubBucketBits + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FLatencyHistogram::GetBucketValue(const uint32 Index)
+{
+	if (Index < SubBucketCount)
+	{
+		return Index;
+	}
+
+	const uint32 Exponent = Index / SubBucketCount + SubBucketBits - 1;
+	const uint64 SubBucket = Index % SubBucketCount;
+	return (SubBucketCount + SubBucket) << (Exponent - SubBucketBits);
+}
+
+void FLatencyHistogram::Record(const uint64 Microseconds)
+{
+	Buckets[GetBucketIndex(Microseconds)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	Sum.fetch_add(Microseconds, std::memory_order_relaxed);
+
+	uint64 Previous = MaxValue.load(std::memory_order_relaxed);
+	while (Previous < Microseconds && !MaxValue.compare_exchange_weak(Previous, Microseconds, std::memory_order_relaxed))
+	{
+	}
+}
+
+void FLatencyHistogram::Reset()
+{
+	for (std::atomic<uint32>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	Sum.store(0, std::memory_order_relaxed);
+	MaxValue.store(0, std::memory_order_relaxed);
+}
+
+double FLatencyHistogram::GetMean() const
+{
+	const uint64 Samples = GetCount();
+	return Samples > 0 ? static_cast<double>(Sum.load(std::memory_order_relaxed)) / Samples : 0.0;
+}
+
+uint64 FLatencyHistogram::GetPercentile(const double Percentile) const
+{
+	const uint64 Samples = GetCount();
+	if (Samples == 0)
+	{
+		return 0;
+	}
+
+	const uint64 Target = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Samples * FMath::Clamp(Percentile, 0.0, 100.0) / 100.0)));
+	uint64 Seen = 0;
+	for (uint32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Buckets[Index].load(std::memory_order_relaxed);
+		if (Seen >= Target)
+		{
+			return FMath::Min(GetBucketValue(Index), GetMax());
+		}
+	}
+	return GetMax();
+}
+
+FString FLatencyHistogram::ToString() const
+{
+	return FString::Printf(TEXT("n=%llu mean=%.1fus p50=%lluus p90=%lluus p99=%lluus max=%lluus"),
+	                       GetCount(), GetMean(), GetPercentile(50.0), GetPercentile(90.0), GetPercentile(99.0),
+	                       GetMax());
+}
+
+void FInputLatencyStats::Reset()
+{
+	ReadLatency.Reset();
+	ParseTime.Reset();
+	DispatchTime.Reset();
+	InputToEvent.Reset();
+	OutputWrite.Reset();
+	ReportsConsumed.store(0, std::memory_order_relaxed);
+	ButtonEvents.store(0, std::memory_order_relaxed);
+	OutputSubmits.store(0, std::memory_order_relaxed);
+	OutputWrites.store(0, std::memory_order_relaxed);
+	OutputSkips.store(0, std::memory_order_relaxed);
+}
+
+void FInputLatencyStats::Dump(FOutputDevice& Ar, const uint64 DroppedReports, const uint64 CrcFailures) const
+{
+	Ar.Logf(TEXT("  Reports consumed: %llu, dropped: %llu, bad CRC: %llu, button events: %llu, output submits: %llu, output writes: %llu, unchanged skipped: %llu"),
+	        ReportsConsumed.load(std::memory_order_relaxed), DroppedReports, CrcFailures,
+	        ButtonEvents.load(std::memory_order_relaxed), OutputSubmits.load(std::memory_order_relaxed),
+	        OutputWrites.load(std::memory_order_relaxed), OutputSkips.load(std::memory_order_relaxed));
+	Ar.Logf(TEXT("  Read latency:   %s"), *ReadLatency.ToString());
+	Ar.Logf(TEXT("  Parse time:     %s"), *ParseTime.ToString());
+	Ar.Logf(TEXT("  Dispatch time:  %s"), *DispatchTime.ToString());
+	Ar.Logf(TEXT("  Input to event: %s"), *InputToEvent.ToString());
+	Ar.Logf(TEXT("  Output write:   %s"), *OutputWrite.ToString());
+}
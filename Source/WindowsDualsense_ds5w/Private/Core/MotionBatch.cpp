@@ -0,0 +1,130 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/MotionBatch.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+
+void FMotionBatch::Reset()
+{
+	Count = 0;
+}
+
+int32 FMotionBatch::Add(const FVector& Gyro, const FVector& Accel, const FVector& GyroBias, const FVector& AccelBias,
+                        const FVector& GyroDeadZone, const FVector& AccelDeadZone)
+{
+	const int32 Slot = Count++;
+	const int32 Padded = Align(Count, Lanes);
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		if (Input[Channel].Num() < Padded)
+		{
+			Input[Channel].SetNumZeroed(Padded);
+			Bias[Channel].SetNumZeroed(Padded);
+			DeadZone[Channel].SetNumZeroed(Padded);
+			Output[Channel].SetNumZeroed(Padded);
+		}
+		else if (Slot % Lanes == 0)
+		{
+			// First slot of a group reused from a previous tick: clear the padding lanes.
+			FMemory::Memzero(&Input[Channel][Slot], Lanes * sizeof(float));
+			FMemory::Memzero(&Bias[Channel][Slot], Lanes * sizeof(float));
+			FMemory::Memzero(&DeadZone[Channel][Slot], Lanes * sizeof(float));
+		}
+	}
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Input[Axis][Slot] = static_cast<float>(Gyro[Axis]);
+		Bias[Axis][Slot] = static_cast<float>(GyroBias[Axis]);
+		DeadZone[Axis][Slot] = static_cast<float>(GyroDeadZone[Axis]);
+		Input[Axis + 3][Slot] = static_cast<float>(Accel[Axis]);
+		Bias[Axis + 3][Slot] = static_cast<float>(AccelBias[Axis]);
+		DeadZone[Axis + 3][Slot] = static_cast<float>(AccelDeadZone[Axis]);
+	}
+	return Slot;
+}
+
+void FMotionBatch::Process()
+{
+	const int32 Padded = Align(Count, Lanes);
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const float* In = Input[Channel].GetData();
+		const float* Zero = Bias[Channel].GetData();
+		const float* Threshold = DeadZone[Channel].GetData();
+		float* Out = Output[Channel].GetData();
+		for (int32 Index = 0; Index < Padded; Index += Lanes)
+		{
+			const VectorRegister4Float Value = VectorSubtract(VectorLoadAligned(In + Index), VectorLoadAligned(Zero + Index));
+			const VectorRegister4Float Keep = VectorCompareGT(VectorAbs(Value), VectorLoadAligned(Threshold + Index));
+			VectorStoreAligned(VectorSelect(Keep, Value, GlobalVectorConstants::FloatZero), Out + Index);
+		}
+	}
+}
+
+void FMotionBatch::ProcessScalar()
+{
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const float Value = Input[Channel][Index] - Bias[Channel][Index];
+			Output[Channel][Index] = (FMath::Abs(Value) > DeadZone[Channel][Index] ? Value : 0.0f);
+		}
+	}
+}
+
+void FMotionBatch::Benchmark(const int32 NumDevices, const int32 Iterations, FOutputDevice& Ar)
+{
+	FRandomStream Random(0x05D5);
+	const auto RandomVector = [&Random](const float Range)
+	{
+		return FVector(Random.FRandRange(-Range, Range), Random.FRandRange(-Range, Range), Random.FRandRange(-Range, Range));
+	};
+
+	FMotionBatch Batch;
+	for (int32 Device = 0; Device < NumDevices; ++Device)
+	{
+		Batch.Add(RandomVector(2000.0f), RandomVector(8192.0f), RandomVector(40.0f), RandomVector(200.0f),
+		          RandomVector(30.0f), RandomVector(400.0f));
+	}
+
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Batch.ProcessScalar();
+	}
+	const double ScalarSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	TArray<FVector> Expected;
+	Expected.Reserve(NumDevices * 2);
+	for (int32 Device = 0; Device < NumDevices; ++Device)
+	{
+		Expected.Add(Batch.GetGyro(Device));
+		Expected.Add(Batch.GetAccel(Device));
+	}
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Batch.Process();
+	}
+	const double VectorSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	int32 Mismatches = 0;
+	for (int32 Device = 0; Device < NumDevices; ++Device)
+	{
+		Mismatches += Batch.GetGyro(Device) != Expected[Device * 2];
+		Mismatches += Batch.GetAccel(Device) != Expected[Device * 2 + 1];
+	}
+
+	const double ScalarNs = ScalarSeconds * 1.0e9 / Iterations;
+	const double VectorNs = VectorSeconds * 1.0e9 / Iterations;
+	Ar.Logf(TEXT("Motion batch of %d devices, %d iterations:"), NumDevices, Iterations);
+	Ar.Logf(TEXT("  scalar %.1f ns per batch, vector %.1f ns per batch (%.2fx)"), ScalarNs, VectorNs,
+	        VectorNs > 0.0 ? ScalarNs / VectorNs : 0.0);
+	Ar.Logf(TEXT("  %s"), Mismatches == 0 ? TEXT("results match") : *FString::Printf(TEXT("%d results differ"), Mismatches));
+}
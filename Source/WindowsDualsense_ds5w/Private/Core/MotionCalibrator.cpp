@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/MotionCalibrator.h"
+
+void FMotionCalibrator::Begin(const double DurationSeconds)
+{
+	Requested.Reset();
+	RequestedDuration = FMath::Max(DurationSeconds, 0.001);
+	RequestedElapsed = 0.0;
+}
+
+bool FMotionCalibrator::Add(const int16 (&Gyro)[3], const int16 (&Accel)[3], const double DeltaSeconds,
+                            FMotionCalibration& OutResult)
+{
+	bool bHasResult = false;
+
+	if (RequestedDuration > 0.0)
+	{
+		Requested.Add(Gyro, Accel);
+		RequestedElapsed += DeltaSeconds;
+		if (RequestedElapsed >= RequestedDuration)
+		{
+			OutResult = ToResult(Requested, true);
+			RequestedDuration = 0.0;
+			bHasResult = true;
+			GyroBias = OutResult.GyroMean;
+			bHasGyroBias = true;
+		}
+	}
+
+	if (!bAutoCalibration)
+	{
+		return bHasResult;
+	}
+
+	if (Still.Count > 0)
+	{
+		for (int32 Channel = 0; Channel < FMotionWelford::NumChannels; ++Channel)
+		{
+			const double Value = Channel < 3 ? Gyro[Channel] : Accel[Channel - 3];
+			const double Band = Channel < 3 ? GyroStillBand : AccelStillBand;
+			if (FMath::Abs(Value - Still.Mean[Channel]) > Band)
+			{
+				// Moving: the window starts over from this sample.
+				Still.Reset();
+				StillElapsed = 0.0;
+				break;
+			}
+		}
+	}
+
+	if (Still.Count > 0)
+	{
+		StillElapsed += DeltaSeconds;
+	}
+	Still.Add(Gyro, Accel);
+
+	if (StillElapsed >= StillSeconds)
+	{
+		// A requested calibration finishing on the same sample takes precedence.
+		if (!bHasResult && IsNearGyroBias(Still))
+		{
+			OutResult = ToResult(Still, false);
+			bHasResult = true;
+			GyroBias = OutResult.GyroMean;
+			bHasGyroBias = true;
+		}
+		Still.Reset();
+		StillElapsed = 0.0;
+	}
+
+	return bHasResult;
+}
+
+bool FMotionCalibrator::IsNearGyroBias(const FMotionWelford& Stats) const
+{
+	const double Tolerance = bHasGyroBias ? GyroBiasTolerance : MaxGyroBias;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const double Reference = bHasGyroBias ? GyroBias[Axis] : 0.0;
+		if (FMath::Abs(Stats.Mean[Axis] - Reference) > Tolerance)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FMotionCalibration FMotionCalibrator::ToResult(const FMotionWelford& Stats, const bool bExplicit)
+{
+	FMotionCalibration Result;
+	Result.GyroMean = FVector(Stats.Mean[0], Stats.Mean[1], Stats.Mean[2]);
+	Result.AccelMean = FVector(Stats.Mean[3], Stats.Mean[4], Stats.Mean[5]);
+	Result.GyroStdDev = FVector(FMath::Sqrt(Stats.Variance(0)), FMath::Sqrt(Stats.Variance(1)),
+	                            FMath::Sqrt(Stats.Variance(2)));
+	Result.AccelStdDev = FVector(FMath::Sqrt(Stats.Variance(3)), FMath::Sqrt(Stats.Variance(4)),
+	                             FMath::Sqrt(Stats.Variance(5)));
+	Result.SampleCount = Stats.Count;
+	Result.bExplicit = bExplicit;
+	return Result;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/MotionFusionFilter.h"
+
+FMotionFusionFilter::FMotionFusionFilter():
+	Q0(1.0f), Q1(0.0f), Q2(0.0f), Q3(0.0f),
+	Gain(DefaultGain),
+	GyroBias(FVector3f::ZeroVector),
+	bInitialized(false)
+{
+}
+
+void FMotionFusionFilter::Reset()
+{
+	Q0 = 1.0f;
+	Q1 = Q2 = Q3 = 0.0f;
+	bInitialized = false;
+}
+
+void FMotionFusionFilter::Update(const int16 (&Gyro)[3], const int16 (&Accel)[3], const double DeltaSeconds)
+{
+	// Sensor frame (X right, Y out of the face, Z towards the player) to the filter frame
+	// (X right, Y forward, Z up); both are right-handed.
+	float Ax = Accel[0];
+	float Ay = -Accel[2];
+	float Az = Accel[1];
+	const float AccelNorm = FMath::Sqrt(Ax * Ax + Ay * Ay + Az * Az);
+	if (AccelNorm > 0.0f)
+	{
+		Ax /= AccelNorm;
+		Ay /= AccelNorm;
+		Az /= AccelNorm;
+	}
+
+	if (!bInitialized)
+	{
+		if (AccelNorm == 0.0f)
+		{
+			return;
+		}
+
+		// Shortest rotation taking the measured up vector onto the world up axis.
+		if (Az < -0.9999f)
+		{
+			Q0 = 0.0f;
+			Q1 = 1.0f;
+			Q2 = Q3 = 0.0f;
+		}
+		else
+		{
+			const float Norm = FMath::Sqrt(2.0f * (1.0f + Az));
+			Q0 = (1.0f + Az) / Norm;
+			Q1 = Ay / Norm;
+			Q2 = -Ax / Norm;
+			Q3 = 0.0f;
+		}
+		bInitialized = true;
+		return;
+	}
+
+	if (DeltaSeconds <= 0.0 || DeltaSeconds > MaxStepSeconds)
+	{
+		return;
+	}
+
+	constexpr float RadiansPerCount = UE_PI / 180.0f / GyroCountsPerDegree;
+	const float Gx = (Gyro[0] - GyroBias.X) * RadiansPerCount;
+	const float Gy = -(Gyro[2] - GyroBias.Z) * RadiansPerCount;
+	const float Gz = (Gyro[1] - GyroBias.Y) * RadiansPerCount;
+
+	// Rate of change of the orientation from the angular velocity.
+	float QDot0 = 0.5f * (-Q1 * Gx - Q2 * Gy - Q3 * Gz);
+	float QDot1 = 0.5f * (Q0 * Gx + Q2 * Gz - Q3 * Gy);
+	float QDot2 = 0.5f * (Q0 * Gy - Q1 * Gz + Q3 * Gx);
+	float QDot3 = 0.5f * (Q0 * Gz + Q1 * Gy - Q2 * Gx);
+
+	if (AccelNorm > 0.0f)
+	{
+		// Gradient of the error between the measured and the estimated direction of gravity.
+		const float Q0Q0 = Q0 * Q0;
+		const float Q1Q1 = Q1 * Q1;
+		const float Q2Q2 = Q2 * Q2;
+		const float Q3Q3 = Q3 * Q3;
+
+		float S0 = 4.0f * Q0 * Q2Q2 + 2.0f * Q2 * Ax + 4.0f * Q0 * Q1Q1 - 2.0f * Q1 * Ay;
+		float S1 = 4.0f * Q1 * Q3Q3 - 2.0f * Q3 * Ax + 4.0f * Q0Q0 * Q1 - 2.0f * Q0 * Ay - 4.0f * Q1 +
+			8.0f * Q1 * Q1Q1 + 8.0f * Q1 * Q2Q2 + 4.0f * Q1 * Az;
+		float S2 = 4.0f * Q0Q0 * Q2 + 2.0f * Q0 * Ax + 4.0f * Q2 * Q3Q3 - 2.0f * Q3 * Ay - 4.0f * Q2 +
+			8.0f * Q2 * Q1Q1 + 8.0f * Q2 * Q2Q2 + 4.0f * Q2 * Az;
+		float S3 = 4.0f * Q1Q1 * Q3 - 2.0f * Q1 * Ax + 4.0f * Q2Q2 * Q3 - 2.0f * Q2 * Ay;
+
+		const float StepNorm = FMath::Sqrt(S0 * S0 + S1 * S1 + S2 * S2 + S3 * S3);
+		if (StepNorm > 0.0f)
+		{
+			const float Scale = Gain / StepNorm;
+			QDot0 -= S0 * Scale;
+			QDot1 -= S1 * Scale;
+			QDot2 -= S2 * Scale;
+			QDot3 -= S3 * Scale;
+		}
+	}
+
+	const float Dt = static_cast<float>(DeltaSeconds);
+	Q0 += QDot0 * Dt;
+	Q1 += QDot1 * Dt;
+	Q2 += QDot2 * Dt;
+	Q3 += QDot3 * Dt;
+
+	const float Norm = FMath::Sqrt(Q0 * Q0 + Q1 * Q1 + Q2 * Q2 + Q3 * Q3);
+	Q0 /= Norm;
+	Q1 /= Norm;
+	Q2 /= Norm;
+	Q3 /= Norm;
+}
+
+FQuat FMotionFusionFilter::GetOrientation() const
+{
+	// Swapping X and Y turns the right-handed filter frame into the left-handed Unreal frame;
+	// the vector part of a rotation flips sign under that reflection.
+	return FQuat(-Q2, -Q1, -Q3, Q0);
+}
@@ -0,0 +1,345 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/PlayStationCrc32.h"
+#include "Core/PlayStationOutputComposer.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#define DUALSENSE_CRC32_PCLMUL 1
+#include <wmmintrin.h>
+#include <smmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#if defined(__clang__) || defined(__GNUC__)
+#define DUALSENSE_CRC32_PCLMUL_TARGET __attribute__((target("sse4.1,pclmul")))
+#else
+#define DUALSENSE_CRC32_PCLMUL_TARGET
+#endif
+#else
+#define DUALSENSE_CRC32_PCLMUL 0
+#endif
+
+#if PLATFORM_CPU_ARM_FAMILY && defined(__ARM_FEATURE_CRC32)
+#define DUALSENSE_CRC32_ARMV8 1
+#include <arm_acle.h>
+#else
+#define DUALSENSE_CRC32_ARMV8 0
+#endif
+
+namespace
+{
+	using FUpdateFunction = uint32 (*)(uint32, const unsigned char*, size_t);
+
+	struct FSlicingTables
+	{
+		uint32 Table[8][256];
+
+		FSlicingTables()
+		{
+			for (uint32 Index = 0; Index < 256; ++Index)
+			{
+				Table[0][Index] = FPlayStationCrc32::UpdateByte(0, static_cast<uint8>(Index));
+			}
+			for (uint32 Index = 0; Index < 256; ++Index)
+			{
+				for (int32 Slice = 1; Slice < 8; ++Slice)
+				{
+					const uint32 Previous = Table[Slice - 1][Index];
+					Table[Slice][Index] = (Previous >> 8) ^ Table[0][Previous & 0xFF];
+				}
+			}
+		}
+	};
+
+	const FSlicingTables& GetSlicingTables()
+	{
+		static const FSlicingTables Tables;
+		return Tables;
+	}
+
+	uint32 LoadLittleEndian32(const unsigned char* Buffer)
+	{
+		return Buffer[0] | (Buffer[1] << 8) | (Buffer[2] << 16) | (static_cast<uint32>(Buffer[3]) << 24);
+	}
+
+#if DUALSENSE_CRC32_PCLMUL
+	bool HasPclmul()
+	{
+		uint32 Ecx = 0;
+#if defined(_MSC_VER)
+		int32 Info[4];
+		__cpuid(Info, 1);
+		Ecx = static_cast<uint32>(Info[2]);
+#else
+		uint32 Eax, Ebx, Edx;
+		if (!__get_cpuid(1, &Eax, &Ebx, &Ecx, &Edx))
+		{
+			return false;
+		}
+#endif
+		// PCLMULQDQ is bit 1 and SSE4.1, used to extract the result, bit 19.
+		return (Ecx & (1u << 1)) != 0 && (Ecx & (1u << 19)) != 0;
+	}
+
+	/**
+	 * Folds a buffer whose length is a multiple of 16 and at least 64 into a CRC state, using the
+	 * reflected-domain constants of Intel's "Fast CRC Computation for Generic Polynomials Using
+	 * PCLMULQDQ Instruction" for the 0xEDB88320 polynomial.
+	 */
+	DUALSENSE_CRC32_PCLMUL_TARGET
+	uint32 FoldPclmul(const uint32 State, const unsigned char* Buffer, size_t Len)
+	{
+		alignas(16) static const uint64 K1K2[2] = {0x0154442bd4, 0x01c6e41596};
+		alignas(16) static const uint64 K3K4[2] = {0x01751997d0, 0x00ccaa009e};
+		alignas(16) static const uint64 K5K0[2] = {0x0163cd6124, 0x0000000000};
+		alignas(16) static const uint64 Poly[2] = {0x01db710641, 0x01f7011641};
+
+		__m128i X0, X1, X2, X3, X4, X5;
+
+		X1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x00));
+		X2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x10));
+		X3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x20));
+		X4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x30));
+		X1 = _mm_xor_si128(X1, _mm_cvtsi32_si128(static_cast<int32>(State)));
+		X0 = _mm_load_si128(reinterpret_cast<const __m128i*>(K1K2));
+		Buffer += 64;
+		Len -= 64;
+
+		// Four lanes of 128 bits in parallel while whole blocks of 64 bytes remain.
+		while (Len >= 64)
+		{
+			const __m128i X6 = _mm_clmulepi64_si128(X2, X0, 0x00);
+			const __m128i X7 = _mm_clmulepi64_si128(X3, X0, 0x00);
+			const __m128i X8 = _mm_clmulepi64_si128(X4, X0, 0x00);
+			X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+
+			X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+			X2 = _mm_clmulepi64_si128(X2, X0, 0x11);
+			X3 = _mm_clmulepi64_si128(X3, X0, 0x11);
+			X4 = _mm_clmulepi64_si128(X4, X0, 0x11);
+
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, X5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x00)));
+			X2 = _mm_xor_si128(_mm_xor_si128(X2, X6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x10)));
+			X3 = _mm_xor_si128(_mm_xor_si128(X3, X7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x20)));
+			X4 = _mm_xor_si128(_mm_xor_si128(X4, X8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 0x30)));
+
+			Buffer += 64;
+			Len -= 64;
+		}
+
+		// Fold the four lanes into one.
+		X0 = _mm_load_si128(reinterpret_cast<const __m128i*>(K3K4));
+		const __m128i Lanes[3] = {X2, X3, X4};
+		for (const __m128i& Lane : Lanes)
+		{
+			X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+			X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, Lane), X5);
+		}
+
+		// Remaining blocks of 16 bytes.
+		while (Len >= 16)
+		{
+			X2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer));
+			X5 = _mm_clmulepi64_si128(X1, X0, 0x00);
+			X1 = _mm_clmulepi64_si128(X1, X0, 0x11);
+			X1 = _mm_xor_si128(_mm_xor_si128(X1, X2), X5);
+			Buffer += 16;
+			Len -= 16;
+		}
+
+		// 128 to 64 bits.
+		X2 = _mm_clmulepi64_si128(X1, X0, 0x10);
+		X3 = _mm_setr_epi32(~0, 0, ~0, 0);
+		X1 = _mm_srli_si128(X1, 8);
+		X1 = _mm_xor_si128(X1, X2);
+
+		X0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(K5K0));
+		X2 = _mm_srli_si128(X1, 4);
+		X1 = _mm_and_si128(X1, X3);
+		X1 = _mm_clmulepi64_si128(X1, X0, 0x00);
+		X1 = _mm_xor_si128(X1, X2);
+
+		// Barrett reduction to 32 bits.
+		X0 = _mm_load_si128(reinterpret_cast<const __m128i*>(Poly));
+		X2 = _mm_and_si128(X1, X3);
+		X2 = _mm_clmulepi64_si128(X2, X0, 0x10);
+		X2 = _mm_and_si128(X2, X3);
+		X2 = _mm_clmulepi64_si128(X2, X0, 0x00);
+		X1 = _mm_xor_si128(X1, X2);
+
+		return static_cast<uint32>(_mm_extract_epi32(X1, 1));
+	}
+
+	uint32 UpdatePclmul(uint32 State, const unsigned char* Buffer, size_t Len)
+	{
+		if (Len >= 64)
+		{
+			const size_t Folded = Len & ~static_cast<size_t>(15);
+			State = FoldPclmul(State, Buffer, Folded);
+			Buffer += Folded;
+			Len -= Folded;
+		}
+		return FPlayStationCrc32::UpdateSlicingBy8(State, Buffer, Len);
+	}
+#endif
+
+#if DUALSENSE_CRC32_ARMV8
+	uint32 UpdateArmv8(uint32 State, const unsigned char* Buffer, size_t Len)
+	{
+		while (Len >= 8)
+		{
+			uint64 Word;
+			FMemory::Memcpy(&Word, Buffer, sizeof(Word));
+			State = __crc32d(State, Word);
+			Buffer += 8;
+			Len -= 8;
+		}
+		while (Len-- > 0)
+		{
+			State = __crc32b(State, *Buffer++);
+		}
+		return State;
+	}
+#endif
+
+	/**
+	 * Compares an implementation with `FPlayStationOutputComposer::Compute` over every length up
+	 * to a few times the size of a report, so every tail and folding path is exercised.
+	 */
+	bool MatchesReference(const FUpdateFunction Function)
+	{
+		unsigned char Buffer[256];
+		uint32 Seed = 0x2545F491;
+		for (unsigned char& Byte : Buffer)
+		{
+			Seed = Seed * 1664525u + 1013904223u;
+			Byte = static_cast<unsigned char>(Seed >> 24);
+		}
+
+		for (size_t Len = 0; Len <= UE_ARRAY_COUNT(Buffer); ++Len)
+		{
+			const uint32 Expected = FPlayStationOutputComposer::Compute(Buffer, Len);
+			if (FPlayStationCrc32::Finalize(Function(FPlayStationCrc32::OutputSeedState, Buffer, Len)) != Expected)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct FSelection
+	{
+		FPlayStationCrc32::EImplementation Implementation;
+		FUpdateFunction Function;
+	};
+
+	FSelection SelectImplementation()
+	{
+		using EImplementation = FPlayStationCrc32::EImplementation;
+
+		TArray<FSelection, TInlineAllocator<3>> Candidates;
+#if DUALSENSE_CRC32_ARMV8
+		Candidates.Add({EImplementation::Armv8, &UpdateArmv8});
+#endif
+#if DUALSENSE_CRC32_PCLMUL
+		if (HasPclmul())
+		{
+			Candidates.Add({EImplementation::Pclmul, &UpdatePclmul});
+		}
+#endif
+		Candidates.Add({EImplementation::SlicingBy8, &FPlayStationCrc32::UpdateSlicingBy8});
+
+		for (const FSelection& Candidate : Candidates)
+		{
+			if (MatchesReference(Candidate.Function))
+			{
+				UE_LOG(LogTemp, Log, TEXT("PlayStationCrc32: using the %s implementation."),
+				       FPlayStationCrc32::GetImplementationName(Candidate.Implementation));
+				return Candidate;
+			}
+
+			UE_LOG(LogTemp, Warning, TEXT("PlayStationCrc32: the %s implementation does not match the reference, skipping it."),
+			       FPlayStationCrc32::GetImplementationName(Candidate.Implementation));
+		}
+		return {EImplementation::Table, &FPlayStationCrc32::UpdateTable};
+	}
+
+	const FSelection& GetSelection()
+	{
+		static const FSelection Selection = SelectImplementation();
+		return Selection;
+	}
+}
+
+uint32 FPlayStationCrc32::Update(const uint32 State, const unsigned char* Buffer, const size_t Len)
+{
+	return GetSelection().Function(State, Buffer, Len);
+}
+
+uint32 FPlayStationCrc32::UpdateTable(uint32 State, const unsigned char* Buffer, size_t Len)
+{
+	const uint32(&Table)[256] = GetSlicingTables().Table[0];
+	while (Len-- > 0)
+	{
+		State = Table[(State ^ *Buffer++) & 0xFF] ^ (State >> 8);
+	}
+	return State;
+}
+
+uint32 FPlayStationCrc32::UpdateSlicingBy8(uint32 State, const unsigned char* Buffer, size_t Len)
+{
+	const FSlicingTables& Tables = GetSlicingTables();
+	while (Len >= 8)
+	{
+		const uint32 One = LoadLittleEndian32(Buffer) ^ State;
+		const uint32 Two = LoadLittleEndian32(Buffer + 4);
+		State = Tables.Table[7][One & 0xFF] ^ Tables.Table[6][(One >> 8) & 0xFF] ^
+			Tables.Table[5][(One >> 16) & 0xFF] ^ Tables.Table[4][One >> 24] ^
+			Tables.Table[3][Two & 0xFF] ^ Tables.Table[2][(Two >> 8) & 0xFF] ^
+			Tables.Table[1][(Two >> 16) & 0xFF] ^ Tables.Table[0][Two >> 24];
+		Buffer += 8;
+		Len -= 8;
+	}
+	return UpdateTable(State, Buffer, Len);
+}
+
+uint32 FPlayStationCrc32::UpdateHardware(const uint32 State, const unsigned char* Buffer, const size_t Len)
+{
+#if DUALSENSE_CRC32_ARMV8
+	return UpdateArmv8(State, Buffer, Len);
+#else
+#if DUALSENSE_CRC32_PCLMUL
+	static const bool bHasPclmul = HasPclmul();
+	if (bHasPclmul)
+	{
+		return UpdatePclmul(State, Buffer, Len);
+	}
+#endif
+	return UpdateSlicingBy8(State, Buffer, Len);
+#endif
+}
+
+FPlayStationCrc32::EImplementation FPlayStationCrc32::GetImplementation()
+{
+	return GetSelection().Implementation;
+}
+
+const TCHAR* FPlayStationCrc32::GetImplementationName(const EImplementation Implementation)
+{
+	switch (Implementation)
+	{
+	case EImplementation::SlicingBy8:
+		return TEXT("slicing-by-8");
+	case EImplementation::Pclmul:
+		return TEXT("PCLMULQDQ");
+	case EImplementation::Armv8:
+		return TEXT("ARMv8 CRC32");
+	default:
+		return TEXT("table");
+	}
+}
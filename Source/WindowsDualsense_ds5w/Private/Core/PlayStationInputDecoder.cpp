@@ -0,0 +1,16 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/PlayStationInputDecoder.h"
+
+FPlayStationInputDecoder::FDecodeFunction FPlayStationInputDecoder::GetDecoder(const EDeviceType DeviceType,
+                                                                               const EDeviceConnection ConnectionType)
+{
+	const bool bBluetooth = ConnectionType == Bluetooth;
+	if (DeviceType == DualShock4)
+	{
+		return bBluetooth ? &Decode<FDualShockBluetoothReportLayout> : &Decode<FDualShockUsbReportLayout>;
+	}
+	return bBluetooth ? &Decode<FDualSenseBluetoothReportLayout> : &Decode<FDualSenseUsbReportLayout>;
+}
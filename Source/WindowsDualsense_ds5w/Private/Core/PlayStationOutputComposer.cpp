@@ -5,16 +5,33 @@
 
 #include "Core/PlayStationOutputComposer.h"
 #include "Core/HIDDeviceInfo.h"
+#include "Core/PlayStationCrc32.h"
+#include "Core/TriggerEffectCache.h"
 #include "Core/Structs/FDeviceContext.h"
 
-const UINT32 FPlayStationOutputComposer::CRCSeed = 0xeada2d49;
+const uint32 FPlayStationOutputComposer::CRCSeed = 0xeada2d49;
+
+namespace
+{
+	// CRC states after the constant header of each Bluetooth output report, so only the
+	// variable part of the report is hashed when composing it.
+	constexpr uint32 DualShockHeaderState = FPlayStationCrc32::UpdateByte(
+		FPlayStationCrc32::UpdateByte(
+			FPlayStationCrc32::UpdateByte(FPlayStationCrc32::UpdateByte(FPlayStationCrc32::OutputSeedState, 0x11), 0xc0),
+			0x20),
+		0x07);
+	constexpr size_t DualShockHeaderLength = 4;
+	constexpr uint32 DualSenseHeaderState = FPlayStationCrc32::UpdateByte(
+		FPlayStationCrc32::UpdateByte(FPlayStationCrc32::OutputSeedState, 0x31), 0x02);
+	constexpr size_t DualSenseHeaderLength = 2;
+}
 
 void FPlayStationOutputComposer::FreeContext(FDeviceContext* Context)
 {
 	FHIDDeviceInfo::InvalidateHandle(Context);
 }
 
-void FPlayStationOutputComposer::OutputDualShock(FDeviceContext* DeviceContext)
+void FPlayStationOutputComposer::ComposeDualShock(FDeviceContext* DeviceContext)
 {
 	const FOutputContext* HidOut = &DeviceContext->Output;
 
@@ -48,17 +65,16 @@ void FPlayStationOutputComposer::OutputDualShock(FDeviceContext* DeviceContext)
 
 	if (DeviceContext->ConnectionType == Bluetooth)
 	{
-		const UINT32 CrcChecksum = Compute(DeviceContext->BufferOutput, 74);
+		const uint32 CrcChecksum = FPlayStationCrc32::Finalize(FPlayStationCrc32::Update(
+			DualShockHeaderState, &DeviceContext->BufferOutput[DualShockHeaderLength], 74 - DualShockHeaderLength));
 		DeviceContext->BufferOutput[0x4A] = static_cast<unsigned char>((CrcChecksum & 0x000000FF) >> 0UL);
 		DeviceContext->BufferOutput[0x4B] = static_cast<unsigned char>((CrcChecksum & 0x0000FF00) >> 8UL);
 		DeviceContext->BufferOutput[0x4C] = static_cast<unsigned char>((CrcChecksum & 0x00FF0000) >> 16UL);
 		DeviceContext->BufferOutput[0x4D] = static_cast<unsigned char>((CrcChecksum & 0xFF000000) >> 24UL);
 	}
-
-	FHIDDeviceInfo::Write(DeviceContext);
 }
 
-void FPlayStationOutputComposer::OutputDualSense(FDeviceContext* DeviceContext)
+void FPlayStationOutputComposer::ComposeDualSense(FDeviceContext* DeviceContext)
 {
 	const size_t Padding = DeviceContext->ConnectionType == Bluetooth ? 2 : 1;
 	DeviceContext->BufferOutput[0] = DeviceContext->ConnectionType == Bluetooth ? 0x31 : 0x02;
@@ -95,18 +111,41 @@ void FPlayStationOutputComposer::OutputDualSense(FDeviceContext* DeviceContext)
 	SetTriggerEffects(&Output[21], HidOut->LeftTrigger);
 	if (DeviceContext->ConnectionType == Bluetooth)
 	{
-		const UINT32 CrcChecksum = Compute(DeviceContext->BufferOutput, 74);
+		const uint32 CrcChecksum = FPlayStationCrc32::Finalize(FPlayStationCrc32::Update(
+			DualSenseHeaderState, &DeviceContext->BufferOutput[DualSenseHeaderLength], 74 - DualSenseHeaderLength));
 		DeviceContext->BufferOutput[0x4A] = static_cast<unsigned char>((CrcChecksum & 0x000000FF) >> 0UL);
 		DeviceContext->BufferOutput[0x4B] = static_cast<unsigned char>((CrcChecksum & 0x0000FF00) >> 8UL);
 		DeviceContext->BufferOutput[0x4C] = static_cast<unsigned char>((CrcChecksum & 0x00FF0000) >> 16UL);
 		DeviceContext->BufferOutput[0x4D] = static_cast<unsigned char>((CrcChecksum & 0xFF000000) >> 24UL);
 	}
+}
+
+bool FPlayStationOutputComposer::HasSamePayload(const FDeviceContext& DeviceContext, const unsigned char* Previous)
+{
+	const unsigned char* Current = DeviceContext.BufferOutput;
+	const size_t Length = DeviceContext.ConnectionType == Bluetooth
+		                      ? 0x4A
+		                      : FHIDDeviceInfo::GetOutputReportLength(DeviceContext);
+	if (DeviceContext.DeviceType == DualShock4)
+	{
+		return FMemory::Memcmp(Current, Previous, Length) == 0;
+	}
 
-	FHIDDeviceInfo::Write(DeviceContext);
+	// Bits 0 and 2 of byte 38 are flipped by every ComposeDualSense.
+	const size_t Toggle = (DeviceContext.ConnectionType == Bluetooth ? 2 : 1) + 38;
+	return FMemory::Memcmp(Current, Previous, Toggle) == 0 &&
+		((Current[Toggle] ^ Previous[Toggle]) & ~0x05) == 0 &&
+		FMemory::Memcmp(Current + Toggle + 1, Previous + Toggle + 1, Length - Toggle - 1) == 0;
 }
 
 void FPlayStationOutputComposer::SetTriggerEffects(unsigned char* Trigger, FHapticTriggers& Effect)
 {
+	if (const FTriggerEffectData* Encoded = Effect.Encoded.Get())
+	{
+		FMemory::Memcpy(Trigger, Encoded->Bytes, FTriggerEffectBlob::Size);
+		return;
+	}
+
 	Trigger[0x0] = Effect.Mode;
 
 	if (Effect.Mode == 0x01) // Continuous Resistance
@@ -192,7 +231,7 @@ void FPlayStationOutputComposer::SetTriggerEffects(unsigned char* Trigger, FHapt
 	}
 }
 
-const UINT32 FPlayStationOutputComposer::HashTable[256] = {
+const uint32 FPlayStationOutputComposer::HashTable[256] = {
 	0xd202ef8d, 0xa505df1b, 0x3c0c8ea1, 0x4b0bbe37, 0xd56f2b94, 0xa2681b02, 0x3b614ab8, 0x4c667a2e,
 	0xdcd967bf, 0xabde5729, 0x32d70693, 0x45d03605, 0xdbb4a3a6, 0xacb39330, 0x35bac28a, 0x42bdf21c,
 	0xcfb5ffe9, 0xb8b2cf7f, 0x21bb9ec5, 0x56bcae53, 0xc8d83bf0, 0xbfdf0b66, 0x26d65adc, 0x51d16a4a,
@@ -227,9 +266,9 @@ const UINT32 FPlayStationOutputComposer::HashTable[256] = {
 	0x616495a3, 0x1663a535, 0x8f6af48f, 0xf86dc419, 0x660951ba, 0x110e612c, 0x88073096, 0xFF000000
 };
 
-UINT32 FPlayStationOutputComposer::Compute(const unsigned char* Buffer, const size_t Len)
+uint32 FPlayStationOutputComposer::Compute(const unsigned char* Buffer, const size_t Len)
 {
-	UINT32 Result = CRCSeed;
+	uint32 Result = CRCSeed;
 	for (size_t i = 0; i < Len; i++)
 	{
 		Result = HashTable[static_cast<unsigned char>(Result) ^ static_cast<unsigned char>(Buffer[i])] ^ (Result >> 8);
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/TouchGestureRecognizer.h"
+
+namespace
+{
+	/**
+	 * Key names indexed by `EGesture`, in the order of the bits of the pending mask.
+	 */
+	const FName* GetGestureKeyNames()
+	{
+		static const FName Names[FTouchGestureRecognizer::Count] = {
+			FName("PS_TouchTap"),
+			FName("PS_TouchDoubleTap"),
+			FName("PS_TouchSwipeLeft"),
+			FName("PS_TouchSwipeRight"),
+			FName("PS_TouchSwipeUp"),
+			FName("PS_TouchSwipeDown"),
+		};
+		return Names;
+	}
+}
+
+FTouchGestureRecognizer::FTouchGestureRecognizer()
+{
+	Reset();
+}
+
+void FTouchGestureRecognizer::Reset()
+{
+	Head = 0;
+	NumSamples = 0;
+	LastSampleSeconds = 0.0;
+	FMemory::Memzero(Contacts);
+	SessionFingers = 0;
+	bSessionMoved = false;
+	bHasLastTap = false;
+	LastTapSeconds = 0.0;
+	LastTapPosition = FVector2f::ZeroVector;
+	TwoFingerMode = ETwoFingerMode::None;
+	StartSpread = 0.0f;
+	LastSpread = 0.0f;
+	StartMidpoint = FVector2f::ZeroVector;
+	LastMidpoint = FVector2f::ZeroVector;
+	PendingGestures = 0;
+	PendingPinch = 0.0f;
+	PendingScroll = FVector2f::ZeroVector;
+	bPinchDispatched = false;
+	bScrollDispatched = false;
+}
+
+void FTouchGestureRecognizer::AddSample(const FGamepadTouchState (&Touch)[2], const double Seconds)
+{
+	if (Seconds <= LastSampleSeconds)
+	{
+		return;
+	}
+	LastSampleSeconds = Seconds;
+
+	FTouchSample& Sample = History[Head];
+	Head = (Head + 1) % HistoryCapacity;
+	NumSamples = FMath::Min(NumSamples + 1, HistoryCapacity);
+	Sample.Seconds = Seconds;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		Sample.Position[Index] = FVector2f(Touch[Index].X, Touch[Index].Y) / PadWidth;
+		Sample.Id[Index] = Touch[Index].Id;
+		Sample.bDown[Index] = Touch[Index].bDown;
+	}
+
+	// Lifts first: a new id in the same slot means the finger lifted and another one landed
+	// between two reports.
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FContact& Contact = Contacts[Index];
+		if (!Contact.bDown || (Sample.bDown[Index] && Sample.Id[Index] == Contact.Id))
+		{
+			continue;
+		}
+
+		Contact.bDown = false;
+		if (!Contacts[0].bDown && !Contacts[1].bDown)
+		{
+			if (SessionFingers == 1)
+			{
+				EndSingleFinger(Contact, Seconds);
+			}
+			SessionFingers = 0;
+			bSessionMoved = false;
+		}
+	}
+
+	int32 NumDown = 0;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FContact& Contact = Contacts[Index];
+		if (!Sample.bDown[Index])
+		{
+			continue;
+		}
+
+		if (!Contact.bDown)
+		{
+			Contact.bDown = true;
+			Contact.Id = Sample.Id[Index];
+			Contact.Start = Sample.Position[Index];
+			Contact.StartSeconds = Seconds;
+		}
+		Contact.Last = Sample.Position[Index];
+		bSessionMoved |= FVector2f::Distance(Contact.Start, Contact.Last) > Settings.TapMaxDistance;
+		++NumDown;
+	}
+	SessionFingers = FMath::Max(SessionFingers, NumDown);
+
+	UpdateTwoFingers();
+}
+
+void FTouchGestureRecognizer::EndSingleFinger(const FContact& Contact, const double Seconds)
+{
+	if (!bSessionMoved && Seconds - Contact.StartSeconds <= Settings.TapMaxSeconds)
+	{
+		PendingGestures |= 1u << Tap;
+		if (bHasLastTap && Seconds - LastTapSeconds <= Settings.DoubleTapMaxSeconds &&
+			FVector2f::Distance(LastTapPosition, Contact.Last) <= Settings.DoubleTapMaxDistance)
+		{
+			// A third tap starts a new pair rather than forming a second double tap.
+			PendingGestures |= 1u << DoubleTap;
+			bHasLastTap = false;
+		}
+		else
+		{
+			bHasLastTap = true;
+			LastTapSeconds = Seconds;
+			LastTapPosition = Contact.Last;
+		}
+		return;
+	}
+
+	// Travel over the swipe window, from the oldest sample of this contact still inside it.
+	const int32 Slot = &Contact == &Contacts[0] ? 0 : 1;
+	const double WindowStart = FMath::Max(Seconds - Settings.SwipeMaxSeconds, Contact.StartSeconds);
+	FVector2f Origin = Contact.Last;
+	for (int32 Age = 0; Age < NumSamples; ++Age)
+	{
+		const FTouchSample& Sample = History[(Head - 1 - Age + HistoryCapacity) % HistoryCapacity];
+		if (Sample.Seconds < WindowStart)
+		{
+			break;
+		}
+		if (Sample.bDown[Slot] && Sample.Id[Slot] == Contact.Id)
+		{
+			Origin = Sample.Position[Slot];
+		}
+	}
+
+	const FVector2f Travel = Contact.Last - Origin;
+	if (Travel.Size() < Settings.SwipeMinDistance)
+	{
+		return;
+	}
+
+	// Touchpad Y grows towards the player.
+	if (FMath::Abs(Travel.X) >= FMath::Abs(Travel.Y))
+	{
+		PendingGestures |= 1u << (Travel.X < 0.0f ? SwipeLeft : SwipeRight);
+	}
+	else
+	{
+		PendingGestures |= 1u << (Travel.Y < 0.0f ? SwipeUp : SwipeDown);
+	}
+}
+
+void FTouchGestureRecognizer::UpdateTwoFingers()
+{
+	if (!Contacts[0].bDown || !Contacts[1].bDown)
+	{
+		TwoFingerMode = ETwoFingerMode::None;
+		return;
+	}
+
+	const float Spread = FVector2f::Distance(Contacts[0].Last, Contacts[1].Last);
+	const FVector2f Midpoint = (Contacts[0].Last + Contacts[1].Last) * 0.5f;
+	if (TwoFingerMode == ETwoFingerMode::None)
+	{
+		TwoFingerMode = ETwoFingerMode::Undecided;
+		StartSpread = LastSpread = Spread;
+		StartMidpoint = LastMidpoint = Midpoint;
+		return;
+	}
+
+	if (TwoFingerMode == ETwoFingerMode::Undecided)
+	{
+		// Whichever threshold is crossed first decides, and the motion so far is then reported.
+		const float SpreadChange = FMath::Abs(Spread - StartSpread);
+		const float MidpointTravel = FVector2f::Distance(Midpoint, StartMidpoint);
+		if (SpreadChange >= Settings.PinchMinDistance && SpreadChange >= MidpointTravel)
+		{
+			TwoFingerMode = ETwoFingerMode::Pinch;
+		}
+		else if (MidpointTravel >= Settings.ScrollMinDistance)
+		{
+			TwoFingerMode = ETwoFingerMode::Scroll;
+		}
+		else
+		{
+			return;
+		}
+	}
+
+	if (TwoFingerMode == ETwoFingerMode::Pinch)
+	{
+		PendingPinch += Spread - LastSpread;
+	}
+	else
+	{
+		PendingScroll += Midpoint - LastMidpoint;
+	}
+	LastSpread = Spread;
+	LastMidpoint = Midpoint;
+}
+
+void FTouchGestureRecognizer::Dispatch(FGenericApplicationMessageHandler& MessageHandler, const FPlatformUserId UserId,
+                                       const FInputDeviceId InputDeviceId)
+{
+	const FName* Names = GetGestureKeyNames();
+	while (PendingGestures != 0)
+	{
+		const uint32 Gesture = FMath::CountTrailingZeros(PendingGestures);
+		PendingGestures &= PendingGestures - 1;
+		MessageHandler.OnControllerButtonPressed(Names[Gesture], UserId, InputDeviceId, false);
+		MessageHandler.OnControllerButtonReleased(Names[Gesture], UserId, InputDeviceId, false);
+	}
+
+	static const FName PinchName("PS_TouchPinch");
+	static const FName ScrollXName("PS_TouchScrollX");
+	static const FName ScrollYName("PS_TouchScrollY");
+
+	if (PendingPinch != 0.0f || bPinchDispatched)
+	{
+		MessageHandler.OnControllerAnalog(PinchName, UserId, InputDeviceId, PendingPinch);
+		bPinchDispatched = PendingPinch != 0.0f;
+	}
+
+	if (!PendingScroll.IsZero() || bScrollDispatched)
+	{
+		// Positive Y scrolls up, like the analog sticks.
+		MessageHandler.OnControllerAnalog(ScrollXName, UserId, InputDeviceId, PendingScroll.X);
+		MessageHandler.OnControllerAnalog(ScrollYName, UserId, InputDeviceId, -PendingScroll.Y);
+		bScrollDispatched = !PendingScroll.IsZero();
+	}
+
+	PendingPinch = 0.0f;
+	PendingScroll = FVector2f::ZeroVector;
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Transport/HidrawPollReader.h"
+
+#if PLATFORM_LINUX
+
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "Core/Transport/LinuxHidrawTransport.h"
+
+FHidrawPollReader::FHidrawPollReader():
+	Generation(0),
+	Thread(nullptr),
+	WakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+	bStopRequested(false)
+{
+}
+
+FHidrawPollReader::~FHidrawPollReader()
+{
+	Stop();
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WakeFd >= 0)
+	{
+		close(WakeFd);
+		WakeFd = -1;
+	}
+}
+
+bool FHidrawPollReader::StartThread()
+{
+	if (WakeFd < 0)
+	{
+		return false;
+	}
+
+	Thread = FRunnableThread::Create(this, TEXT("FHidrawPollReader"), 0, TPri_AboveNormal);
+	return Thread != nullptr;
+}
+
+uint32 FHidrawPollReader::Run()
+{
+	TArray<pollfd> Descriptors;
+	uint64 PolledGeneration = 0;
+	bool bHasDescriptors = false;
+	TArray<int32> Lost;
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		int TimeoutMs = -1;
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (!bHasDescriptors || PolledGeneration != Generation)
+			{
+				Descriptors.Reset(Streams.Num() + 1);
+				Descriptors.Add({WakeFd, POLLIN, 0});
+				for (const FStream& Stream : Streams)
+				{
+					Descriptors.Add({Stream.Fd, POLLIN, 0});
+				}
+				PolledGeneration = Generation;
+				bHasDescriptors = true;
+			}
+
+			// Descriptors backing off after a failed read are only watched for a hang-up, and the
+			// poll wakes up when the first of them may be read again.
+			const double NowSeconds = FPlatformTime::Seconds();
+			for (int32 Index = 1; Index < Descriptors.Num(); ++Index)
+			{
+				const double RemainingSeconds = Streams[Index - 1].RetrySeconds - NowSeconds;
+				Descriptors[Index].events = RemainingSeconds > 0.0 ? 0 : POLLIN;
+				if (RemainingSeconds > 0.0)
+				{
+					const int RemainingMs = FMath::CeilToInt(RemainingSeconds * 1000.0);
+					TimeoutMs = TimeoutMs < 0 ? RemainingMs : FMath::Min(TimeoutMs, RemainingMs);
+				}
+			}
+		}
+
+		for (pollfd& Descriptor : Descriptors)
+		{
+			Descriptor.revents = 0;
+		}
+		if (poll(Descriptors.GetData(), Descriptors.Num(), TimeoutMs) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to poll the hidraw devices. Error Code: %d"), errno);
+			return 1;
+		}
+
+		if (Descriptors[0].revents & POLLIN)
+		{
+			uint64 Signals = 0;
+			const ssize_t Drained = read(WakeFd, &Signals, sizeof(Signals));
+			(void)Drained;
+		}
+
+		FScopeLock ScopeLock(&Lock);
+		if (PolledGeneration != Generation)
+		{
+			// The set changed while polling; poll the new one before delivering anything.
+			continue;
+		}
+
+		for (int32 Index = 1; Index < Descriptors.Num(); ++Index)
+		{
+			const short Events = Descriptors[Index].revents;
+			if (Events == 0)
+			{
+				continue;
+			}
+
+			// Reports buffered before a hang-up are still delivered.
+			FStream& Stream = Streams[Index - 1];
+			if (!Drain(Stream) || (Events & (POLLERR | POLLHUP | POLLNVAL)))
+			{
+				Lost.Add(Index - 1);
+			}
+		}
+
+		for (int32 Index = Lost.Num() - 1; Index >= 0; --Index)
+		{
+			UE_LOG(LogTemp, Log, TEXT("HIDReader: device is no longer connected. Removing it from the shared reader"));
+			IHidReportSink* Sink = Streams[Lost[Index]].Sink;
+			Streams.RemoveAt(Lost[Index]);
+			++Generation;
+			Sink->OnDisconnected();
+		}
+		Lost.Reset();
+	}
+
+	return 0;
+}
+
+bool FHidrawPollReader::Drain(FStream& Stream)
+{
+	for (;;)
+	{
+		size_t Length = 0;
+		unsigned char* Buffer = Stream.Sink->GetReportBuffer(Length);
+		const ssize_t BytesRead = read(Stream.Fd, Buffer, Length);
+		if (BytesRead > 0)
+		{
+			Stream.TransientErrors = 0;
+			Stream.Sink->OnReport(static_cast<size_t>(BytesRead));
+			continue;
+		}
+
+		if (BytesRead == 0)
+		{
+			return false;
+		}
+		if (errno == EINTR)
+		{
+			continue;
+		}
+		if (errno == EAGAIN)
+		{
+			Stream.TransientErrors = 0;
+			return true;
+		}
+		if (FLinuxHidrawTransport::ShouldTreatAsDisconnected(errno))
+		{
+			return false;
+		}
+		Stream.RetrySeconds = FPlatformTime::Seconds() + IHidTransport::TransientErrorBackoffSeconds;
+		if (++Stream.TransientErrors >= IHidTransport::MaxTransientErrors)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HIDReader: %u consecutive read errors on a hidraw device. Error Code: %d"),
+			       Stream.TransientErrors, errno);
+			return false;
+		}
+		return true;
+	}
+}
+
+void FHidrawPollReader::Stop()
+{
+	bStopRequested.store(true, std::memory_order_relaxed);
+	Wake();
+}
+
+void FHidrawPollReader::Wake() const
+{
+	if (WakeFd >= 0)
+	{
+		const uint64 Signal = 1;
+		const ssize_t Written = write(WakeFd, &Signal, sizeof(Signal));
+		(void)Written;
+	}
+}
+
+void FHidrawPollReader::Add(const int Fd, IHidReportSink& Sink)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		FStream& Stream = Streams.AddDefaulted_GetRef();
+		Stream.Fd = Fd;
+		Stream.Sink = &Sink;
+		++Generation;
+	}
+
+	Wake();
+}
+
+void FHidrawPollReader::Remove(const int Fd)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		const int32 Index = Streams.IndexOfByPredicate([Fd](const FStream& Stream)
+		{
+			return Stream.Fd == Fd;
+		});
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+
+		Streams.RemoveAt(Index);
+		++Generation;
+	}
+
+	Wake();
+}
+
+int32 FHidrawPollReader::GetNumStreams() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Streams.Num();
+}
+
+#endif
@@ -0,0 +1,589 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Transport/LinuxHidrawTransport.h"
+
+#if PLATFORM_LINUX
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/hidraw.h>
+#include "HAL/RunnableThread.h"
+
+namespace
+{
+	/**
+	 * Bus type reported in `HID_ID` for devices connected over Bluetooth.
+	 */
+	constexpr uint32 BusBluetooth = 0x0005;
+
+	/**
+	 * Handle returned by `Open`.
+	 */
+	struct FHidrawHandle
+	{
+		int Fd = -1;
+	};
+
+	/**
+	 * Read stream returned by `OpenReader`.
+	 */
+	struct FHidrawReadStream
+	{
+		int Fd = -1;
+		int WakeFd = -1;
+	};
+
+	int OpenDevice(const FDeviceContext& Context)
+	{
+		return open(TCHAR_TO_UTF8(Context.Path), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	}
+
+	/**
+	 * Reads the `HID_ID` entry of a hidraw node's uevent file.
+	 */
+	bool ReadHidId(const char* NodeName, uint32& OutBus, uint32& OutVendor, uint32& OutProduct)
+	{
+		char UeventPath[300];
+		snprintf(UeventPath, sizeof(UeventPath), "/sys/class/hidraw/%s/device/uevent", NodeName);
+
+		FILE* Uevent = fopen(UeventPath, "r");
+		if (!Uevent)
+		{
+			return false;
+		}
+
+		bool bFound = false;
+		char Line[256];
+		while (fgets(Line, sizeof(Line), Uevent))
+		{
+			unsigned int Bus = 0, Vendor = 0, Product = 0;
+			if (sscanf(Line, "HID_ID=%x:%x:%x", &Bus, &Vendor, &Product) == 3)
+			{
+				OutBus = Bus;
+				OutVendor = Vendor;
+				OutProduct = Product;
+				bFound = true;
+				break;
+			}
+		}
+		fclose(Uevent);
+		return bFound;
+	}
+
+	/**
+	 * Reads the name of the HID device a hidraw node is bound to, from its sysfs `device` link.
+	 */
+	FString ReadHidDeviceName(const char* NodeName)
+	{
+		char LinkPath[300];
+		snprintf(LinkPath, sizeof(LinkPath), "/sys/class/hidraw/%s/device", NodeName);
+
+		char Target[512];
+		const ssize_t Length = readlink(LinkPath, Target, sizeof(Target) - 1);
+		if (Length <= 0)
+		{
+			return FString();
+		}
+
+		Target[Length] = 0;
+		const char* Name = strrchr(Target, '/');
+		return UTF8_TO_TCHAR(Name ? Name + 1 : Target);
+	}
+
+	/**
+	 * Watches `/dev` with inotify and reports every hidraw node created or deleted.
+	 */
+	class FHidrawHotplugWatcher final : public FRunnable
+	{
+	public:
+		explicit FHidrawHotplugWatcher(TFunction<void()> InCallback):
+			Callback(MoveTemp(InCallback)),
+			Thread(nullptr)
+		{
+			InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (InotifyFd >= 0 && inotify_add_watch(InotifyFd, "/dev", IN_CREATE | IN_DELETE | IN_ATTRIB) < 0)
+			{
+				close(InotifyFd);
+				InotifyFd = -1;
+			}
+		}
+
+		virtual ~FHidrawHotplugWatcher() override
+		{
+			Stop();
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+				Thread = nullptr;
+			}
+
+			if (InotifyFd >= 0)
+			{
+				close(InotifyFd);
+			}
+			if (WakeFd >= 0)
+			{
+				close(WakeFd);
+			}
+		}
+
+		bool StartThread()
+		{
+			if (InotifyFd < 0 || WakeFd < 0)
+			{
+				return false;
+			}
+
+			Thread = FRunnableThread::Create(this, TEXT("FHidrawHotplugWatcher"), 0, TPri_BelowNormal);
+			return Thread != nullptr;
+		}
+
+		virtual uint32 Run() override
+		{
+			pollfd Descriptors[2] = {
+				{InotifyFd, POLLIN, 0},
+				{WakeFd, POLLIN, 0}
+			};
+
+			alignas(inotify_event) char Events[4096];
+			for (;;)
+			{
+				Descriptors[0].revents = 0;
+				Descriptors[1].revents = 0;
+				if (poll(Descriptors, 2, -1) < 0 && errno != EINTR)
+				{
+					return 1;
+				}
+
+				if (Descriptors[1].revents & POLLIN)
+				{
+					return 0;
+				}
+
+				bool bHidrawChanged = false;
+				ssize_t Length;
+				while ((Length = read(InotifyFd, Events, sizeof(Events))) > 0)
+				{
+					for (ssize_t Offset = 0; Offset < Length;)
+					{
+						const inotify_event* Event = reinterpret_cast<const inotify_event*>(&Events[Offset]);
+						if (Event->len > 0 && strncmp(Event->name, "hidraw", 6) == 0)
+						{
+							bHidrawChanged = true;
+						}
+						Offset += sizeof(inotify_event) + Event->len;
+					}
+				}
+
+				if (bHidrawChanged)
+				{
+					Callback();
+				}
+			}
+		}
+
+		virtual void Stop() override
+		{
+			if (WakeFd >= 0)
+			{
+				const uint64 Signal = 1;
+				const ssize_t Written = write(WakeFd, &Signal, sizeof(Signal));
+				(void)Written;
+			}
+		}
+
+	private:
+		TFunction<void()> Callback;
+		FRunnableThread* Thread;
+		int InotifyFd;
+		int WakeFd;
+	};
+}
+
+FLinuxHidrawTransport::~FLinuxHidrawTransport()
+{
+	StopDeviceNotifications();
+}
+
+bool FLinuxHidrawTransport::StartDeviceNotifications(TFunction<void()> OnDevicesChanged)
+{
+	StopDeviceNotifications();
+
+	TUniquePtr<FHidrawHotplugWatcher> Watcher = MakeUnique<FHidrawHotplugWatcher>(MoveTemp(OnDevicesChanged));
+	if (!Watcher->StartThread())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to watch /dev for hidraw nodes. Falling back to polling."));
+		return false;
+	}
+
+	HotplugWatcher = MoveTemp(Watcher);
+	return true;
+}
+
+void FLinuxHidrawTransport::StopDeviceNotifications()
+{
+	HotplugWatcher.Reset();
+}
+
+bool FLinuxHidrawTransport::ShouldTreatAsDisconnected(const int32 Error)
+{
+	switch (Error)
+	{
+	case ENODEV:
+	case ENXIO:
+	case EIO:
+	case EBADF:
+	case ENOENT:
+	case EPIPE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FLinuxHidrawTransport::ProbeDevice(const char* NodeName, FEnumerationCacheEntry& OutEntry)
+{
+	const FString HidDevice = OutEntry.HidDevice;
+	OutEntry = FEnumerationCacheEntry();
+	OutEntry.HidDevice = HidDevice;
+
+	uint32 Bus = 0, Vendor = 0, Product = 0;
+	if (!ReadHidId(NodeName, Bus, Vendor, Product))
+	{
+		return false;
+	}
+
+	OutEntry.VendorId = static_cast<uint16>(Vendor);
+	OutEntry.ProductId = static_cast<uint16>(Product);
+	if (
+		Vendor != 0x054C ||
+		(
+			Product != 0x0CE6 &&
+			Product != 0x0DF2 &&
+			Product != 0x05C4 &&
+			Product != 0x09CC
+		)
+	)
+	{
+		return true;
+	}
+
+	switch (Product)
+	{
+		case 0x05C4:
+		case 0x09CC:
+			OutEntry.DeviceType = DualShock4;
+			break;
+		case 0x0DF2:
+			OutEntry.DeviceType = DualSenseEdge;
+			break;
+		default: OutEntry.DeviceType = DualSense;
+	}
+	OutEntry.ConnectionType = Bus == BusBluetooth ? Bluetooth : Usb;
+
+	FDeviceContext Context = {};
+	const FString DevicePath = FString::Printf(TEXT("/dev/%s"), UTF8_TO_TCHAR(NodeName));
+	FCString::Strncpy(Context.Path, *DevicePath, UE_ARRAY_COUNT(Context.Path));
+
+	// udev may not have granted access to a freshly created node yet, so a failure here is retried.
+	const int Fd = OpenDevice(Context);
+	if (Fd < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to open %s. Error Code: %d"), *DevicePath, errno);
+		return false;
+	}
+	close(Fd);
+
+	OutEntry.bRejected = false;
+	return true;
+}
+
+void FLinuxHidrawTransport::Detect(TArray<FDeviceContext>& Devices)
+{
+	DIR* HidrawDir = opendir("/sys/class/hidraw");
+	if (!HidrawDir)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open /sys/class/hidraw. Error Code: %d"), errno);
+		return;
+	}
+
+	FScopeLock Lock(&EnumerationCacheLock);
+	TSet<FString> PresentNodes;
+	while (const dirent* Entry = readdir(HidrawDir))
+	{
+		if (strncmp(Entry->d_name, "hidraw", 6) != 0)
+		{
+			continue;
+		}
+
+		const FString NodeName = UTF8_TO_TCHAR(Entry->d_name);
+		PresentNodes.Add(NodeName);
+
+		const FString HidDevice = ReadHidDeviceName(Entry->d_name);
+		const FEnumerationCacheEntry* Cached = EnumerationCache.Find(NodeName);
+		if (!Cached || Cached->HidDevice.IsEmpty() || Cached->HidDevice != HidDevice)
+		{
+			FEnumerationCacheEntry Probed;
+			Probed.HidDevice = HidDevice;
+			if (!ProbeDevice(Entry->d_name, Probed))
+			{
+				EnumerationCache.Remove(NodeName);
+				continue;
+			}
+			Cached = &EnumerationCache.Add(NodeName, Probed);
+		}
+
+		if (Cached->bRejected)
+		{
+			continue;
+		}
+
+		FDeviceContext Context = {};
+		const FString DevicePath = FString::Printf(TEXT("/dev/%s"), *NodeName);
+		FCString::Strncpy(Context.Path, *DevicePath, UE_ARRAY_COUNT(Context.Path));
+		Context.DeviceType = Cached->DeviceType;
+		Context.ConnectionType = Cached->ConnectionType;
+		Context.IsConnected = true;
+		Context.Handle = InvalidHandle();
+		Devices.Add(Context);
+	}
+
+	closedir(HidrawDir);
+
+	for (auto It = EnumerationCache.CreateIterator(); It; ++It)
+	{
+		if (!PresentNodes.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void* FLinuxHidrawTransport::Open(const FDeviceContext& Context)
+{
+	const int Fd = OpenDevice(Context);
+	if (Fd < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open device handle for the DualSense. Error Code: %d"), errno);
+		return InvalidHandle();
+	}
+
+	if (Context.ConnectionType == Bluetooth)
+	{
+		// Same request the Windows backend issues on every open: switches the controller to
+		// full reports, which a controller re-bound under the same node name starts without.
+		unsigned char FeatureBuffer[78] = {};
+		FeatureBuffer[0] = 0x05;
+		if (ioctl(Fd, HIDIOCGFEATURE(sizeof(FeatureBuffer)), FeatureBuffer) < 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to HIDIOCGFEATURE."));
+		}
+	}
+
+	FHidrawHandle* Handle = new FHidrawHandle();
+	Handle->Fd = Fd;
+	return Handle;
+}
+
+void FLinuxHidrawTransport::Close(void* Handle)
+{
+	if (!Handle || Handle == InvalidHandle())
+	{
+		return;
+	}
+
+	const FHidrawHandle* Hidraw = static_cast<FHidrawHandle*>(Handle);
+	close(Hidraw->Fd);
+	delete Hidraw;
+}
+
+bool FLinuxHidrawTransport::Write(void* Handle, const unsigned char* Buffer, const size_t Length)
+{
+	if (!Handle || Handle == InvalidHandle())
+	{
+		return false;
+	}
+
+	ssize_t BytesWritten;
+	do
+	{
+		BytesWritten = write(static_cast<FHidrawHandle*>(Handle)->Fd, Buffer, Length);
+	} while (BytesWritten < 0 && errno == EINTR);
+
+	if (BytesWritten != static_cast<ssize_t>(Length))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write output data to device. report %llu error Code: %d"),
+			static_cast<uint64>(Length), errno);
+		return false;
+	}
+	return true;
+}
+
+EPollResult FLinuxHidrawTransport::Ping(void* Handle)
+{
+	if (!Handle || Handle == InvalidHandle())
+	{
+		return EPollResult::Disconnected;
+	}
+
+	pollfd Descriptor = {static_cast<FHidrawHandle*>(Handle)->Fd, POLLIN, 0};
+	if (poll(&Descriptor, 1, 0) < 0)
+	{
+		return errno == EINTR ? EPollResult::TransientError : EPollResult::Disconnected;
+	}
+
+	// hidraw reports a hang-up as soon as the underlying device is removed.
+	if (Descriptor.revents & (POLLERR | POLLHUP | POLLNVAL))
+	{
+		return EPollResult::Disconnected;
+	}
+	return EPollResult::ReadOk;
+}
+
+void* FLinuxHidrawTransport::OpenReader(const FDeviceContext& Context)
+{
+	const int Fd = OpenDevice(Context);
+	if (Fd < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open read stream. Error Code: %d"), errno);
+		return nullptr;
+	}
+
+	const int WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (WakeFd < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to create the read stream wake event. Error Code: %d"), errno);
+		close(Fd);
+		return nullptr;
+	}
+
+	FHidrawReadStream* Stream = new FHidrawReadStream();
+	Stream->Fd = Fd;
+	Stream->WakeFd = WakeFd;
+	return Stream;
+}
+
+EPollResult FLinuxHidrawTransport::ReadReport(void* Reader, unsigned char* Buffer, const size_t Length,
+                                              size_t& OutBytesRead)
+{
+	OutBytesRead = 0;
+	const FHidrawReadStream* Stream = static_cast<FHidrawReadStream*>(Reader);
+	if (!Stream)
+	{
+		return EPollResult::Disconnected;
+	}
+
+	pollfd Descriptors[2] = {
+		{Stream->Fd, POLLIN, 0},
+		{Stream->WakeFd, POLLIN, 0}
+	};
+
+	for (;;)
+	{
+		const ssize_t BytesRead = read(Stream->Fd, Buffer, Length);
+		if (BytesRead >= 0)
+		{
+			OutBytesRead = static_cast<size_t>(BytesRead);
+			return EPollResult::ReadOk;
+		}
+
+		if (errno != EAGAIN && errno != EINTR)
+		{
+			return ShouldTreatAsDisconnected(errno) ? EPollResult::Disconnected : EPollResult::TransientError;
+		}
+
+		Descriptors[0].revents = 0;
+		Descriptors[1].revents = 0;
+		if (poll(Descriptors, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return EPollResult::TransientError;
+		}
+
+		// The wake event is never drained, so every read after a cancellation returns immediately.
+		if (Descriptors[1].revents & POLLIN)
+		{
+			return EPollResult::NoIoThisTick;
+		}
+
+		if (Descriptors[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+		{
+			return EPollResult::Disconnected;
+		}
+	}
+}
+
+void FLinuxHidrawTransport::CancelRead(void* Reader)
+{
+	const FHidrawReadStream* Stream = static_cast<FHidrawReadStream*>(Reader);
+	if (Stream)
+	{
+		const uint64 Signal = 1;
+		const ssize_t Written = write(Stream->WakeFd, &Signal, sizeof(Signal));
+		(void)Written;
+	}
+}
+
+bool FLinuxHidrawTransport::AttachReader(void* Reader, IHidReportSink& Sink)
+{
+	const FHidrawReadStream* Stream = static_cast<FHidrawReadStream*>(Reader);
+	if (!Stream)
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&PollReaderLock);
+	if (!PollReader)
+	{
+		TUniquePtr<FHidrawPollReader> NewReader = MakeUnique<FHidrawPollReader>();
+		if (!NewReader->StartThread())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to start the shared hidraw reader. Falling back to one reader thread per device."));
+			return false;
+		}
+		PollReader = MoveTemp(NewReader);
+	}
+
+	PollReader->Add(Stream->Fd, Sink);
+	return true;
+}
+
+void FLinuxHidrawTransport::DetachReader(void* Reader)
+{
+	const FHidrawReadStream* Stream = static_cast<FHidrawReadStream*>(Reader);
+	FScopeLock Lock(&PollReaderLock);
+	if (Stream && PollReader)
+	{
+		PollReader->Remove(Stream->Fd);
+	}
+}
+
+void FLinuxHidrawTransport::CloseReader(void* Reader)
+{
+	const FHidrawReadStream* Stream = static_cast<FHidrawReadStream*>(Reader);
+	if (!Stream)
+	{
+		return;
+	}
+
+	close(Stream->Fd);
+	close(Stream->WakeFd);
+	delete Stream;
+}
+
+#endif
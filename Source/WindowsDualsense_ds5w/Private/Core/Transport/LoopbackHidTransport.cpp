@@ -0,0 +1,370 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Transport/LoopbackHidTransport.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Core/PlayStationCrc32.h"
+
+namespace
+{
+	/**
+	 * Returns the offset of the payload after the report id and Bluetooth header bytes.
+	 */
+	size_t PayloadOffset(const EDeviceType DeviceType, const EDeviceConnection ConnectionType)
+	{
+		if (ConnectionType != Bluetooth)
+		{
+			return 1;
+		}
+		return DeviceType == DualShock4 ? 3 : 2;
+	}
+
+	/**
+	 * Length of the part of a full Bluetooth input report covered by the CRC that follows it.
+	 */
+	constexpr size_t CrcCoveredLength = 74;
+
+	/**
+	 * Returns the length of an input report for the given device and connection.
+	 */
+	size_t ReportLength(const EDeviceType DeviceType, const EDeviceConnection ConnectionType)
+	{
+		if (ConnectionType != Bluetooth)
+		{
+			return 64;
+		}
+		return DeviceType == DualShock4 ? 547 : 78;
+	}
+}
+
+struct FLoopbackHidTransport::FDeviceHandle
+{
+	TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device;
+};
+
+struct FLoopbackHidTransport::FReadStream
+{
+	TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device;
+	FEvent* CancelEvent = nullptr;
+	std::atomic_bool bCancelled{false};
+	double NextReportTime = 0.0;
+};
+
+FString FLoopbackHidTransport::AddDevice(const EDeviceType DeviceType, const EDeviceConnection ConnectionType,
+                                         const float ReportRateHz)
+{
+	TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = MakeShared<FVirtualDevice, ESPMode::ThreadSafe>();
+	Device->DeviceType = DeviceType;
+	Device->ConnectionType = ConnectionType;
+	Device->ReportInterval = ReportRateHz > 0.0f ? 1.0 / ReportRateHz : 0.0;
+
+	FScopeLock Lock(&DevicesLock);
+	Device->Path = FString::Printf(TEXT("loopback://%s/%s/%d"),
+	                               DeviceType == DualShock4 ? TEXT("dualshock4") : TEXT("dualsense"),
+	                               ConnectionType == Bluetooth ? TEXT("bt") : TEXT("usb"),
+	                               Devices.Num());
+	Devices.Add(Device);
+	NotifyDevicesChanged();
+	return Device->Path;
+}
+
+void FLoopbackHidTransport::SetDeviceConnected(const FString& Path, const bool bConnected)
+{
+	if (const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(Path))
+	{
+		if (Device->bConnected.exchange(bConnected, std::memory_order_acq_rel) != bConnected)
+		{
+			FScopeLock Lock(&DevicesLock);
+			NotifyDevicesChanged();
+		}
+	}
+}
+
+void FLoopbackHidTransport::SetReportGenerator(FLoopbackReportGenerator InGenerator)
+{
+	FScopeLock Lock(&DevicesLock);
+	Generator = MoveTemp(InGenerator);
+}
+
+int32 FLoopbackHidTransport::ConsumeWrittenReports(const FString& Path, TArray<TArray<uint8>>& OutReports)
+{
+	const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(Path);
+	if (!Device)
+	{
+		return 0;
+	}
+
+	FScopeLock Lock(&Device->CaptureLock);
+	const int32 Num = Device->CapturedReports.Num();
+	OutReports.Append(MoveTemp(Device->CapturedReports));
+	Device->CapturedReports.Reset();
+	return Num;
+}
+
+uint64 FLoopbackHidTransport::GetWriteCount(const FString& Path) const
+{
+	const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(Path);
+	return Device ? Device->WriteCount.load(std::memory_order_relaxed) : 0;
+}
+
+uint64 FLoopbackHidTransport::GetReportCount(const FString& Path) const
+{
+	const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(Path);
+	return Device ? Device->ReportCount.load(std::memory_order_relaxed) : 0;
+}
+
+bool FLoopbackHidTransport::StartDeviceNotifications(TFunction<void()> OnDevicesChanged)
+{
+	FScopeLock Lock(&DevicesLock);
+	DevicesChangedCallback = MoveTemp(OnDevicesChanged);
+	return true;
+}
+
+void FLoopbackHidTransport::StopDeviceNotifications()
+{
+	FScopeLock Lock(&DevicesLock);
+	DevicesChangedCallback.Reset();
+}
+
+void FLoopbackHidTransport::NotifyDevicesChanged() const
+{
+	// Called with DevicesLock held, so the callback cannot run after StopDeviceNotifications returns.
+	if (DevicesChangedCallback)
+	{
+		DevicesChangedCallback();
+	}
+}
+
+TSharedPtr<FLoopbackHidTransport::FVirtualDevice, ESPMode::ThreadSafe> FLoopbackHidTransport::FindDevice(
+	const FString& Path) const
+{
+	FScopeLock Lock(&DevicesLock);
+	for (const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe>& Device : Devices)
+	{
+		if (Device->Path == Path)
+		{
+			return Device;
+		}
+	}
+	return nullptr;
+}
+
+size_t FLoopbackHidTransport::Synthesize(FVirtualDevice& Device, unsigned char* Buffer, const size_t Length)
+{
+	const size_t ReportSize = FMath::Min(Length, ReportLength(Device.DeviceType, Device.ConnectionType));
+	FMemory::Memzero(Buffer, ReportSize);
+
+	const uint64 Sequence = Device.ReportCount.fetch_add(1, std::memory_order_relaxed);
+	const size_t Offset = PayloadOffset(Device.DeviceType, Device.ConnectionType);
+	if (ReportSize < Offset + 10)
+	{
+		return ReportSize;
+	}
+
+	unsigned char* Payload = &Buffer[Offset];
+	if (Device.ConnectionType == Bluetooth)
+	{
+		Buffer[0] = Device.DeviceType == DualShock4 ? 0x11 : 0x31;
+		Buffer[1] = Device.DeviceType == DualShock4 ? 0xC0 : static_cast<unsigned char>(Sequence << 4);
+	}
+	else
+	{
+		Buffer[0] = 0x01;
+	}
+
+	// Sticks sweep across their full range while the right stick rests at its center.
+	Payload[0x00] = static_cast<unsigned char>(Sequence * 2);
+	Payload[0x01] = 0x80;
+	Payload[0x02] = 0x80;
+	Payload[0x03] = 0x80;
+
+	// Cross is held for 32 reports out of every 64, with the D-pad released.
+	const unsigned char Buttons = ((Sequence >> 5) & 1) ? 0x20 : 0x00;
+	if (Device.DeviceType == DualShock4)
+	{
+		Payload[0x04] = Buttons | 0x08;
+		Payload[0x06] = static_cast<unsigned char>((Sequence & 0x3F) << 2);
+	}
+	else
+	{
+		Payload[0x06] = static_cast<unsigned char>(Sequence);
+		Payload[0x07] = Buttons | 0x08;
+	}
+
+	FLoopbackReportGenerator CustomGenerator;
+	{
+		FScopeLock Lock(&DevicesLock);
+		CustomGenerator = Generator;
+	}
+	if (CustomGenerator)
+	{
+		CustomGenerator(Device.Path, Sequence, Buffer, ReportSize);
+	}
+
+	// Sealed last, so reports edited by a custom generator pass the reader's CRC check too.
+	if (Device.ConnectionType == Bluetooth && ReportSize >= CrcCoveredLength + 4)
+	{
+		const uint32 Crc = FPlayStationCrc32::Finalize(
+			FPlayStationCrc32::Update(FPlayStationCrc32::InputSeedState, Buffer, CrcCoveredLength));
+		Buffer[CrcCoveredLength] = static_cast<unsigned char>(Crc);
+		Buffer[CrcCoveredLength + 1] = static_cast<unsigned char>(Crc >> 8);
+		Buffer[CrcCoveredLength + 2] = static_cast<unsigned char>(Crc >> 16);
+		Buffer[CrcCoveredLength + 3] = static_cast<unsigned char>(Crc >> 24);
+	}
+	return ReportSize;
+}
+
+void FLoopbackHidTransport::Detect(TArray<FDeviceContext>& OutDevices)
+{
+	FScopeLock Lock(&DevicesLock);
+	for (const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe>& Device : Devices)
+	{
+		if (!Device->bConnected.load(std::memory_order_acquire))
+		{
+			continue;
+		}
+
+		FDeviceContext Context = {};
+		FCString::Strncpy(Context.Path, *Device->Path, UE_ARRAY_COUNT(Context.Path));
+		Context.DeviceType = Device->DeviceType;
+		Context.ConnectionType = Device->ConnectionType;
+		Context.IsConnected = true;
+		Context.Handle = InvalidHandle();
+		OutDevices.Add(Context);
+	}
+}
+
+void* FLoopbackHidTransport::Open(const FDeviceContext& Context)
+{
+	const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(FString(Context.Path));
+	if (!Device || !Device->bConnected.load(std::memory_order_acquire))
+	{
+		return InvalidHandle();
+	}
+
+	FDeviceHandle* Handle = new FDeviceHandle();
+	Handle->Device = Device;
+	return Handle;
+}
+
+void FLoopbackHidTransport::Close(void* Handle)
+{
+	if (Handle && Handle != InvalidHandle())
+	{
+		delete static_cast<FDeviceHandle*>(Handle);
+	}
+}
+
+bool FLoopbackHidTransport::Write(void* Handle, const unsigned char* Buffer, const size_t Length)
+{
+	if (!Handle || Handle == InvalidHandle())
+	{
+		return false;
+	}
+
+	FVirtualDevice& Device = *static_cast<FDeviceHandle*>(Handle)->Device;
+	if (!Device.bConnected.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	Device.WriteCount.fetch_add(1, std::memory_order_relaxed);
+
+	FScopeLock Lock(&Device.CaptureLock);
+	if (Device.CapturedReports.Num() >= MaxCapturedReports)
+	{
+		Device.CapturedReports.RemoveAt(0);
+	}
+	Device.CapturedReports.Emplace(Buffer, static_cast<int32>(Length));
+	return true;
+}
+
+EPollResult FLoopbackHidTransport::Ping(void* Handle)
+{
+	if (!Handle || Handle == InvalidHandle())
+	{
+		return EPollResult::Disconnected;
+	}
+
+	const FVirtualDevice& Device = *static_cast<FDeviceHandle*>(Handle)->Device;
+	return Device.bConnected.load(std::memory_order_acquire) ? EPollResult::ReadOk : EPollResult::Disconnected;
+}
+
+void* FLoopbackHidTransport::OpenReader(const FDeviceContext& Context)
+{
+	const TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> Device = FindDevice(FString(Context.Path));
+	if (!Device || !Device->bConnected.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+
+	FReadStream* Stream = new FReadStream();
+	Stream->Device = Device;
+	Stream->CancelEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	Stream->NextReportTime = FPlatformTime::Seconds();
+	return Stream;
+}
+
+EPollResult FLoopbackHidTransport::ReadReport(void* Reader, unsigned char* Buffer, const size_t Length,
+                                              size_t& OutBytesRead)
+{
+	OutBytesRead = 0;
+	FReadStream* Stream = static_cast<FReadStream*>(Reader);
+	if (!Stream)
+	{
+		return EPollResult::Disconnected;
+	}
+
+	FVirtualDevice& Device = *Stream->Device;
+	if (Device.ReportInterval > 0.0)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Stream->NextReportTime > Now)
+		{
+			Stream->CancelEvent->Wait(FTimespan::FromSeconds(Stream->NextReportTime - Now));
+		}
+
+		// Keep a steady cadence, but never try to catch up on reports missed while nobody was reading.
+		Stream->NextReportTime = FMath::Max(Stream->NextReportTime + Device.ReportInterval,
+		                                    FPlatformTime::Seconds() - Device.ReportInterval);
+	}
+
+	if (Stream->bCancelled.load(std::memory_order_acquire))
+	{
+		return EPollResult::NoIoThisTick;
+	}
+
+	if (!Device.bConnected.load(std::memory_order_acquire))
+	{
+		return EPollResult::Disconnected;
+	}
+
+	OutBytesRead = Synthesize(Device, Buffer, Length);
+	return EPollResult::ReadOk;
+}
+
+void FLoopbackHidTransport::CancelRead(void* Reader)
+{
+	FReadStream* Stream = static_cast<FReadStream*>(Reader);
+	if (Stream)
+	{
+		Stream->bCancelled.store(true, std::memory_order_release);
+		Stream->CancelEvent->Trigger();
+	}
+}
+
+void FLoopbackHidTransport::CloseReader(void* Reader)
+{
+	FReadStream* Stream = static_cast<FReadStream*>(Reader);
+	if (!Stream)
+	{
+		return;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(Stream->CancelEvent);
+	delete Stream;
+}
@@ -0,0 +1,430 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/Transport/WindowsHidTransport.h"
+
+#if PLATFORM_WINDOWS
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <Windows.h>
+#include <hidsdi.h>
+#include <setupapi.h>
+#include <cfgmgr32.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+
+/**
+ * Overlapped read stream backing `OpenReader`/`ReadReport`.
+ */
+struct FOverlappedReadStream
+{
+	HANDLE Handle = INVALID_HANDLE_VALUE;
+	HANDLE CancelEvent = nullptr;
+	OVERLAPPED Overlapped = {};
+};
+
+namespace
+{
+	DWORD CALLBACK OnDeviceInterfaceNotification(HCMNOTIFICATION, PVOID Context, const CM_NOTIFY_ACTION Action,
+	                                             PCM_NOTIFY_EVENT_DATA, DWORD)
+	{
+		if (Action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL || Action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL)
+		{
+			(*static_cast<TFunction<void()>*>(Context))();
+		}
+		return ERROR_SUCCESS;
+	}
+}
+
+FWindowsHidTransport::~FWindowsHidTransport()
+{
+	StopDeviceNotifications();
+}
+
+bool FWindowsHidTransport::StartDeviceNotifications(TFunction<void()> OnDevicesChanged)
+{
+	StopDeviceNotifications();
+	DevicesChangedCallback = MoveTemp(OnDevicesChanged);
+
+	CM_NOTIFY_FILTER Filter = {};
+	Filter.cbSize = sizeof(CM_NOTIFY_FILTER);
+	Filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+	HidD_GetHidGuid(&Filter.u.DeviceInterface.ClassGuid);
+
+	HCMNOTIFICATION Notification = nullptr;
+	const CONFIGRET Result = CM_Register_Notification(&Filter, &DevicesChangedCallback,
+	                                                  OnDeviceInterfaceNotification, &Notification);
+	if (Result != CR_SUCCESS)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: CM_Register_Notification failed (%d). Falling back to polling."), Result);
+		DevicesChangedCallback.Reset();
+		return false;
+	}
+
+	NotificationHandle = Notification;
+	return true;
+}
+
+void FWindowsHidTransport::StopDeviceNotifications()
+{
+	if (NotificationHandle)
+	{
+		// Blocks until every callback in flight has returned.
+		CM_Unregister_Notification(static_cast<HCMNOTIFICATION>(NotificationHandle));
+		NotificationHandle = nullptr;
+	}
+	DevicesChangedCallback.Reset();
+}
+
+bool FWindowsHidTransport::ShouldTreatAsDisconnected(const uint32 Error)
+{
+	switch (Error)
+	{
+	case ERROR_DEVICE_NOT_CONNECTED:
+	case ERROR_GEN_FAILURE:
+	case ERROR_INVALID_HANDLE:
+	case ERROR_BAD_COMMAND:
+	case ERROR_FILE_NOT_FOUND:
+	case ERROR_ACCESS_DENIED:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool FWindowsHidTransport::ProbeDevice(const TCHAR* DevicePath, FEnumerationCacheEntry& OutEntry)
+{
+	OutEntry = FEnumerationCacheEntry();
+
+	// Opening without access rights succeeds even for keyboards and mice held exclusively by
+	// the system, and is enough to read the attributes, so those can be rejected once.
+	const HANDLE QueryHandle = CreateFileW(
+		DevicePath, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr
+	);
+	if (QueryHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	HIDD_ATTRIBUTES Attributes = {};
+	Attributes.Size = sizeof(HIDD_ATTRIBUTES);
+	const bool bHasAttributes = HidD_GetAttributes(QueryHandle, &Attributes) != FALSE;
+	CloseHandle(QueryHandle);
+	if (!bHasAttributes)
+	{
+		return false;
+	}
+
+	OutEntry.VendorId = Attributes.VendorID;
+	OutEntry.ProductId = Attributes.ProductID;
+	if (
+		Attributes.VendorID != 0x054C ||
+		(
+			Attributes.ProductID != 0x0CE6 &&
+			Attributes.ProductID != 0x0DF2 &&
+			Attributes.ProductID != 0x05C4 &&
+			Attributes.ProductID != 0x09CC
+		)
+	)
+	{
+		return true;
+	}
+
+	const HANDLE TempDeviceHandle = CreateFileW(
+		DevicePath,
+		GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr
+	);
+	if (TempDeviceHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	WCHAR DeviceProductString[260];
+	if (!HidD_GetProductString(TempDeviceHandle, DeviceProductString, 260))
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to obtain device path for the DualSense."));
+		CloseHandle(TempDeviceHandle);
+		return false;
+	}
+
+	switch (Attributes.ProductID)
+	{
+		case 0x05C4:
+		case 0x09CC:
+			OutEntry.DeviceType = DualShock4;
+			break;
+		case 0x0DF2:
+			OutEntry.DeviceType = DualSenseEdge;
+			break;
+		default: OutEntry.DeviceType = DualSense;
+	}
+
+	OutEntry.ConnectionType = Usb;
+	const FString Path(DevicePath);
+	if (Path.Contains(TEXT("{00001124-0000-1000-8000-00805f9b34fb}")) ||
+		Path.Contains(TEXT("bth")) ||
+		Path.Contains(TEXT("BTHENUM")))
+	{
+		OutEntry.ConnectionType = Bluetooth;
+	}
+
+	CloseHandle(TempDeviceHandle);
+	OutEntry.bRejected = false;
+	return true;
+}
+
+void FWindowsHidTransport::Detect(TArray<FDeviceContext>& Devices)
+{
+	GUID HidGuid;
+	HidD_GetHidGuid(&HidGuid);
+
+	const HDEVINFO DeviceInfoSet = SetupDiGetClassDevs(&HidGuid, nullptr, nullptr,
+	                                                   DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+	if (DeviceInfoSet == INVALID_HANDLE_VALUE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Falha ao obter informações dos dispositivos HID."));
+		return;
+	}
+
+	SP_DEVICE_INTERFACE_DATA DeviceInterfaceData = {};
+	DeviceInterfaceData.cbSize = sizeof(SP_DEVICE_INTERFACE_DATA);
+
+	FScopeLock Lock(&EnumerationCacheLock);
+	TSet<FString> PresentPaths;
+	for (DWORD DeviceIndex = 0; SetupDiEnumDeviceInterfaces(DeviceInfoSet, nullptr, &HidGuid, DeviceIndex,
+	                                                        &DeviceInterfaceData); DeviceIndex++)
+	{
+		DWORD RequiredSize = 0;
+
+		SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, nullptr, 0, &RequiredSize, nullptr);
+
+		const auto DetailDataBuffer = static_cast<PSP_DEVICE_INTERFACE_DETAIL_DATA>(malloc(RequiredSize));
+		if (!DetailDataBuffer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to allocate memory for device details."));
+			continue;
+		}
+
+		DetailDataBuffer->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA);
+		if (!SetupDiGetDeviceInterfaceDetail(DeviceInfoSet, &DeviceInterfaceData, DetailDataBuffer, RequiredSize,
+		                                     nullptr, nullptr))
+		{
+			free(DetailDataBuffer);
+			continue;
+		}
+
+		const FString DevicePath(DetailDataBuffer->DevicePath);
+		free(DetailDataBuffer);
+
+		bool bAlreadyPresent = false;
+		PresentPaths.Add(DevicePath, &bAlreadyPresent);
+		if (bAlreadyPresent)
+		{
+			continue;
+		}
+
+		const FEnumerationCacheEntry* Entry = EnumerationCache.Find(DevicePath);
+		if (!Entry)
+		{
+			FEnumerationCacheEntry Probed;
+			if (!ProbeDevice(*DevicePath, Probed))
+			{
+				continue;
+			}
+			Entry = &EnumerationCache.Add(DevicePath, Probed);
+		}
+
+		if (Entry->bRejected)
+		{
+			continue;
+		}
+
+		FDeviceContext Context = {};
+		FCString::Strncpy(Context.Path, *DevicePath, UE_ARRAY_COUNT(Context.Path));
+		Context.DeviceType = Entry->DeviceType;
+		Context.ConnectionType = Entry->ConnectionType;
+		Context.IsConnected = true;
+		Context.Handle = InvalidHandle();
+		Devices.Add(Context);
+	}
+
+	SetupDiDestroyDeviceInfoList(DeviceInfoSet);
+
+	for (auto It = EnumerationCache.CreateIterator(); It; ++It)
+	{
+		if (!PresentPaths.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void* FWindowsHidTransport::Open(const FDeviceContext& Context)
+{
+	const HANDLE DeviceHandle = CreateFileW(
+			Context.Path,
+			GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, NULL, nullptr
+		);
+
+	if (DeviceHandle == INVALID_HANDLE_VALUE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open device handle for the DualSense."));
+		return InvalidHandle();
+	}
+
+	if (Context.ConnectionType == Bluetooth)
+	{
+		// Switches the controller to full reports. Sent on every open rather than once per
+		// cached path, since a controller reconnecting on the same path starts in reduced mode.
+		unsigned char FeatureBuffer[78];
+		FeatureBuffer[0] = 0x05;
+		if (!HidD_GetFeature(DeviceHandle, FeatureBuffer, 78)) {
+			UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to HidD_GetFeature."));
+		}
+	}
+
+	return DeviceHandle;
+}
+
+void FWindowsHidTransport::Close(void* Handle)
+{
+	if (Handle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(Handle);
+	}
+}
+
+bool FWindowsHidTransport::Write(void* Handle, const unsigned char* Buffer, const size_t Length)
+{
+	if (Handle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	DWORD BytesWritten = 0;
+	if (!WriteFile(Handle, Buffer, static_cast<DWORD>(Length), &BytesWritten, nullptr))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write output data to device. report %llu error Code: %d"),
+			static_cast<uint64>(Length), GetLastError());
+		return false;
+	}
+	return true;
+}
+
+EPollResult FWindowsHidTransport::Ping(void* Handle)
+{
+	FILE_STANDARD_INFO Info;
+	if (!GetFileInformationByHandleEx(Handle, FileStandardInfo, &Info, sizeof(Info)))
+	{
+		return ShouldTreatAsDisconnected(GetLastError()) ? EPollResult::Disconnected : EPollResult::TransientError;
+	}
+	return EPollResult::ReadOk;
+}
+
+void* FWindowsHidTransport::OpenReader(const FDeviceContext& Context)
+{
+	const HANDLE Handle = CreateFileW(
+		Context.Path,
+		GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_OVERLAPPED, nullptr
+	);
+	if (Handle == INVALID_HANDLE_VALUE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HIDManager: Failed to open read stream. Error Code: %d"), GetLastError());
+		return nullptr;
+	}
+
+	// Bursts arriving while the reader is busy queue up in the driver instead of overwriting
+	// each other in its default 32-report ring.
+	if (!HidD_SetNumInputBuffers(Handle, InputBufferCount))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("HIDManager: Failed to HidD_SetNumInputBuffers. Error Code: %d"), GetLastError());
+	}
+
+	FOverlappedReadStream* Stream = new FOverlappedReadStream();
+	Stream->Handle = Handle;
+	Stream->CancelEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	Stream->Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!Stream->CancelEvent || !Stream->Overlapped.hEvent)
+	{
+		CloseReader(Stream);
+		return nullptr;
+	}
+	return Stream;
+}
+
+EPollResult FWindowsHidTransport::ReadReport(void* Reader, unsigned char* Buffer, const size_t Length, size_t& OutBytesRead)
+{
+	OutBytesRead = 0;
+	FOverlappedReadStream* Stream = static_cast<FOverlappedReadStream*>(Reader);
+	if (!Stream || Stream->Handle == INVALID_HANDLE_VALUE)
+	{
+		return EPollResult::Disconnected;
+	}
+
+	ResetEvent(Stream->Overlapped.hEvent);
+	if (!ReadFile(Stream->Handle, Buffer, static_cast<DWORD>(Length), nullptr, &Stream->Overlapped))
+	{
+		const DWORD Error = GetLastError();
+		if (Error != ERROR_IO_PENDING)
+		{
+			return ShouldTreatAsDisconnected(Error) ? EPollResult::Disconnected : EPollResult::TransientError;
+		}
+	}
+
+	const HANDLE WaitHandles[2] = {Stream->Overlapped.hEvent, Stream->CancelEvent};
+	const DWORD WaitResult = WaitForMultipleObjects(2, WaitHandles, FALSE, INFINITE);
+
+	DWORD BytesTransferred = 0;
+	if (WaitResult != WAIT_OBJECT_0)
+	{
+		// Cancelled (or the wait itself failed): make sure the pending read no longer targets Buffer.
+		CancelIoEx(Stream->Handle, &Stream->Overlapped);
+		GetOverlappedResult(Stream->Handle, &Stream->Overlapped, &BytesTransferred, TRUE);
+		return EPollResult::NoIoThisTick;
+	}
+
+	if (!GetOverlappedResult(Stream->Handle, &Stream->Overlapped, &BytesTransferred, FALSE))
+	{
+		const DWORD Error = GetLastError();
+		return ShouldTreatAsDisconnected(Error) ? EPollResult::Disconnected : EPollResult::TransientError;
+	}
+
+	OutBytesRead = BytesTransferred;
+	return EPollResult::ReadOk;
+}
+
+void FWindowsHidTransport::CancelRead(void* Reader)
+{
+	const FOverlappedReadStream* Stream = static_cast<FOverlappedReadStream*>(Reader);
+	if (Stream && Stream->CancelEvent)
+	{
+		SetEvent(Stream->CancelEvent);
+	}
+}
+
+void FWindowsHidTransport::CloseReader(void* Reader)
+{
+	FOverlappedReadStream* Stream = static_cast<FOverlappedReadStream*>(Reader);
+	if (!Stream)
+	{
+		return;
+	}
+
+	if (Stream->Handle != INVALID_HANDLE_VALUE)
+	{
+		CancelIoEx(Stream->Handle, nullptr);
+		CloseHandle(Stream->Handle);
+	}
+	if (Stream->Overlapped.hEvent)
+	{
+		CloseHandle(Stream->Overlapped.hEvent);
+	}
+	if (Stream->CancelEvent)
+	{
+		CloseHandle(Stream->CancelEvent);
+	}
+	delete Stream;
+}
+
+#endif
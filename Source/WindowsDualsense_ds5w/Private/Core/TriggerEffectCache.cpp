@@ -0,0 +1,308 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/TriggerEffectCache.h"
+#include "Misc/ScopeRWLock.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Helpers/ValidateHelpers.h"
+
+namespace
+{
+	FRWLock CacheLock;
+	TMap<uint64, FTriggerEffectBlob> Cache;
+
+	uint64 MakeKey(const uint8 Mode, const std::initializer_list<int32> Args, bool& bOutCacheable)
+	{
+		check(Args.size() <= 7);
+
+		uint64 Key = Mode;
+		int32 Shift = 8;
+		bOutCacheable = true;
+		for (const int32 Arg : Args)
+		{
+			bOutCacheable &= Arg >= 0 && Arg <= 0xFF;
+			Key |= static_cast<uint64>(Arg & 0xFF) << Shift;
+			Shift += 8;
+		}
+		return Key;
+	}
+
+	/**
+	 * Zones and strengths of the effects defined by a strength for each of the ten zones.
+	 */
+	void EncodeZones(const unsigned char (&Amplitudes)[10], const unsigned char (&Strengths)[10], FStrengths& Out)
+	{
+		int64 StrengthZones = 0;
+		int32 ActiveZones = 0;
+		for (int i = 0; i < 10; i++)
+		{
+			if (Amplitudes[i] > 0)
+			{
+				const uint64_t StrengthValue = static_cast<uint64_t>((Strengths[i] - 1) & 0x07);
+				StrengthZones |= static_cast<int64>(StrengthValue << (3 * i));
+				ActiveZones |= (1 << i);
+			}
+		}
+		Out.ActiveZones = ActiveZones;
+		Out.StrengthZones = StrengthZones;
+	}
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Encode(const FHapticTriggers& Effect)
+{
+	const TSharedRef<FTriggerEffectData, ESPMode::ThreadSafe> Data = MakeShared<FTriggerEffectData, ESPMode::ThreadSafe>();
+	Data->Parameters = Effect;
+	Data->Parameters.Encoded = FTriggerEffectBlob();
+	FMemory::Memzero(Data->Bytes);
+
+	FHapticTriggers Parameters = Data->Parameters;
+	FPlayStationOutputComposer::SetTriggerEffects(Data->Bytes, Parameters);
+	return FTriggerEffectBlob(Data);
+}
+
+void FTriggerEffectCache::Apply(const FTriggerEffectBlob& Effect, FHapticTriggers& Trigger)
+{
+	const FTriggerEffectData* Data = Effect.Get();
+	if (!Data)
+	{
+		return;
+	}
+
+	// Mirrors the fields read by FPlayStationOutputComposer::SetTriggerEffects for each mode.
+	const FHapticTriggers& Parameters = Data->Parameters;
+	Trigger.Mode = Parameters.Mode;
+	switch (Parameters.Mode)
+	{
+	case 0x01:
+	case 0x02:
+	case 0x21:
+	case 0x22:
+	case 0x25:
+		Trigger.Strengths.ActiveZones = Parameters.Strengths.ActiveZones;
+		Trigger.Strengths.StrengthZones = Parameters.Strengths.StrengthZones;
+		break;
+	case 0x23:
+		Trigger.Strengths.ActiveZones = Parameters.Strengths.ActiveZones;
+		Trigger.Strengths.TimeAndRatio = Parameters.Strengths.TimeAndRatio;
+		Trigger.Frequency = Parameters.Frequency;
+		break;
+	case 0x26:
+		Trigger.Strengths.ActiveZones = Parameters.Strengths.ActiveZones;
+		Trigger.Strengths.StrengthZones = Parameters.Strengths.StrengthZones;
+		Trigger.Frequency = Parameters.Frequency;
+		break;
+	case 0x27:
+		Trigger.Strengths.ActiveZones = Parameters.Strengths.ActiveZones;
+		Trigger.Strengths.StrengthZones = Parameters.Strengths.StrengthZones;
+		Trigger.Strengths.Period = Parameters.Strengths.Period;
+		Trigger.Frequency = Parameters.Frequency;
+		break;
+	default:
+		break;
+	}
+	Trigger.Encoded = Effect;
+}
+
+FTriggerEffectBlob FTriggerEffectCache::FindOrEncode(const uint64 Key, const bool bCacheable,
+                                                     const TFunctionRef<FHapticTriggers()> Build)
+{
+	if (!bCacheable)
+	{
+		return Encode(Build());
+	}
+
+	{
+		FReadScopeLock ReadLock(CacheLock);
+		if (const FTriggerEffectBlob* Found = Cache.Find(Key))
+		{
+			return *Found;
+		}
+	}
+
+	const FTriggerEffectBlob Blob = Encode(Build());
+	FWriteScopeLock WriteLock(CacheLock);
+	// Another thread may have encoded the same effect meanwhile; keep the first one.
+	return Cache.FindOrAdd(Key, Blob);
+}
+
+int32 FTriggerEffectCache::Num()
+{
+	FReadScopeLock ReadLock(CacheLock);
+	return Cache.Num();
+}
+
+void FTriggerEffectCache::Empty()
+{
+	FWriteScopeLock WriteLock(CacheLock);
+	Cache.Empty();
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Off()
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x0, {}, bCacheable);
+	return FindOrEncode(Key, bCacheable, []
+	{
+		return FHapticTriggers();
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::ContinuousResistance(int32 StartPosition, int32 Strength)
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x01, {StartPosition, Strength}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		FHapticTriggers Effect;
+		Effect.Mode = 0x01;
+		Effect.Strengths.ActiveZones = FValidateHelpers::To255(StartPosition, 8);
+		Effect.Strengths.StrengthZones = FValidateHelpers::To255(Strength, 9);
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Resistance(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength)
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x21, {BeginStrength, MiddleStrength, EndStrength}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		unsigned char PositionalAmplitudes[10];
+		PositionalAmplitudes[0] = BeginStrength;
+		PositionalAmplitudes[1] = BeginStrength;
+		PositionalAmplitudes[2] = BeginStrength;
+		PositionalAmplitudes[3] = BeginStrength;
+		PositionalAmplitudes[4] = MiddleStrength;
+		PositionalAmplitudes[5] = MiddleStrength;
+		PositionalAmplitudes[6] = MiddleStrength;
+		PositionalAmplitudes[7] = MiddleStrength;
+		PositionalAmplitudes[8] = EndStrength;
+		PositionalAmplitudes[9] = EndStrength;
+
+		int32 ActiveZones = 0;
+		int16 StrengthValues = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			if (PositionalAmplitudes[i] > 0)
+			{
+				const int8_t StrengthValue = static_cast<int8_t>((PositionalAmplitudes[i] - 1) & 0x07);
+				StrengthValues |= (StrengthValue << (3 * i));
+				ActiveZones |= static_cast<int16>(1 << i);
+			}
+		}
+
+		FHapticTriggers Effect;
+		Effect.Mode = 0x21;
+		Effect.Strengths.ActiveZones = ActiveZones;
+		Effect.Strengths.StrengthZones = StrengthValues;
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::AutomaticGun(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
+                                                     bool bKeepEffect)
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x26, {BeginStrength, MiddleStrength, EndStrength, bKeepEffect ? 1 : 0}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		unsigned char PositionalAmplitudes[10];
+		PositionalAmplitudes[0] = BeginStrength;
+		PositionalAmplitudes[1] = BeginStrength;
+		PositionalAmplitudes[2] = BeginStrength;
+		PositionalAmplitudes[3] = BeginStrength;
+		PositionalAmplitudes[4] = MiddleStrength;
+		PositionalAmplitudes[5] = MiddleStrength;
+		PositionalAmplitudes[6] = MiddleStrength;
+		PositionalAmplitudes[7] = MiddleStrength;
+		PositionalAmplitudes[8] = bKeepEffect ? 8 : EndStrength;
+		PositionalAmplitudes[9] = bKeepEffect ? 8 : EndStrength;
+
+		unsigned char Strengths[10];
+		for (int i = 0; i < 10; i++)
+		{
+			Strengths[i] = static_cast<uint64_t>(PositionalAmplitudes[i] * 8.0f);
+		}
+
+		FHapticTriggers Effect;
+		Effect.Mode = 0x26;
+		EncodeZones(PositionalAmplitudes, Strengths, Effect.Strengths);
+		Effect.Frequency = FValidateHelpers::To255(0.05f);
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Weapon(int32 StartPosition, int32 EndPosition, int32 Strength)
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x25, {StartPosition, EndPosition, Strength}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		FHapticTriggers Effect;
+		Effect.Mode = 0x25;
+		Effect.Strengths.ActiveZones = (1 << StartPosition) | (1 << EndPosition);
+		Effect.Strengths.StrengthZones = FValidateHelpers::To255(Strength);
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Galloping(int32 StartPosition, int32 EndPosition, int32 FirstFoot,
+                                                  int32 SecondFoot, float Frequency)
+{
+	const int32 EncodedFrequency = FValidateHelpers::To255(Frequency);
+
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x23, {StartPosition, EndPosition, FirstFoot, SecondFoot, EncodedFrequency}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		FHapticTriggers Effect;
+		Effect.Mode = 0x23;
+		Effect.Strengths.ActiveZones = (1 << StartPosition) | (1 << EndPosition);
+		Effect.Strengths.TimeAndRatio = (SecondFoot & 0x07) << (3 * 0) | (FirstFoot & 0x07);
+		Effect.Frequency = EncodedFrequency;
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Machine(int32 StartPosition, int32 EndPosition, int32 AmplitudeBegin,
+                                                int32 AmplitudeEnd, float Frequency, float Period)
+{
+	if (Period < 0.0f || Period > 3.f)
+	{
+		Period = 3.f;
+	}
+	const int32 EncodedFrequency = FValidateHelpers::To255(Frequency);
+	const int32 EncodedPeriod = FValidateHelpers::To255(Period);
+
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x27, {
+		                           StartPosition, EndPosition, AmplitudeBegin, AmplitudeEnd, EncodedFrequency,
+		                           EncodedPeriod
+	                           }, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		FHapticTriggers Effect;
+		Effect.Mode = 0x27;
+		Effect.Strengths.ActiveZones = (1 << StartPosition) | (1 << EndPosition);
+		Effect.Strengths.StrengthZones = ((AmplitudeBegin & 0x07) << (3 * 0)) | ((AmplitudeEnd & 0x07) << (3 * 1));
+		Effect.Strengths.Period = EncodedPeriod;
+		Effect.Frequency = EncodedFrequency;
+		return Effect;
+	});
+}
+
+FTriggerEffectBlob FTriggerEffectCache::Bow(int32 StartPosition, int32 EndPosition, int32 BeginStrength,
+                                            int32 EndStrength)
+{
+	bool bCacheable;
+	const uint64 Key = MakeKey(0x22, {StartPosition, EndPosition, BeginStrength, EndStrength}, bCacheable);
+	return FindOrEncode(Key, bCacheable, [&]
+	{
+		FHapticTriggers Effect;
+		Effect.Mode = 0x22;
+		Effect.Strengths.ActiveZones = (1 << StartPosition) | (1 << EndPosition);
+		Effect.Strengths.StrengthZones = (((BeginStrength - 1) & 0x07) << (3 * 0)) | (((EndStrength - 1) & 0x07) << (3 * 1));
+		return Effect;
+	});
+}
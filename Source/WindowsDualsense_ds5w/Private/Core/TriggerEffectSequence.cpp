@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Core/TriggerEffectSequence.h"
+#include "Algo/UpperBound.h"
+#include "Core/Structs/FOutputContext.h"
+#include "Helpers/ValidateHelpers.h"
+
+TSharedRef<const FTriggerSequenceData, ESPMode::ThreadSafe> UTriggerEffectSequence::CreateSnapshot() const
+{
+	const TSharedRef<FTriggerSequenceData, ESPMode::ThreadSafe> Data = MakeShared<FTriggerSequenceData, ESPMode::ThreadSafe>();
+	Data->Mode = Effect == ETriggerSequenceEffect::Vibration ? 0x26 : 0x21;
+	Data->bLoop = bLoop;
+	Data->Keys.Reserve(Keyframes.Num());
+	for (const FTriggerEffectKeyframe& Keyframe : Keyframes)
+	{
+		FTriggerSequenceData::FKey& Key = Data->Keys.AddDefaulted_GetRef();
+		Key.Time = FMath::Max(0.0f, Keyframe.Time);
+		for (int32 Zone = 0; Zone < FTriggerSequenceData::NumZones; ++Zone)
+		{
+			Key.Strengths[Zone] = Keyframe.ZoneStrengths.IsValidIndex(Zone)
+				                      ? FMath::Clamp(Keyframe.ZoneStrengths[Zone], 0.0f, 8.0f)
+				                      : 0.0f;
+		}
+		Key.Frequency = FMath::Clamp(Keyframe.Frequency, 0.0f, 1.0f);
+	}
+	Data->Keys.StableSort([](const FTriggerSequenceData::FKey& A, const FTriggerSequenceData::FKey& B)
+	{
+		return A.Time < B.Time;
+	});
+	return Data;
+}
+
+bool FTriggerSequenceData::Evaluate(double Seconds, FHapticTriggers& OutEffect) const
+{
+	if (Keys.Num() == 0)
+	{
+		return false;
+	}
+
+	const double Duration = GetDuration();
+	if (Seconds > Duration)
+	{
+		if (!bLoop)
+		{
+			return false;
+		}
+		Seconds = Duration > 0.0 ? FMath::Fmod(Seconds, Duration) : 0.0;
+	}
+
+	// First key strictly after the time; the segment starts at the key before it.
+	const int32 Next = Algo::UpperBoundBy(Keys, Seconds, &FKey::Time);
+	const FKey& To = Keys[FMath::Min(Next, Keys.Num() - 1)];
+	const FKey& From = Keys[FMath::Max(Next - 1, 0)];
+	const double Span = To.Time - From.Time;
+	const float Alpha = Span > 0.0 ? static_cast<float>((Seconds - From.Time) / Span) : 0.0f;
+
+	int32 ActiveZones = 0;
+	uint64 StrengthZones = 0;
+	for (int32 Zone = 0; Zone < NumZones; ++Zone)
+	{
+		const int32 Strength = FMath::RoundToInt(FMath::Lerp(From.Strengths[Zone], To.Strengths[Zone], Alpha));
+		if (Strength > 0)
+		{
+			StrengthZones |= static_cast<uint64>((Strength - 1) & 0x07) << (3 * Zone);
+			ActiveZones |= 1 << Zone;
+		}
+	}
+
+	OutEffect.Mode = Mode;
+	OutEffect.Strengths.ActiveZones = ActiveZones;
+	OutEffect.Strengths.StrengthZones = StrengthZones;
+	OutEffect.Frequency = FValidateHelpers::To255(FMath::Lerp(From.Frequency, To.Frequency, Alpha));
+	OutEffect.Encoded = FTriggerEffectBlob();
+	return true;
+}
@@ -6,9 +6,15 @@
 #include "Async/Async.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "Core/DeviceRegistry.h"
+#include "Core/AnalogDeltaFilter.h"
+#include "Core/HIDReaderRunnable.h"
+#include "Core/InputLatencyStats.h"
 #include "Core/Interfaces/SonyGamepadTriggerInterface.h"
+#if PLATFORM_WINDOWS
 #include "Windows/WindowsApplication.h"
+#endif
 #include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
 
 DeviceManager::DeviceManager(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
                              bool Lazily): MessageHandler(InMessageHandler)
@@ -26,6 +32,163 @@ void DeviceManager::SendControllerEvents()
 {
 }
 
+bool DeviceManager::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!FParse::Command(&Cmd, TEXT("DUALSENSE")))
+	{
+		return false;
+	}
+
+	if (FParse::Command(&Cmd, TEXT("ANALOG")))
+	{
+		ExecAnalog(Cmd, Ar);
+		return true;
+	}
+
+	if (FParse::Command(&Cmd, TEXT("CRC")))
+	{
+		if (FParse::Command(&Cmd, TEXT("ON")))
+		{
+			FHIDReaderRunnable::SetCrcValidationEnabled(true);
+		}
+		else if (FParse::Command(&Cmd, TEXT("OFF")))
+		{
+			FHIDReaderRunnable::SetCrcValidationEnabled(false);
+		}
+
+		Ar.Logf(TEXT("DualSense Bluetooth input CRC validation is %s."),
+		        FHIDReaderRunnable::IsCrcValidationEnabled() ? TEXT("enabled") : TEXT("disabled"));
+		for (const TPair<FInputDeviceId, ISonyGamepadInterface*>& Device : FDeviceRegistry::Get()->GetAllocatedDevicesMap())
+		{
+			if (Device.Value)
+			{
+				Ar.Logf(TEXT("Device %d: %llu reports with a bad CRC discarded."), Device.Key.GetId(),
+				        Device.Value->GetCrcFailures());
+			}
+		}
+		return true;
+	}
+
+	if (FParse::Command(&Cmd, TEXT("MOTIONBENCH")))
+	{
+		int32 NumDevices = 8;
+		int32 Iterations = 100000;
+		FParse::Value(Cmd, TEXT("DEVICES="), NumDevices);
+		FParse::Value(Cmd, TEXT("ITERATIONS="), Iterations);
+		FMotionBatch::Benchmark(FMath::Clamp(NumDevices, 1, 1024), FMath::Max(Iterations, 1), Ar);
+		return true;
+	}
+
+	if (!FParse::Command(&Cmd, TEXT("STATS")))
+	{
+		Ar.Log(TEXT("Usage: DUALSENSE STATS [ON|OFF|RESET]"));
+		Ar.Log(TEXT("       DUALSENSE ANALOG [DELTA|ALWAYS|RESET] [EPSILON=<value>] [KEEPALIVE=<seconds>]"));
+		Ar.Log(TEXT("       DUALSENSE CRC [ON|OFF]"));
+		Ar.Log(TEXT("       DUALSENSE MOTIONBENCH [DEVICES=<n>] [ITERATIONS=<n>]"));
+		return true;
+	}
+
+	if (FParse::Command(&Cmd, TEXT("ON")))
+	{
+		FInputLatencyStats::SetEnabled(true);
+		Ar.Log(TEXT("DualSense latency instrumentation enabled."));
+		return true;
+	}
+
+	if (FParse::Command(&Cmd, TEXT("OFF")))
+	{
+		FInputLatencyStats::SetEnabled(false);
+		Ar.Log(TEXT("DualSense latency instrumentation disabled."));
+		return true;
+	}
+
+	const bool bReset = FParse::Command(&Cmd, TEXT("RESET"));
+	if (!bReset)
+	{
+		Ar.Logf(TEXT("DualSense latency instrumentation is %s."),
+		        FInputLatencyStats::IsEnabled() ? TEXT("enabled") : TEXT("disabled"));
+	}
+
+	for (const TPair<FInputDeviceId, ISonyGamepadInterface*>& Device : FDeviceRegistry::Get()->GetAllocatedDevicesMap())
+	{
+		FInputLatencyStats* Stats = Device.Value ? Device.Value->GetLatencyStats() : nullptr;
+		if (!Stats)
+		{
+			continue;
+		}
+
+		if (bReset)
+		{
+			Stats->Reset();
+			continue;
+		}
+
+		Ar.Logf(TEXT("Device %d:"), Device.Key.GetId());
+		Stats->Dump(Ar, Device.Value->GetDroppedReports(), Device.Value->GetCrcFailures());
+	}
+
+	if (bReset)
+	{
+		Ar.Log(TEXT("DualSense latency statistics reset."));
+	}
+	return true;
+}
+
+void DeviceManager::ExecAnalog(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	const bool bDelta = FParse::Command(&Cmd, TEXT("DELTA"));
+	const bool bAlways = !bDelta && FParse::Command(&Cmd, TEXT("ALWAYS"));
+	const bool bReset = !bDelta && !bAlways && FParse::Command(&Cmd, TEXT("RESET"));
+
+	float Epsilon = 0.0f;
+	const bool bHasEpsilon = FParse::Value(Cmd, TEXT("EPSILON="), Epsilon);
+	float KeepAlive = 0.0f;
+	const bool bHasKeepAlive = FParse::Value(Cmd, TEXT("KEEPALIVE="), KeepAlive);
+
+	for (const TPair<FInputDeviceId, ISonyGamepadInterface*>& Device : FDeviceRegistry::Get()->GetAllocatedDevicesMap())
+	{
+		FAnalogDeltaFilter* Filter = Device.Value ? Device.Value->GetAnalogFilter() : nullptr;
+		if (!Filter)
+		{
+			continue;
+		}
+
+		if (bReset)
+		{
+			Filter->ResetCounters();
+			continue;
+		}
+
+		if (bDelta || bAlways || bHasEpsilon || bHasKeepAlive)
+		{
+			FAnalogDispatchSettings Settings = Filter->GetSettings();
+			Settings.bDeltaOnly = bDelta || (!bAlways && Settings.bDeltaOnly);
+			if (bHasEpsilon)
+			{
+				for (float& AxisEpsilon : Settings.Epsilon)
+				{
+					AxisEpsilon = FMath::Max(Epsilon, 0.0f);
+				}
+			}
+			if (bHasKeepAlive)
+			{
+				Settings.KeepAliveSeconds = FMath::Max(KeepAlive, 0.0f);
+			}
+			Filter->Configure(Settings);
+		}
+
+		const FAnalogDispatchSettings& Settings = Filter->GetSettings();
+		Ar.Logf(TEXT("Device %d: %s, keep-alive %.2fs, dispatched %llu, suppressed %llu"), Device.Key.GetId(),
+		        Settings.bDeltaOnly ? TEXT("delta-only") : TEXT("every update"), Settings.KeepAliveSeconds,
+		        Filter->GetDispatchedEvents(), Filter->GetSuppressedEvents());
+	}
+
+	if (bReset)
+	{
+		Ar.Log(TEXT("DualSense analog counters reset."));
+	}
+}
+
 void DeviceManager::Tick(float DeltaTime)
 {
 	FDeviceRegistry::Get()->DetectedChangeConnections(DeltaTime);
@@ -41,6 +204,9 @@ void DeviceManager::Tick(float DeltaTime)
 	TArray<FInputDeviceId> OutInputDevices;
 	OutInputDevices.Reset();
 	IPlatformInputDeviceMapper::Get().GetAllConnectedInputDevices(OutInputDevices);
+
+	MotionBatch.Reset();
+	PendingMotion.Reset();
 	
 	for (const FInputDeviceId& Device : OutInputDevices)
 	{
@@ -64,8 +230,25 @@ void DeviceManager::Tick(float DeltaTime)
 
 			FInputDeviceScope InputScope(this, TEXT("DeviceManager.WindowsDualsense"), Device.GetId(), ContextDrive);
 			Gamepad->UpdateInput(MessageHandler, UserId, Device);
+			if (const int32 Slot = Gamepad->AddMotionToBatch(MotionBatch); Slot != INDEX_NONE)
+			{
+				PendingMotion.Add({Gamepad, Slot, UserId, Device, MoveTemp(ContextDrive)});
+			}
 		}
 	}
+
+	if (PendingMotion.Num() == 0)
+	{
+		return;
+	}
+
+	MotionBatch.Process();
+	for (const FPendingMotion& Pending : PendingMotion)
+	{
+		FInputDeviceScope InputScope(this, TEXT("DeviceManager.WindowsDualsense"), Pending.Device.GetId(),
+		                             Pending.ContextDrive);
+		Pending.Gamepad->DispatchMotion(MotionBatch, Pending.Slot, MessageHandler, Pending.UserId, Pending.Device);
+	}
 }
 
 void DeviceManager::SetDeviceProperty(int32 ControllerId, const FInputDeviceProperty* Property)
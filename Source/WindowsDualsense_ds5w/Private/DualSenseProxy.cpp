@@ -7,6 +7,7 @@
 #include "Core/DualSense/DualSenseLibrary.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
 #include "Core/Interfaces/SonyGamepadTriggerInterface.h"
+#include "Core/TriggerEffectCache.h"
 #include "Helpers/ValidateHelpers.h"
 #include "Runtime/ApplicationCore/Public/GenericPlatform/IInputInterface.h"
 
@@ -259,6 +260,135 @@ void UDualSenseProxy::Bow(int32 ControllerId, int32 StartPosition, int32 EndPosi
 	Gamepad->SetBow(StartPosition, EndPosition, BeginStrength, EndStrength, Hand);
 }
 
+void UDualSenseProxy::ApplyTriggerEffect(int32 ControllerId, const FTriggerEffectBlob& Effect, EControllerHand Hand)
+{
+	if (!Effect.IsValid())
+	{
+		return;
+	}
+
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadTriggerInterface* Gamepad = Cast<ISonyGamepadTriggerInterface>(FDeviceRegistry::Get()->GetLibraryInstance(DeviceId));
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->SetTriggerEffect(Effect, Hand);
+}
+
+void UDualSenseProxy::PlayTriggerSequence(int32 ControllerId, UTriggerEffectSequence* Sequence, EControllerHand Hand)
+{
+	if (!Sequence)
+	{
+		return;
+	}
+
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadTriggerInterface* Gamepad = Cast<ISonyGamepadTriggerInterface>(FDeviceRegistry::Get()->GetLibraryInstance(DeviceId));
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->PlayTriggerSequence(Sequence->CreateSnapshot(), Hand);
+}
+
+void UDualSenseProxy::StopTriggerSequence(int32 ControllerId, EControllerHand Hand)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadTriggerInterface* Gamepad = Cast<ISonyGamepadTriggerInterface>(FDeviceRegistry::Get()->GetLibraryInstance(DeviceId));
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->PlayTriggerSequence(nullptr, Hand);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeAutomaticGun(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength,
+                                                     bool KeepEffect)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(BeginStrength)) BeginStrength = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(MiddleStrength)) MiddleStrength = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(EndStrength)) EndStrength = 8;
+
+	return FTriggerEffectCache::AutomaticGun(BeginStrength, MiddleStrength, EndStrength, KeepEffect);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeResistance(int32 StartPosition, int32 EndPosition, int32 Strength)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndPosition)) EndPosition = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(Strength)) Strength = 8;
+
+	return FTriggerEffectCache::Resistance(StartPosition, EndPosition, Strength);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeContinuousResistance(int32 StartPosition, int32 Strength)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(Strength)) Strength = 8;
+
+	return FTriggerEffectCache::ContinuousResistance(StartPosition, Strength);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeBow(int32 StartPosition, int32 EndPosition, int32 BeginStrength, int32 EndStrength)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndPosition)) EndPosition = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(BeginStrength)) BeginStrength = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndStrength)) EndStrength = 8;
+
+	return FTriggerEffectCache::Bow(StartPosition, EndPosition, BeginStrength, EndStrength);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeGalloping(int32 StartPosition, int32 EndPosition, int32 FirstFoot,
+                                                  int32 SecondFoot, float Frequency)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndPosition)) EndPosition = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(FirstFoot)) FirstFoot = 2;
+	if (!FValidateHelpers::ValidateMaxPosition(SecondFoot)) SecondFoot = 7;
+
+	return FTriggerEffectCache::Galloping(StartPosition, EndPosition, FirstFoot, SecondFoot, Frequency);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeMachine(int32 StartPosition, int32 EndPosition, int32 FirstFoot,
+                                                int32 LasFoot, float Frequency, float Period)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndPosition)) EndPosition = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(FirstFoot)) FirstFoot = 1;
+	if (!FValidateHelpers::ValidateMaxPosition(LasFoot)) LasFoot = 7;
+
+	return FTriggerEffectCache::Machine(StartPosition, EndPosition, FirstFoot, LasFoot, Frequency, Period);
+}
+
+FTriggerEffectBlob UDualSenseProxy::BakeWeapon(int32 StartPosition, int32 EndPosition, int32 Strength)
+{
+	if (!FValidateHelpers::ValidateMaxPosition(StartPosition)) StartPosition = 0;
+	if (!FValidateHelpers::ValidateMaxPosition(EndPosition)) EndPosition = 8;
+	if (!FValidateHelpers::ValidateMaxPosition(Strength)) Strength = 8;
+
+	return FTriggerEffectCache::Weapon(StartPosition, EndPosition, Strength);
+}
+
 void UDualSenseProxy::NoResistance(int32 ControllerId, EControllerHand Hand)
 {
 	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
@@ -8,6 +8,7 @@
 #include "Core/DeviceRegistry.h"
 #include "Core/DualSense/DualSenseLibrary.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
+#include "Core/Structs/FMotionIntegral.h"
 
 EDeviceType USonyGamepadProxy::GetDeviceType(int32 ControllerId)
 {
@@ -167,6 +168,40 @@ void USonyGamepadProxy::EnableTouch(int32 ControllerId, bool bEnableTouch)
 	Gamepad->EnableTouch(bEnableTouch);
 }
 
+void USonyGamepadProxy::EnableTouchGestures(int32 ControllerId, bool bEnable)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->EnableTouchGestures(bEnable);
+}
+
+void USonyGamepadProxy::SetTouchGestureSettings(int32 ControllerId, const FTouchGestureSettings& Settings)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->SetTouchGestureSettings(Settings);
+}
+
 void USonyGamepadProxy::EnableGyroscopeValues(int32 ControllerId, bool bEnableGyroscope)
 {
 	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
@@ -186,6 +221,91 @@ void USonyGamepadProxy::EnableGyroscopeValues(int32 ControllerId, bool bEnableGy
 	Gamepad->EnableMotionSensor(bEnableGyroscope);
 }
 
+bool USonyGamepadProxy::GetMotionOrientation(int32 ControllerId, FRotator& Orientation)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return false;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return false;
+	}
+
+	FQuat Quat;
+	if (!Gamepad->GetMotionOrientation(Quat))
+	{
+		return false;
+	}
+
+	Orientation = Quat.Rotator();
+	return true;
+}
+
+bool USonyGamepadProxy::GetMotionDelta(int32 ControllerId, FVector& RotationDegrees, FVector& AverageAcceleration,
+                                       float& DeltaSeconds)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return false;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return false;
+	}
+
+	FMotionDelta Delta;
+	if (!Gamepad->GetMotionDelta(Delta))
+	{
+		return false;
+	}
+
+	RotationDegrees = Delta.AngleDegrees;
+	AverageAcceleration = Delta.AverageAccel;
+	DeltaSeconds = static_cast<float>(Delta.Seconds);
+	return true;
+}
+
+void USonyGamepadProxy::ResetMotionOrientation(int32 ControllerId)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->ResetMotionOrientation();
+}
+
+void USonyGamepadProxy::EnableMotionAutoCalibration(int32 ControllerId, bool bEnable)
+{
+	const FInputDeviceId DeviceId = GetGamepadInterface(ControllerId);
+	if (!DeviceId.IsValid())
+	{
+		return;
+	}
+
+	ISonyGamepadInterface* Gamepad = FDeviceRegistry::Get()->GetLibraryInstance(DeviceId);
+	if (!Gamepad)
+	{
+		return;
+	}
+
+	Gamepad->EnableMotionAutoCalibration(bEnable);
+}
+
 FInputDeviceId USonyGamepadProxy::GetGamepadInterface(int32 ControllerId)
 {
 	TArray<FInputDeviceId> Devices;
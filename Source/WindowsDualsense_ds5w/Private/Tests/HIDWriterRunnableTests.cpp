@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/HIDDeviceInfo.h"
+#include "Core/HIDWriterRunnable.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Core/Transport/LoopbackHidTransport.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHIDWriterReleaseTest,
+                                 "WindowsDualsense.Output.Writer.ReleaseWritesLastState",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FHIDWriterReleaseTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Transport =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	const FString Path = Transport->AddDevice(DualSense, Usb);
+	FHIDDeviceInfo::SetTransport(Transport);
+
+	TArray<FDeviceContext> Devices;
+	FHIDDeviceInfo::Detect(Devices);
+	if (!TestEqual(TEXT("Virtual devices detected"), Devices.Num(), 1))
+	{
+		FHIDDeviceInfo::SetTransport(nullptr);
+		return false;
+	}
+
+	FDeviceContext& Context = Devices[0];
+	Context.Handle = FHIDDeviceInfo::CreateHandle(&Context);
+
+	// The lightbar red channel follows the report id and 44 bytes of the USB report.
+	constexpr int32 LightbarRed = 45;
+	FOutputContext Output = Context.Output;
+	Output.Lightbar.R = 0x5A;
+
+	TUniquePtr<FHIDWriterRunnable> Writer =
+		MakeUnique<FHIDWriterRunnable>(Context, &FPlayStationOutputComposer::ComposeDualSense, nullptr);
+	Writer->StartThread();
+	Writer->Submit(Output);
+	FHIDWriterRunnable::Release(Writer);
+	TestFalse(TEXT("Writer released"), Writer.IsValid());
+
+	TArray<TArray<uint8>> Written;
+	Transport->ConsumeWrittenReports(Path, Written);
+	if (TestTrue(TEXT("Last state written on release"), Written.Num() >= 1))
+	{
+		TestEqual(TEXT("Last report carries the submitted state"), Written.Last()[LightbarRed], static_cast<uint8>(0x5A));
+	}
+
+	FHIDDeviceInfo::InvalidateHandle(&Context);
+	FHIDDeviceInfo::SetTransport(nullptr);
+	return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && PLATFORM_LINUX
+
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+#include "Core/Transport/HidrawPollReader.h"
+
+namespace
+{
+	/**
+	 * Records every report delivered by the shared reader, and the thread it came from.
+	 */
+	class FRecordingSink final : public IHidReportSink
+	{
+	public:
+		virtual unsigned char* GetReportBuffer(size_t& OutLength) override
+		{
+			OutLength = sizeof(Buffer);
+			return Buffer;
+		}
+
+		virtual void OnReport(const size_t BytesRead) override
+		{
+			FScopeLock ScopeLock(&Lock);
+			Reports.Emplace(Buffer, static_cast<int32>(BytesRead));
+			ThreadId = FPlatformTLS::GetCurrentThreadId();
+		}
+
+		virtual void OnDisconnected() override
+		{
+			bDisconnected = true;
+		}
+
+		int32 NumReports() const
+		{
+			FScopeLock ScopeLock(&Lock);
+			return Reports.Num();
+		}
+
+		mutable FCriticalSection Lock;
+		TArray<TArray<uint8>> Reports;
+		uint32 ThreadId = 0;
+		std::atomic_bool bDisconnected{false};
+
+	private:
+		unsigned char Buffer[78] = {};
+	};
+
+	/**
+	 * Hands out an invalid buffer, so every read of its descriptor fails without a disconnection.
+	 */
+	class FFailingSink final : public IHidReportSink
+	{
+	public:
+		virtual unsigned char* GetReportBuffer(size_t& OutLength) override
+		{
+			OutLength = 78;
+			return nullptr;
+		}
+
+		virtual void OnReport(const size_t BytesRead) override
+		{
+		}
+
+		virtual void OnDisconnected() override
+		{
+			bDisconnected = true;
+		}
+
+		std::atomic_bool bDisconnected{false};
+	};
+
+	/**
+	 * Waits on the calling thread until the condition holds or two seconds have passed.
+	 */
+	template <typename ConditionType>
+	bool WaitFor(ConditionType Condition)
+	{
+		const double Deadline = FPlatformTime::Seconds() + 2.0;
+		while (!Condition())
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		return true;
+	}
+
+	void WriteReport(const int Fd, const uint8 Id, const uint8 Value)
+	{
+		const uint8 Report[2] = {Id, Value};
+		const ssize_t Written = write(Fd, Report, sizeof(Report));
+		(void)Written;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHidrawPollReaderRoutesReportsTest,
+                                 "WindowsDualsense.Transport.Hidraw.PollReaderRoutesReports",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FHidrawPollReaderRoutesReportsTest::RunTest(const FString& Parameters)
+{
+	// Sequenced packet sockets keep every write a separate report, like hidraw nodes.
+	int First[2];
+	int Second[2];
+	if (!TestTrue(TEXT("Sockets created"), socketpair(AF_UNIX, SOCK_SEQPACKET, 0, First) == 0 &&
+	              socketpair(AF_UNIX, SOCK_SEQPACKET, 0, Second) == 0))
+	{
+		return false;
+	}
+	fcntl(First[0], F_SETFL, fcntl(First[0], F_GETFL) | O_NONBLOCK);
+	fcntl(Second[0], F_SETFL, fcntl(Second[0], F_GETFL) | O_NONBLOCK);
+
+	FRecordingSink FirstSink;
+	FRecordingSink SecondSink;
+	{
+		FHidrawPollReader Reader;
+		if (!TestTrue(TEXT("Shared reader started"), Reader.StartThread()))
+		{
+			for (const int Fd : {First[0], First[1], Second[0], Second[1]})
+			{
+				close(Fd);
+			}
+			return false;
+		}
+		Reader.Add(First[0], FirstSink);
+		Reader.Add(Second[0], SecondSink);
+
+		WriteReport(First[1], 0x01, 1);
+		WriteReport(Second[1], 0x31, 2);
+		WriteReport(First[1], 0x01, 3);
+
+		TestTrue(TEXT("Every report delivered"), WaitFor([&]()
+		{
+			return FirstSink.NumReports() == 2 && SecondSink.NumReports() == 1;
+		}));
+		{
+			FScopeLock FirstLock(&FirstSink.Lock);
+			FScopeLock SecondLock(&SecondSink.Lock);
+			if (FirstSink.Reports.Num() == 2 && SecondSink.Reports.Num() == 1)
+			{
+				TestEqual(TEXT("First device, first report"), FirstSink.Reports[0][1], static_cast<uint8>(1));
+				TestEqual(TEXT("First device, second report"), FirstSink.Reports[1][1], static_cast<uint8>(3));
+				TestEqual(TEXT("Second device report id"), SecondSink.Reports[0][0], static_cast<uint8>(0x31));
+				TestEqual(TEXT("Report length"), SecondSink.Reports[0].Num(), 2);
+			}
+			TestEqual(TEXT("Both devices read by one thread"), FirstSink.ThreadId, SecondSink.ThreadId);
+		}
+
+		// Unplugging one device leaves the other one serviced.
+		close(Second[1]);
+		TestTrue(TEXT("Lost device notified"), WaitFor([&]() { return SecondSink.bDisconnected.load(); }));
+		TestEqual(TEXT("Lost device dropped"), Reader.GetNumStreams(), 1);
+
+		WriteReport(First[1], 0x01, 4);
+		TestTrue(TEXT("Remaining device still read"), WaitFor([&]() { return FirstSink.NumReports() == 3; }));
+		TestFalse(TEXT("Remaining device not notified"), FirstSink.bDisconnected.load());
+
+		Reader.Remove(First[0]);
+		TestEqual(TEXT("Removed device dropped"), Reader.GetNumStreams(), 0);
+	}
+
+	close(First[0]);
+	close(First[1]);
+	close(Second[0]);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHidrawPollReaderDropsFailingStreamTest,
+                                 "WindowsDualsense.Transport.Hidraw.PollReaderDropsFailingStream",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FHidrawPollReaderDropsFailingStreamTest::RunTest(const FString& Parameters)
+{
+	int Pair[2];
+	if (!TestTrue(TEXT("Sockets created"), socketpair(AF_UNIX, SOCK_SEQPACKET, 0, Pair) == 0))
+	{
+		return false;
+	}
+	fcntl(Pair[0], F_SETFL, fcntl(Pair[0], F_GETFL) | O_NONBLOCK);
+
+	FFailingSink Sink;
+	{
+		FHidrawPollReader Reader;
+		if (TestTrue(TEXT("Shared reader started"), Reader.StartThread()))
+		{
+			Reader.Add(Pair[0], Sink);
+
+			// The report is never consumed, so the descriptor stays readable and every read fails.
+			WriteReport(Pair[1], 0x31, 1);
+			// Failed reads are retried after a pause, so a short error does not lose the device.
+			FPlatformProcess::Sleep(0.1f);
+			TestFalse(TEXT("Failing device kept while it may recover"), Sink.bDisconnected.load());
+			TestTrue(TEXT("Failing device notified"), WaitFor([&]() { return Sink.bDisconnected.load(); }));
+			TestEqual(TEXT("Failing device dropped"), Reader.GetNumStreams(), 0);
+		}
+	}
+
+	close(Pair[0]);
+	close(Pair[1]);
+	return true;
+}
+
+#endif
@@ -0,0 +1,432 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && PLATFORM_LINUX
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <linux/input.h>
+#include <linux/uhid.h>
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Core/PlayStationCrc32.h"
+#include "Core/Transport/LinuxHidrawTransport.h"
+
+namespace
+{
+	/**
+	 * Vendor-defined descriptor declaring the reports of both connections: input 0x01 and
+	 * output 0x02 over USB, input and output 0x31 over Bluetooth, and the 0x05 feature report.
+	 */
+	constexpr uint8 ReportDescriptor[] = {
+		0x06, 0x00, 0xFF, // Usage Page (Vendor Defined 0xFF00)
+		0x09, 0x01, // Usage (0x01)
+		0xA1, 0x01, // Collection (Application)
+		0x15, 0x00, //   Logical Minimum (0)
+		0x26, 0xFF, 0x00, //   Logical Maximum (255)
+		0x75, 0x08, //   Report Size (8)
+		0x85, 0x01, 0x95, 0x3F, 0x09, 0x01, 0x81, 0x02, //   Input 0x01, 63 bytes
+		0x85, 0x31, 0x95, 0x4D, 0x09, 0x01, 0x81, 0x02, //   Input 0x31, 77 bytes
+		0x85, 0x02, 0x95, 0x2F, 0x09, 0x01, 0x91, 0x02, //   Output 0x02, 47 bytes
+		0x85, 0x31, 0x95, 0x4D, 0x09, 0x01, 0x91, 0x02, //   Output 0x31, 77 bytes
+		0x85, 0x05, 0x95, 0x28, 0x09, 0x01, 0xB1, 0x02, //   Feature 0x05, 40 bytes
+		0xC0 // End Collection
+	};
+
+	/**
+	 * Waits on the calling thread until the condition holds or the timeout has passed.
+	 */
+	template <typename ConditionType>
+	bool WaitFor(ConditionType Condition, const double TimeoutSeconds = 2.0)
+	{
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (!Condition())
+		{
+			if (FPlatformTime::Seconds() >= Deadline)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.01f);
+		}
+		return true;
+	}
+
+	/**
+	 * Reads the `HID_NAME` entry of the uevent of the device behind a `/dev/hidrawN` path.
+	 */
+	FString ReadHidName(const TCHAR* DevicePath)
+	{
+		const FString NodeName = FPaths::GetCleanFilename(DevicePath);
+		char UeventPath[300];
+		snprintf(UeventPath, sizeof(UeventPath), "/sys/class/hidraw/%s/device/uevent", TCHAR_TO_UTF8(*NodeName));
+
+		FILE* Uevent = fopen(UeventPath, "r");
+		if (!Uevent)
+		{
+			return FString();
+		}
+
+		FString Name;
+		char Line[256];
+		while (fgets(Line, sizeof(Line), Uevent))
+		{
+			if (strncmp(Line, "HID_NAME=", 9) == 0)
+			{
+				Name = FString(UTF8_TO_TCHAR(Line + 9)).TrimEnd();
+				break;
+			}
+		}
+		fclose(Uevent);
+		return Name;
+	}
+
+	/**
+	 * Seals a Bluetooth report of the given length with the CRC32 of its header byte and payload.
+	 */
+	void WriteCrc(unsigned char* Report, const size_t Length, const uint8 Header)
+	{
+		const uint32 Crc = FPlayStationCrc32::Finalize(FPlayStationCrc32::Update(
+			FPlayStationCrc32::UpdateByte(FPlayStationCrc32::InitialState, Header), Report, Length - 4));
+		Report[Length - 4] = static_cast<unsigned char>(Crc);
+		Report[Length - 3] = static_cast<unsigned char>(Crc >> 8);
+		Report[Length - 2] = static_cast<unsigned char>(Crc >> 16);
+		Report[Length - 1] = static_cast<unsigned char>(Crc >> 24);
+	}
+
+	/**
+	 * A DualSense emulated through `/dev/uhid`.
+	 *
+	 * The kernel exposes it through a hidraw node like a physical controller. A thread answers
+	 * the feature requests sent to it, by the transport or by a kernel driver bound to it, and
+	 * records every output report written to it.
+	 */
+	class FUhidDualSense final : public FRunnable
+	{
+	public:
+		explicit FUhidDualSense(const EDeviceConnection InConnectionType):
+			ConnectionType(InConnectionType),
+			Fd(open("/dev/uhid", O_RDWR | O_NONBLOCK | O_CLOEXEC)),
+			Thread(nullptr),
+			bStopRequested(false),
+			FeatureRequests(0)
+		{
+		}
+
+		virtual ~FUhidDualSense() override
+		{
+			Destroy();
+			bStopRequested.store(true, std::memory_order_relaxed);
+			if (Thread)
+			{
+				Thread->WaitForCompletion();
+				delete Thread;
+				Thread = nullptr;
+			}
+			if (Fd >= 0)
+			{
+				close(Fd);
+			}
+		}
+
+		bool IsAvailable() const
+		{
+			return Fd >= 0;
+		}
+
+		/**
+		 * Starts answering requests and asks the kernel to create the device.
+		 */
+		bool Create(const FString& InName)
+		{
+			Name = InName;
+			Thread = FRunnableThread::Create(this, TEXT("FUhidDualSense"));
+			if (!Thread)
+			{
+				return false;
+			}
+
+			uhid_event Event = {};
+			Event.type = UHID_CREATE2;
+			FCStringAnsi::Strncpy(reinterpret_cast<char*>(Event.u.create2.name), TCHAR_TO_UTF8(*Name),
+			                      sizeof(Event.u.create2.name));
+			Event.u.create2.rd_size = sizeof(ReportDescriptor);
+			Event.u.create2.bus = ConnectionType == Bluetooth ? BUS_BLUETOOTH : BUS_USB;
+			Event.u.create2.vendor = 0x054C;
+			Event.u.create2.product = 0x0CE6;
+			FMemory::Memcpy(Event.u.create2.rd_data, ReportDescriptor, sizeof(ReportDescriptor));
+			return write(Fd, &Event, sizeof(Event)) == sizeof(Event);
+		}
+
+		/**
+		 * Removes the device, which hangs up every descriptor opened on its hidraw node.
+		 */
+		void Destroy()
+		{
+			if (Fd >= 0 && !bDestroyed)
+			{
+				uhid_event Event = {};
+				Event.type = UHID_DESTROY;
+				const ssize_t Written = write(Fd, &Event, sizeof(Event));
+				(void)Written;
+				bDestroyed = true;
+			}
+		}
+
+		bool SendInput(const unsigned char* Report, const size_t Length) const
+		{
+			uhid_event Event = {};
+			Event.type = UHID_INPUT2;
+			Event.u.input2.size = static_cast<uint16>(Length);
+			FMemory::Memcpy(Event.u.input2.data, Report, Length);
+			return write(Fd, &Event, sizeof(Event)) == sizeof(Event);
+		}
+
+		/**
+		 * Whether an output report with exactly these bytes was written to the device.
+		 */
+		bool ReceivedOutput(const TArray<uint8>& Report) const
+		{
+			FScopeLock ScopeLock(&Lock);
+			return Outputs.Contains(Report);
+		}
+
+		uint32 GetFeatureRequests() const
+		{
+			return FeatureRequests.load(std::memory_order_acquire);
+		}
+
+		virtual uint32 Run() override
+		{
+			pollfd Descriptor = {Fd, POLLIN, 0};
+			while (!bStopRequested.load(std::memory_order_relaxed))
+			{
+				Descriptor.revents = 0;
+				if (poll(&Descriptor, 1, 20) <= 0)
+				{
+					continue;
+				}
+
+				uhid_event Event;
+				if (read(Fd, &Event, sizeof(Event)) <= 0)
+				{
+					continue;
+				}
+
+				if (Event.type == UHID_OUTPUT)
+				{
+					FScopeLock ScopeLock(&Lock);
+					Outputs.Emplace(Event.u.output.data, Event.u.output.size);
+				}
+				else if (Event.type == UHID_GET_REPORT)
+				{
+					ReplyToGetReport(Event.u.get_report.id, Event.u.get_report.rnum);
+				}
+				else if (Event.type == UHID_SET_REPORT)
+				{
+					uhid_event Reply = {};
+					Reply.type = UHID_SET_REPORT_REPLY;
+					Reply.u.set_report_reply.id = Event.u.set_report.id;
+					const ssize_t Written = write(Fd, &Reply, sizeof(Reply));
+					(void)Written;
+				}
+			}
+			return 0;
+		}
+
+	private:
+		/**
+		 * Answers with a zeroed feature report of the size the DualSense uses for that id,
+		 * sealed with its CRC over Bluetooth as drivers expect.
+		 */
+		void ReplyToGetReport(const uint32 Id, const uint8 ReportId)
+		{
+			uint16 Size = 64;
+			if (ReportId == 0x05)
+			{
+				Size = 41;
+			}
+			else if (ReportId == 0x09)
+			{
+				Size = 20;
+			}
+
+			uhid_event Reply = {};
+			Reply.type = UHID_GET_REPORT_REPLY;
+			Reply.u.get_report_reply.id = Id;
+			Reply.u.get_report_reply.size = Size;
+			Reply.u.get_report_reply.data[0] = ReportId;
+			if (ConnectionType == Bluetooth)
+			{
+				WriteCrc(Reply.u.get_report_reply.data, Size, 0xA3);
+			}
+			const ssize_t Written = write(Fd, &Reply, sizeof(Reply));
+			(void)Written;
+
+			if (ReportId == 0x05)
+			{
+				FeatureRequests.fetch_add(1, std::memory_order_release);
+			}
+		}
+
+		EDeviceConnection ConnectionType;
+		FString Name;
+		int Fd;
+		FRunnableThread* Thread;
+		std::atomic_bool bStopRequested;
+		bool bDestroyed = false;
+		std::atomic<uint32> FeatureRequests;
+		mutable FCriticalSection Lock;
+		TArray<TArray<uint8>> Outputs;
+	};
+
+	/**
+	 * Drives detection, output, pings and a stream read of the transport against a virtual
+	 * DualSense on the given connection.
+	 */
+	bool TestVirtualDualSense(FAutomationTestBase& Test, const EDeviceConnection ConnectionType)
+	{
+		FUhidDualSense Device(ConnectionType);
+		if (!Device.IsAvailable())
+		{
+			Test.AddInfo(TEXT("Skipped: /dev/uhid is not accessible."));
+			return true;
+		}
+
+		const FString Name = FString::Printf(TEXT("WindowsDualsense uhid test %d"), FPlatformProcess::GetCurrentProcessId());
+		if (!Test.TestTrue(TEXT("Virtual device created"), Device.Create(Name)))
+		{
+			return false;
+		}
+
+		FLinuxHidrawTransport Transport;
+		FDeviceContext Context = {};
+		const bool bDetected = WaitFor([&]()
+		{
+			TArray<FDeviceContext> Devices;
+			Transport.Detect(Devices);
+			for (const FDeviceContext& Candidate : Devices)
+			{
+				if (ReadHidName(Candidate.Path) == Name)
+				{
+					Context = Candidate;
+					return true;
+				}
+			}
+			return false;
+		}, 5.0);
+		if (!bDetected)
+		{
+			// The hidraw node may not be readable by this user, or a kernel driver rejected the device.
+			Test.AddWarning(TEXT("Skipped: the virtual controller was not detected through hidraw."));
+			return true;
+		}
+
+		Test.TestTrue(TEXT("Detected as a DualSense"), Context.DeviceType == DualSense);
+		Test.TestTrue(TEXT("Connection type"), Context.ConnectionType == ConnectionType);
+
+		const bool bBluetooth = ConnectionType == Bluetooth;
+		const uint32 FeatureRequestsBeforeOpen = Device.GetFeatureRequests();
+		void* Handle = Transport.Open(Context);
+		if (!Test.TestTrue(TEXT("Device opened"), Handle != IHidTransport::InvalidHandle()))
+		{
+			return false;
+		}
+		if (bBluetooth)
+		{
+			Test.TestTrue(TEXT("Full reports requested on open"), Device.GetFeatureRequests() > FeatureRequestsBeforeOpen);
+		}
+		Test.TestTrue(TEXT("Ping while connected"), Transport.Ping(Handle) == EPollResult::ReadOk);
+
+		TArray<uint8> Output;
+		Output.SetNumZeroed(bBluetooth ? 78 : 48);
+		Output[0] = bBluetooth ? 0x31 : 0x02;
+		Output[bBluetooth ? 3 : 2] = 0xAB;
+		Test.TestTrue(TEXT("Output report written"), Transport.Write(Handle, Output.GetData(), Output.Num()));
+		Test.TestTrue(TEXT("Output report received by the device"), WaitFor([&]() { return Device.ReceivedOutput(Output); }));
+
+		void* Reader = Transport.OpenReader(Context);
+		if (Test.TestNotNull(TEXT("Read stream opened"), Reader))
+		{
+			unsigned char Input[78] = {};
+			const size_t InputLength = bBluetooth ? 78 : 64;
+			Input[0] = bBluetooth ? 0x31 : 0x01;
+			Input[bBluetooth ? 2 : 1] = 0xC0;
+			if (bBluetooth)
+			{
+				WriteCrc(Input, InputLength, 0xA1);
+			}
+			Test.TestTrue(TEXT("Input report sent"), Device.SendInput(Input, InputLength));
+
+			// Cancels the read if the report never arrives, so a failure cannot hang the test.
+			FEvent* ReadDone = FPlatformProcess::GetSynchEventFromPool(true);
+			TFuture<void> Watchdog = Async(EAsyncExecution::Thread, [&Transport, Reader, ReadDone]()
+			{
+				if (!ReadDone->Wait(FTimespan::FromSeconds(2.0)))
+				{
+					Transport.CancelRead(Reader);
+				}
+			});
+
+			unsigned char Buffer[78] = {};
+			size_t BytesRead = 0;
+			const EPollResult Result = Transport.ReadReport(Reader, Buffer, sizeof(Buffer), BytesRead);
+			ReadDone->Trigger();
+			Watchdog.Wait();
+			FPlatformProcess::ReturnSynchEventToPool(ReadDone);
+
+			if (Test.TestTrue(TEXT("Input report read"), Result == EPollResult::ReadOk))
+			{
+				Test.TestEqual(TEXT("Input report length"), static_cast<int32>(BytesRead), static_cast<int32>(InputLength));
+				Test.TestEqual(TEXT("Input report id"), static_cast<uint8>(Buffer[0]), static_cast<uint8>(Input[0]));
+				Test.TestEqual(TEXT("Input report payload"), static_cast<uint8>(Buffer[bBluetooth ? 2 : 1]),
+				               static_cast<uint8>(0xC0));
+			}
+
+			Transport.CancelRead(Reader);
+			Test.TestTrue(TEXT("Cancelled read"),
+			              Transport.ReadReport(Reader, Buffer, sizeof(Buffer), BytesRead) == EPollResult::NoIoThisTick);
+			Transport.CloseReader(Reader);
+		}
+
+		Device.Destroy();
+		Test.TestTrue(TEXT("Ping after removal"), WaitFor([&]() { return Transport.Ping(Handle) == EPollResult::Disconnected; }));
+		Transport.Close(Handle);
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHidrawTransportUsbDeviceTest,
+                                 "WindowsDualsense.Transport.Hidraw.UhidUsbDualSense",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FHidrawTransportUsbDeviceTest::RunTest(const FString& Parameters)
+{
+	return TestVirtualDualSense(*this, Usb);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHidrawTransportBluetoothDeviceTest,
+                                 "WindowsDualsense.Transport.Hidraw.UhidBluetoothDualSense",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FHidrawTransportBluetoothDeviceTest::RunTest(const FString& Parameters)
+{
+	return TestVirtualDualSense(*this, Bluetooth);
+}
+
+#endif
@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Core/HIDDeviceInfo.h"
+#include "Core/DualSense/DualSenseLibrary.h"
+#include "Core/GamepadButtons.h"
+#include "Core/PlayStationInputDecoder.h"
+#include "Core/Structs/FGamepadState.h"
+#include "Core/Structs/FInputReportHistory.h"
+#include "Core/Transport/LoopbackHidTransport.h"
+
+namespace
+{
+	/**
+	 * Counts the button events sent by the library.
+	 */
+	class FRecordingMessageHandler final : public FGenericApplicationMessageHandler
+	{
+	public:
+		virtual bool OnControllerButtonPressed(FGamepadKeyNames::Type KeyName, FPlatformUserId PlatformUserId,
+		                                       FInputDeviceId InputDeviceId, bool IsRepeat) override
+		{
+			Pressed.Add(KeyName);
+			return true;
+		}
+
+		virtual bool OnControllerButtonReleased(FGamepadKeyNames::Type KeyName, FPlatformUserId PlatformUserId,
+		                                        FInputDeviceId InputDeviceId, bool IsRepeat) override
+		{
+			Released.Add(KeyName);
+			return true;
+		}
+
+		TArray<FName> Pressed;
+		TArray<FName> Released;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoopbackBluetoothReportReachesLibraryTest,
+                                 "WindowsDualsense.Transport.Loopback.BluetoothReportReachesLibrary",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FLoopbackBluetoothReportReachesLibraryTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Transport =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	Transport->AddDevice(DualSense, Bluetooth, 0.0f);
+	FHIDDeviceInfo::SetTransport(Transport);
+
+	TArray<FDeviceContext> Devices;
+	FHIDDeviceInfo::Detect(Devices);
+	if (!TestEqual(TEXT("Virtual devices detected"), Devices.Num(), 1))
+	{
+		FHIDDeviceInfo::SetTransport(nullptr);
+		return false;
+	}
+
+	FDeviceContext& Context = Devices[0];
+	Context.Handle = FHIDDeviceInfo::CreateHandle(&Context);
+
+	UDualSenseLibrary* Library = NewObject<UDualSenseLibrary>();
+	Library->InitializeLibrary(Context);
+	Library->EnableMessageHandlerDispatch(false);
+
+	const TSharedRef<FGenericApplicationMessageHandler> MessageHandler = MakeShared<FGenericApplicationMessageHandler>();
+	const FInputReportHistory* History = Library->GetInputReportHistory();
+	const double Deadline = FPlatformTime::Seconds() + 2.0;
+	while (History && History->Num() == 0 && FPlatformTime::Seconds() < Deadline)
+	{
+		Library->UpdateInput(MessageHandler, FPlatformUserId(), FInputDeviceId());
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	if (TestTrue(TEXT("A Bluetooth report reached the library"), History && History->Num() > 0))
+	{
+		TestEqual(TEXT("Report id"), History->GetFromNewest(0).Data[0], static_cast<uint8>(0x31));
+	}
+	TestEqual(TEXT("Reports discarded for their CRC"), Library->GetCrcFailures(), static_cast<uint64>(0));
+
+	Library->ShutdownLibrary();
+	FHIDDeviceInfo::SetTransport(nullptr);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoopbackHeldInputReachesGamepadStateTest,
+                                 "WindowsDualsense.Transport.Loopback.HeldInputReachesGamepadState",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FLoopbackHeldInputReachesGamepadStateTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Transport =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	Transport->AddDevice(DualSense, Bluetooth, 500.0f);
+	// Every report holds Cross with the left stick halfway to the right.
+	Transport->SetReportGenerator([](const FString&, uint64, unsigned char* Report, const size_t Length)
+	{
+		unsigned char* Payload = Report + FDualSenseBluetoothReportLayout::Padding;
+		Payload[FDualSenseBluetoothReportLayout::LeftStickX] = 0xC0;
+		Payload[FDualSenseBluetoothReportLayout::Buttons] = 0x20 | 0x08;
+	});
+	FHIDDeviceInfo::SetTransport(Transport);
+
+	TArray<FDeviceContext> Devices;
+	FHIDDeviceInfo::Detect(Devices);
+	if (!TestEqual(TEXT("Virtual devices detected"), Devices.Num(), 1))
+	{
+		FHIDDeviceInfo::SetTransport(nullptr);
+		return false;
+	}
+
+	FDeviceContext& Context = Devices[0];
+	Context.Handle = FHIDDeviceInfo::CreateHandle(&Context);
+
+	UDualSenseLibrary* Library = NewObject<UDualSenseLibrary>();
+	Library->InitializeLibrary(Context);
+
+	const TSharedRef<FRecordingMessageHandler> MessageHandler = MakeShared<FRecordingMessageHandler>();
+	FGamepadState State = {};
+	const double Deadline = FPlatformTime::Seconds() + 2.0;
+	while (!Library->GetGamepadState(State) && FPlatformTime::Seconds() < Deadline)
+	{
+		Library->UpdateInput(MessageHandler, FPlatformUserId(), FInputDeviceId());
+		FPlatformProcess::Sleep(0.005f);
+	}
+
+	// Keep ticking while new reports arrive, each one still holding the button.
+	for (int32 Tick = 0; Tick < 10; ++Tick)
+	{
+		FPlatformProcess::Sleep(0.005f);
+		Library->UpdateInput(MessageHandler, FPlatformUserId(), FInputDeviceId());
+	}
+
+	if (TestTrue(TEXT("Gamepad state available"), Library->GetGamepadState(State)))
+	{
+		TestEqual(TEXT("Left stick X"), State.LeftAnalogX, 0.5f);
+		TestEqual(TEXT("Left stick Y"), State.LeftAnalogY, 0.0f, 1.0f / 128.0f);
+		TestEqual(TEXT("Cross held"), State.Buttons, 1u << FGamepadButtons::Cross);
+	}
+	TestEqual(TEXT("Cross pressed once"), MessageHandler->Pressed.Num(), 1);
+	TestEqual(TEXT("Pressed key"), MessageHandler->Pressed.Num() > 0 ? MessageHandler->Pressed[0] : NAME_None,
+	          FName(FGamepadKeyNames::FaceButtonBottom));
+	TestEqual(TEXT("Releases while held"), MessageHandler->Released.Num(), 0);
+
+	Library->ShutdownLibrary();
+	FHIDDeviceInfo::SetTransport(nullptr);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLoopbackDeviceKeepsItsTransportTest,
+                                 "WindowsDualsense.Transport.Loopback.DeviceKeepsItsTransport",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FLoopbackDeviceKeepsItsTransportTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Transport =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	const FString Path = Transport->AddDevice(DualSense, Usb);
+	FHIDDeviceInfo::SetTransport(Transport);
+
+	TArray<FDeviceContext> Devices;
+	FHIDDeviceInfo::Detect(Devices);
+	if (!TestEqual(TEXT("Virtual devices detected"), Devices.Num(), 1))
+	{
+		FHIDDeviceInfo::SetTransport(nullptr);
+		return false;
+	}
+
+	FDeviceContext& Context = Devices[0];
+	Context.Handle = FHIDDeviceInfo::CreateHandle(&Context);
+	Context.IsConnected = true;
+
+	// Another transport installed while the device is open must not receive its I/O.
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Replacement =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	FHIDDeviceInfo::SetTransport(Replacement);
+
+	FHIDDeviceInfo::Write(&Context);
+	TArray<TArray<uint8>> Written;
+	TestEqual(TEXT("Reports written through the owning transport"), Transport->ConsumeWrittenReports(Path, Written), 1);
+	TestTrue(TEXT("Device still connected"), Context.IsConnected);
+
+	FHIDDeviceInfo::InvalidateHandle(&Context);
+	TestFalse(TEXT("Transport released with the handle"), Context.Transport.IsValid());
+
+	FHIDDeviceInfo::SetTransport(nullptr);
+	return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/MotionBatch.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	/**
+	 * Adds devices with random readings, biases and dead zones in the ranges of a real controller.
+	 */
+	void AddRandomDevices(FMotionBatch& Batch, FRandomStream& Random, const int32 NumDevices)
+	{
+		const auto RandomVector = [&Random](const float Range)
+		{
+			return FVector(Random.FRandRange(-Range, Range), Random.FRandRange(-Range, Range),
+			               Random.FRandRange(-Range, Range));
+		};
+
+		for (int32 Device = 0; Device < NumDevices; ++Device)
+		{
+			Batch.Add(RandomVector(2000.0f), RandomVector(8192.0f), RandomVector(40.0f), RandomVector(200.0f),
+			          RandomVector(30.0f).GetAbs(), RandomVector(400.0f).GetAbs());
+		}
+	}
+
+	/**
+	 * Runs both kernels over the batch and checks that every slot holds the same results.
+	 */
+	void TestKernelsMatch(FAutomationTestBase& Test, FMotionBatch& Batch, const TCHAR* What)
+	{
+		Batch.ProcessScalar();
+		TArray<FVector> Expected;
+		for (int32 Slot = 0; Slot < Batch.Num(); ++Slot)
+		{
+			Expected.Add(Batch.GetGyro(Slot));
+			Expected.Add(Batch.GetAccel(Slot));
+		}
+
+		Batch.Process();
+		for (int32 Slot = 0; Slot < Batch.Num(); ++Slot)
+		{
+			Test.TestEqual(FString::Printf(TEXT("%s, gyroscope of slot %d"), What, Slot), Batch.GetGyro(Slot),
+			               Expected[Slot * 2], 0.0);
+			Test.TestEqual(FString::Printf(TEXT("%s, accelerometer of slot %d"), What, Slot), Batch.GetAccel(Slot),
+			               Expected[Slot * 2 + 1], 0.0);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMotionBatchKernelsMatchTest,
+                                 "WindowsDualsense.Motion.Batch.VectorKernelMatchesScalar",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FMotionBatchKernelsMatchTest::RunTest(const FString& Parameters)
+{
+	FMotionBatch Batch;
+	FRandomStream Random(0x05D5);
+
+	// Seven devices: the second group of lanes has one padding lane.
+	AddRandomDevices(Batch, Random, 7);
+	TestEqual(TEXT("Devices added"), Batch.Num(), 7);
+	TestKernelsMatch(*this, Batch, TEXT("Seven devices"));
+
+	// Bias corrected, then dead-zoned per axis.
+	Batch.Reset();
+	const int32 Slot = Batch.Add(FVector(120.0, 8.0, -40.0), FVector(100.0, 8300.0, 0.0), FVector(10.0),
+	                             FVector(0.0, 8192.0, 0.0), FVector(5.0), FVector(50.0));
+	TestEqual(TEXT("Slots restart after a reset"), Slot, 0);
+	TestKernelsMatch(*this, Batch, TEXT("One device"));
+	TestEqual(TEXT("Gyroscope corrected"), Batch.GetGyro(Slot), FVector(110.0, 0.0, -50.0), 0.0);
+	TestEqual(TEXT("Accelerometer corrected"), Batch.GetAccel(Slot), FVector(100.0, 108.0, 0.0), 0.0);
+
+	// Five devices reuse the storage of seven: the lanes of the stale devices are padding now.
+	Batch.Reset();
+	AddRandomDevices(Batch, Random, 5);
+	TestKernelsMatch(*this, Batch, TEXT("Five devices after a reset"));
+	for (int32 Padding = Batch.Num(); Padding < Align(Batch.Num(), FMotionBatch::Lanes); ++Padding)
+	{
+		// Storage is allocated up to the end of the group, so the padding lanes can be read back.
+		TestEqual(FString::Printf(TEXT("Padding lane %d gyroscope cleared"), Padding), Batch.GetGyro(Padding),
+		          FVector::ZeroVector, 0.0);
+		TestEqual(FString::Printf(TEXT("Padding lane %d accelerometer cleared"), Padding), Batch.GetAccel(Padding),
+		          FVector::ZeroVector, 0.0);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/MotionCalibrator.h"
+
+namespace
+{
+	/**
+	 * Feeds a constant gyroscope reading, with the controller lying flat, for the given duration
+	 * at 250 Hz.
+	 *
+	 * @return The number of stillness calibrations produced.
+	 */
+	int32 FeedConstantRate(FMotionCalibrator& Calibrator, const int16 X, const int16 Y, const int16 Z,
+	                       const double Seconds, FMotionCalibration& OutLast)
+	{
+		const int16 Gyro[3] = {X, Y, Z};
+		const int16 Accel[3] = {0, 8192, 0};
+		constexpr double Step = 1.0 / 250.0;
+
+		int32 Results = 0;
+		for (double Elapsed = 0.0; Elapsed < Seconds; Elapsed += Step)
+		{
+			FMotionCalibration Result;
+			if (Calibrator.Add(Gyro, Accel, Step, Result))
+			{
+				OutLast = Result;
+				++Results;
+			}
+		}
+		return Results;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMotionCalibratorSteadyRotationTest,
+                                 "WindowsDualsense.Motion.Calibrator.SteadyRotationIsNotABias",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FMotionCalibratorSteadyRotationTest::RunTest(const FString& Parameters)
+{
+	FMotionCalibrator Calibrator;
+	FMotionCalibration Last;
+
+	// About 12 degrees per second, perfectly steady: well within the stillness band, but no bias.
+	TestEqual(TEXT("Steady rotation before the first calibration"),
+	          FeedConstantRate(Calibrator, 200, 0, 0, 4.0, Last), 0);
+
+	TestTrue(TEXT("Rest measured"), FeedConstantRate(Calibrator, 5, -3, 2, 2.0, Last) > 0);
+	TestEqual(TEXT("Measured bias"), Last.GyroMean, FVector(5.0, -3.0, 2.0));
+
+	// About 2.5 degrees per second away from the known bias.
+	TestEqual(TEXT("Steady rotation after a calibration"),
+	          FeedConstantRate(Calibrator, 45, -3, 2, 4.0, Last), 0);
+
+	TestTrue(TEXT("Slight drift of the bias followed"), FeedConstantRate(Calibrator, 8, -3, 2, 2.0, Last) > 0);
+	TestEqual(TEXT("Drifted bias"), Last.GyroMean, FVector(8.0, -3.0, 2.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/TriggerEffectCache.h"
+#include "Core/Structs/FOutputContext.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTriggerEffectApplyKeepsUnusedFieldsTest,
+                                 "WindowsDualsense.Output.TriggerEffectCache.ApplyKeepsUnusedFields",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FTriggerEffectApplyKeepsUnusedFieldsTest::RunTest(const FString& Parameters)
+{
+	// As left by SetHapticFeedback, which only sets the frequency.
+	FHapticTriggers Trigger;
+	Trigger.Frequency = 0x42;
+	Trigger.Strengths.Period = 0x07;
+	Trigger.Strengths.TimeAndRatio = 0x15;
+
+	const FTriggerEffectBlob Weapon = FTriggerEffectCache::Weapon(2, 6, 8);
+	FTriggerEffectCache::Apply(Weapon, Trigger);
+	TestEqual(TEXT("Weapon mode"), Trigger.Mode, static_cast<unsigned char>(0x25));
+	TestEqual(TEXT("Weapon zones"), Trigger.Strengths.ActiveZones, Weapon.Get()->Parameters.Strengths.ActiveZones);
+	TestEqual(TEXT("Frequency kept by weapon"), Trigger.Frequency, static_cast<unsigned char>(0x42));
+	TestEqual(TEXT("Period kept by weapon"), Trigger.Strengths.Period, static_cast<uint8_t>(0x07));
+	TestEqual(TEXT("Time and ratio kept by weapon"), Trigger.Strengths.TimeAndRatio, static_cast<uint32_t>(0x15));
+	TestTrue(TEXT("Weapon encoded"), Trigger.Encoded == Weapon);
+
+	const FTriggerEffectBlob Galloping = FTriggerEffectCache::Galloping(0, 9, 2, 5, 0.5f);
+	FTriggerEffectCache::Apply(Galloping, Trigger);
+	TestEqual(TEXT("Galloping frequency"), Trigger.Frequency, Galloping.Get()->Parameters.Frequency);
+	TestEqual(TEXT("Galloping time and ratio"), Trigger.Strengths.TimeAndRatio,
+	          Galloping.Get()->Parameters.Strengths.TimeAndRatio);
+	TestEqual(TEXT("Period kept by galloping"), Trigger.Strengths.Period, static_cast<uint8_t>(0x07));
+
+	FTriggerEffectCache::Apply(FTriggerEffectCache::Off(), Trigger);
+	TestEqual(TEXT("Off mode"), Trigger.Mode, static_cast<unsigned char>(0x0));
+	TestEqual(TEXT("Frequency kept by off"), Trigger.Frequency, Galloping.Get()->Parameters.Frequency);
+
+	FTriggerEffectCache::Apply(FTriggerEffectBlob(), Trigger);
+	TestEqual(TEXT("Empty effect ignored"), Trigger.Mode, static_cast<unsigned char>(0x0));
+	return true;
+}
+
+#endif
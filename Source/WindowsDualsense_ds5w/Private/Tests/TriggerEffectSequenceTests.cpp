@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Core/HIDDeviceInfo.h"
+#include "Core/HIDWriterRunnable.h"
+#include "Core/PlayStationOutputComposer.h"
+#include "Core/TriggerEffectSequence.h"
+#include "Core/Transport/LoopbackHidTransport.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTriggerEffectSequenceSingleKeyTest,
+                                 "WindowsDualsense.Output.TriggerEffectSequence.SingleKeyIsApplied",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+bool FTriggerEffectSequenceSingleKeyTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FLoopbackHidTransport, ESPMode::ThreadSafe> Transport =
+		MakeShared<FLoopbackHidTransport, ESPMode::ThreadSafe>();
+	const FString Path = Transport->AddDevice(DualSense, Usb);
+	FHIDDeviceInfo::SetTransport(Transport);
+
+	TArray<FDeviceContext> Devices;
+	FHIDDeviceInfo::Detect(Devices);
+	if (!TestEqual(TEXT("Virtual devices detected"), Devices.Num(), 1))
+	{
+		FHIDDeviceInfo::SetTransport(nullptr);
+		return false;
+	}
+
+	FDeviceContext& Context = Devices[0];
+	Context.Handle = FHIDDeviceInfo::CreateHandle(&Context);
+
+	// A single key at time zero, which does not loop: full resistance on the first zone.
+	const TSharedRef<FTriggerSequenceData, ESPMode::ThreadSafe> Sequence = MakeShared<FTriggerSequenceData, ESPMode::ThreadSafe>();
+	FTriggerSequenceData::FKey& Key = Sequence->Keys.AddZeroed_GetRef();
+	Key.Strengths[0] = 8.0f;
+
+	{
+		FHIDWriterRunnable Writer(Context, &FPlayStationOutputComposer::ComposeDualSense, nullptr);
+		Writer.StartThread();
+		Writer.PlayTriggerSequence(Sequence, EControllerHand::Right);
+
+		const double Deadline = FPlatformTime::Seconds() + 2.0;
+		while (Writer.GetWrittenCount() < 2 && FPlatformTime::Seconds() < Deadline)
+		{
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestTrue(TEXT("Key and end of the sequence written"), Writer.GetWrittenCount() >= 2);
+	}
+
+	TArray<TArray<uint8>> Written;
+	Transport->ConsumeWrittenReports(Path, Written);
+	if (TestTrue(TEXT("Reports written"), Written.Num() >= 2))
+	{
+		// The right trigger effect follows the report id and ten bytes of the USB report.
+		constexpr int32 RightTrigger = 11;
+		TestEqual(TEXT("First report carries the key"), Written[0][RightTrigger], static_cast<uint8>(0x21));
+		TestEqual(TEXT("Key zone active"), Written[0][RightTrigger + 1], static_cast<uint8>(0x01));
+		TestEqual(TEXT("Key zone strength"), Written[0][RightTrigger + 3], static_cast<uint8>(0x07));
+		TestEqual(TEXT("Trigger back to the game effect"), Written.Last()[RightTrigger], static_cast<uint8>(0x00));
+	}
+
+	FHIDDeviceInfo::InvalidateHandle(&Context);
+	FHIDDeviceInfo::SetTransport(nullptr);
+	return true;
+}
+
+#endif
@@ -8,7 +8,10 @@
 #include "InputCoreTypes.h"
 #include "Misc/Paths.h"
 #include "DeviceManager.h"
+#include "Core/HIDWriterRunnable.h"
+#if PLATFORM_WINDOWS
 #include "Microsoft/AllowMicrosoftPlatformTypes.h"
+#endif
 #include <stdio.h>
 
 #define LOCTEXT_NAMESPACE "FWindowsDualsense_ds5wModule"
@@ -21,6 +24,7 @@ void FWindowsDualsense_ds5wModule::StartupModule()
 
 void FWindowsDualsense_ds5wModule::ShutdownModule()
 {
+	FHIDWriterRunnable::ReleaseParked();
 }
 
 TSharedPtr<IInputDevice> FWindowsDualsense_ds5wModule::CreateInputDevice(
@@ -42,6 +46,15 @@ void FWindowsDualsense_ds5wModule::RegisterCustomKeys()
 	const FKey PS_FunctionR("PS_FunctionR");
 	const FKey PS_PaddleL("PS_PaddleL");
 	const FKey PS_PaddleR("PS_PaddleR");
+	const FKey PS_TouchTap("PS_TouchTap");
+	const FKey PS_TouchDoubleTap("PS_TouchDoubleTap");
+	const FKey PS_TouchSwipeLeft("PS_TouchSwipeLeft");
+	const FKey PS_TouchSwipeRight("PS_TouchSwipeRight");
+	const FKey PS_TouchSwipeUp("PS_TouchSwipeUp");
+	const FKey PS_TouchSwipeDown("PS_TouchSwipeDown");
+	const FKey PS_TouchPinch("PS_TouchPinch");
+	const FKey PS_TouchScrollX("PS_TouchScrollX");
+	const FKey PS_TouchScrollY("PS_TouchScrollY");
 
 	EKeys::AddKey(FKeyDetails(
 		PS_FunctionL,
@@ -108,6 +121,60 @@ void FWindowsDualsense_ds5wModule::RegisterCustomKeys()
 		FText::FromString("PlayStation Touchpad Button"),
 		FKeyDetails::GamepadKey
 	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchTap,
+		FText::FromString("PlayStation Touchpad Tap"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchDoubleTap,
+		FText::FromString("PlayStation Touchpad Double Tap"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchSwipeLeft,
+		FText::FromString("PlayStation Touchpad Swipe Left"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchSwipeRight,
+		FText::FromString("PlayStation Touchpad Swipe Right"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchSwipeUp,
+		FText::FromString("PlayStation Touchpad Swipe Up"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchSwipeDown,
+		FText::FromString("PlayStation Touchpad Swipe Down"),
+		FKeyDetails::GamepadKey
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchPinch,
+		FText::FromString("PlayStation Touchpad Pinch"),
+		FKeyDetails::GamepadKey | FKeyDetails::Axis1D
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchScrollX,
+		FText::FromString("PlayStation Touchpad Scroll X-Axis"),
+		FKeyDetails::GamepadKey | FKeyDetails::Axis1D
+	));
+
+	EKeys::AddKey(FKeyDetails(
+		PS_TouchScrollY,
+		FText::FromString("PlayStation Touchpad Scroll Y-Axis"),
+		FKeyDetails::GamepadKey | FKeyDetails::Axis1D
+	));
 }
 
 IMPLEMENT_MODULE(FWindowsDualsense_ds5wModule, WindowsDualsense_ds5w)
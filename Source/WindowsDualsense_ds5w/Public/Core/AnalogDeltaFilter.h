@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
+
+struct FGamepadState;
+
+/**
+ * @brief How the analog axes of a controller are forwarded to the message handler.
+ */
+struct FAnalogDispatchSettings
+{
+	/**
+	 * Axes in the order used by `Epsilon`.
+	 */
+	enum EAxis : int32
+	{
+		LeftX,
+		LeftY,
+		RightX,
+		RightY,
+		LeftTrigger,
+		RightTrigger,
+		Count
+	};
+
+	/**
+	 * When false, every axis is dispatched on every update, which is the default. When true,
+	 * an axis is only dispatched when it moved by more than its epsilon since the value last
+	 * dispatched, when it comes back to rest, or when the keep-alive interval elapsed.
+	 */
+	bool bDeltaOnly = false;
+	/**
+	 * Smallest change, per axis, that is dispatched in delta-only mode. The defaults are just
+	 * above one step of the 8-bit stick and trigger readings, which filters sensor jitter at rest.
+	 */
+	float Epsilon[Count] = {0.01f, 0.01f, 0.01f, 0.01f, 0.005f, 0.005f};
+	/**
+	 * Interval, in seconds, after which an unchanged axis is dispatched again in delta-only
+	 * mode, so consumers that sample the last event never see a stale value for long.
+	 * Zero disables the keep-alive.
+	 */
+	float KeepAliveSeconds = 0.5f;
+};
+
+/**
+ * @brief Forwards the analog axes of a controller to the message handler, optionally only on change.
+ *
+ * Each library owns one filter and calls `Dispatch` once per input update with the latest
+ * decoded state. The filter remembers the last value and time dispatched for each axis and
+ * counts dispatched and suppressed events, so the savings of delta-only mode can be checked
+ * with the `DUALSENSE ANALOG` console command or the `STAT DualSense` group.
+ *
+ * Only used from the game thread.
+ */
+class WINDOWSDUALSENSE_DS5W_API FAnalogDeltaFilter
+{
+public:
+	FAnalogDeltaFilter();
+
+	/**
+	 * Replaces the settings. The next update dispatches every axis.
+	 */
+	void Configure(const FAnalogDispatchSettings& InSettings);
+
+	const FAnalogDispatchSettings& GetSettings() const
+	{
+		return Settings;
+	}
+
+	/**
+	 * Forwards the analog axes of a decoded state according to the settings.
+	 *
+	 * @param MessageHandler The handler receiving the events.
+	 * @param UserId The platform user owning the device.
+	 * @param InputDeviceId The device the events originate from.
+	 * @param State The latest decoded state.
+	 */
+	void Dispatch(FGenericApplicationMessageHandler& MessageHandler, FPlatformUserId UserId,
+	              FInputDeviceId InputDeviceId, const FGamepadState& State);
+
+	/**
+	 * Forgets the values last dispatched, so the next update dispatches every axis.
+	 */
+	void Reset();
+
+	/**
+	 * Number of analog events sent to the message handler.
+	 */
+	uint64 GetDispatchedEvents() const
+	{
+		return DispatchedEvents;
+	}
+
+	/**
+	 * Number of analog events skipped because the axis did not move enough.
+	 */
+	uint64 GetSuppressedEvents() const
+	{
+		return SuppressedEvents;
+	}
+
+	/**
+	 * Clears the dispatched and suppressed counters.
+	 */
+	void ResetCounters()
+	{
+		DispatchedEvents = 0;
+		SuppressedEvents = 0;
+	}
+
+private:
+	FAnalogDispatchSettings Settings;
+	float LastValues[FAnalogDispatchSettings::Count];
+	uint64 LastCycles[FAnalogDispatchSettings::Count];
+	bool bHasLastValues;
+	uint64 DispatchedEvents;
+	uint64 SuppressedEvents;
+};
@@ -5,12 +5,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#if PLATFORM_WINDOWS
 #include "Windows/WindowsApplication.h"
+#endif
 #include "Async/TaskGraphInterfaces.h"
-#include "Core/HIDPollingRunnable.h"
+#include "Core/HIDWatchdogRunnable.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/RunnableThread.h"
 #include "Interfaces/SonyGamepadInterface.h"
+#include "Core/Interfaces/HidTransport.h"
+#include <atomic>
 
 /**
  * A manager class that handles the creation, storage, and lifecycle management of device library
@@ -87,10 +91,12 @@ public:
 	 */
 	void CreateLibraryInstance(FDeviceContext& Context);
 	/**
-	 * Updates the device container manager at regular intervals by processing connected and
-	 * disconnected devices. It handles device discovery, connection state updates, lifecycle
-	 * management for device libraries, and ensures proper synchronization with previously
-	 * known devices.
+	 * Updates the device container manager by processing connected and disconnected devices.
+	 * It handles device discovery, connection state updates, lifecycle management for device
+	 * libraries, and ensures proper synchronization with previously known devices.
+	 *
+	 * Enumeration only runs after the active transport reported a device arrival or removal.
+	 * When the transport cannot report hot-plug events, devices are enumerated every two seconds.
 	 *
 	 * @param DeltaTime The time in seconds since the last tick, used to accumulate time for
 	 *                  periodic processing of the device lifecycle and connection state.
@@ -108,6 +114,35 @@ private:
 	 * Used to track the ongoing state of device discovery and initialization within the device manager.
 	 */
 	bool bIsDeviceDetectionInProgress = false;
+	/**
+	 * Set when a detected device could not be opened, so enumeration is retried on the polling
+	 * interval even though no further hot-plug notification may arrive for it.
+	 */
+	bool bRetryDetection = false;
+	/**
+	 * The transport device notifications were started on, or null when enumeration falls back
+	 * to polling. Kept so notifications are stopped on the same transport they were started on.
+	 */
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe> NotificationTransport;
+	/**
+	 * The transport the registry last tried to start notifications on, so a transport that
+	 * cannot report hot-plug events is not asked again on every tick.
+	 */
+	TWeakPtr<IHidTransport, ESPMode::ThreadSafe> ObservedTransport;
+	/**
+	 * Set from the transport notification callback, on any thread, whenever a device may
+	 * have appeared or disappeared. Consumed by DetectedChangeConnections on the game thread.
+	 */
+	static std::atomic_bool bDevicesChangedPending;
+	/**
+	 * Starts device notifications on the active transport, restarting them if the transport
+	 * was replaced since the last call.
+	 */
+	void UpdateDeviceNotifications();
+	/**
+	 * Stops device notifications on the transport they were started on, if any.
+	 */
+	void StopDeviceNotifications();
 	/**
 	 * A static instance of the FDeviceRegistry, serving as the singleton instance
 	 * for managing device library instances of Sony gamepad controllers. This variable
@@ -134,9 +169,9 @@ private:
 	 */
 	static TMap<FString, FInputDeviceId> HistoryDevices;
 	/**
-	 * A static map that maintains active connections by associating unique integer identifiers with their
-	 * corresponding HID polling runnable instances. This map is used to manage and monitor ongoing input
-	 * device connection activities and ensures proper lifecycle control of the associated polling threads.
+	 * A single watchdog thread that pings every connected controller to check that it is still
+	 * reachable. Created with the first library instance and stopped when the registry is destroyed.
+	 * A failed ping schedules a new device enumeration.
 	 */
-	static TMap<int32, TUniquePtr<FHIDPollingRunnable>> ActiveConnectionWatchers;
+	static TUniquePtr<FHIDWatchdogRunnable> ConnectionWatchdog;
 };
@@ -14,6 +14,12 @@
 #include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
 #include "Core/Enums/EDeviceCommons.h"
 #include "Core/Structs/FDeviceContext.h"
+#include "Core/HIDReaderRunnable.h"
+#include "Core/HIDWriterRunnable.h"
+#include "Core/InputLatencyStats.h"
+#include "Core/PlayStationInputDecoder.h"
+#include "Core/AnalogDeltaFilter.h"
+#include "Core/TouchGestureRecognizer.h"
 #include "Core/Structs/FDeviceSettings.h"
 #include "Core/Structs/FDualSenseFeatureReport.h"
 #include "DualSenseLibrary.generated.h"
@@ -143,141 +149,6 @@ struct FTouchPoint2
 	unsigned char Id;
 };
 
-/**
- * @class FAccelerometer
- * @brief Represents an accelerometer component that tracks and provides data related to acceleration.
- *
- * The FAccelerometer class is responsible for handling acceleration readings
- * and providing utility functions to process and retrieve those readings in a
- * meaningful way. This class can be used to monitor motion in three-dimensional
- * space and calculate relevant metrics based on the gathered data.
- *
- * @details
- * The accelerometer typically measures acceleration in three axes: X, Y, and Z,
- * and provides functionality to retrieve raw acceleration values, calculate the
- * magnitude of the acceleration vector, and filter out noise or apply smoothing
- * when needed. This class can be utilized for physical simulation, motion
- * detection, or other use cases where acceleration tracking is required.
- */
-struct FAccelerometer
-{
-	/**
-	 *
-	 */
-	int16_t X;
-	/**
-	 * @brief Represents the variable Y used within the application.
-	 *
-	 * This variable serves as a placeholder for a specific purpose
-	 * depending on the context of the application. The exact use of
-	 * Y should be defined in the code implementation and may represent
-	 * a variety of data types or values depending on its usage.
-	 *
-	 * The role of Y can vary, such as acting as an input parameter,
-	 * intermediate storage, or output result. Proper initialization
-	 * and handling of this variable are essential to ensure the correctness
-	 * and reliability of the program's operations.
-	 *
-	 * Ensure that the value of Y is properly documented and updated
-	 * throughout the codebase to avoid confusion or misuse.
-	 */
-	int16_t Y;
-	/**
-	 * @brief Represents a variable named Z.
-	 *
-	 * This variable is designed to hold a specific value or data type as required
-	 * by the implementation. Its intended use and functionality should be defined
-	 * within the corresponding program or module context. The type and purpose of
-	 * this variable should align with the logic and requirements of its usage.
-	 *
-	 * Ensure that the value assigned to Z adheres to the appropriate constraints
-	 * or expectations in the application to maintain correctness and stability.
-	 */
-	int16_t Z;
-};
-
-/**
- * @class FGyro
- * @brief The FGyro class represents a gyroscopic sensor that provides data on angular velocity and orientation in three-dimensional space.
- *
- * This class models the behavior and properties of a gyroscope, commonly used in robotics, mobile devices, and game controllers for motion tracking
- * and orientation detection. The class offers functionalities to retrieve, reset, and process gyroscopic readings.
- *
- * Detailed methods and attributes allow users to interact with the gyroscope hardware or simulation to acquire real-time data for use in various applications.
- * The gyroscope data includes angular velocity along the X, Y, and Z axes, as well as possible methods for calibration.
- */
-struct FGyro
-{
-	/**
-	 * @brief Represents a variable used for general purposes within the application.
-	 *
-	 * This variable may store values of various types based on its application context,
-	 * and its purpose is defined by the implementation details of the code where it is used.
-	 *
-	 * @note Ensure to initialize and manage the value of this variable correctly to avoid
-	 * unexpected behavior or runtime errors.
-	 */
-	int16_t X;
-	/**
-	 * @brief Represents a generic variable or entity identified as 'Y'.
-	 *
-	 * @details The purpose and type of 'Y' should be defined by its context in
-	 *          the codebase. It could serve as a placeholder or functional part
-	 *          of a process and requires further clarification or initialization
-	 *          during implementation.
-	 *
-	 * @note Ensure 'Y' is properly initialized and used consistently to avoid
-	 *       unexpected behavior. Misuse of 'Y' may lead to runtime errors or
-	 *       logical inconsistencies.
-	 */
-	int16_t Y;
-	/**
-	 * @brief Represents a variable or entity denoted as Z.
-	 *
-	 * This variable may serve as a placeholder or represent a specific value,
-	 * object, or function in the given context. Ensure to initialize or define Z
-	 * appropriately before using it, based on its intended purpose.
-	 *
-	 * @note The specific use case and type of Z must be determined by its context
-	 *       within the scope of the application or module.
-	 */
-	int16_t Z;
-};
-
-USTRUCT()
-struct FSensorBounds
-{
-	GENERATED_BODY()
-	
-	UPROPERTY()
-	FVector2D Gyro_X_Bounds; // X = Min, Y = Max
-	
-	UPROPERTY()
-	FVector2D Gyro_Y_Bounds; // X = Min, Y = Max
-	
-	UPROPERTY()
-	FVector2D Gyro_Z_Bounds; // X = Min, Y = Max
-	
-	UPROPERTY()
-	FVector2D Accel_X_Bounds; // X = Min, Y = Max
-	
-	UPROPERTY()
-	FVector2D Accel_Y_Bounds; // X = Min, Y = Max
-	
-	UPROPERTY()
-	FVector2D Accel_Z_Bounds; // X = Min, Y = Max
-
-	FSensorBounds()
-	{
-		Gyro_X_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-		Gyro_Y_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-		Gyro_Z_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-		Accel_X_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-		Accel_Y_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-		Accel_Z_Bounds = FVector2D(FLT_MAX, -FLT_MAX);
-	}
-};
-
 /**
  * @class UDualSenseLibrary
  * @brief Utility class for interfacing with the PlayStation DualSense controller.
@@ -367,25 +238,26 @@ public:
 	 *
 	 * @details The method first verifies the connection status of the HID
 	 * device context. If the device is not connected, the operation is aborted.
-	 * Otherwise, it delegates the responsibility of handling the output
-	 * buffering to the appropriate manager, ensuring proper data flow to the device.
+	 * Otherwise, it hands a copy of the output state to the writer thread and returns
+	 * immediately; changes submitted within one output interval are written as a single report.
 	 */
 	virtual void SendOut() override;
 	/**
-	 * @brief Handles button input events for a DualSense controller.
+	 * @brief Dispatches the digital buttons of a single input report.
 	 *
-	 * This function checks the current state of a button on a DualSense controller and triggers
-	 * appropriate input events (button press or release) based on the change in its state.
+	 * Every report read since the previous tick goes through this function in arrival order,
+	 * so a press and release that both happen between two ticks still produce both events.
+	 * The buttons are packed into a mask and compared with the previous one; only the bits
+	 * that changed are sent to the message handler, and nothing is done when none did.
 	 *
 	 * @param InMessageHandler The message handler responsible for dispatching input events.
 	 * @param UserId The platform user ID associated with the controller.
 	 * @param InputDeviceId The unique identifier for the DualSense input device.
-	 * @param ButtonName The name of the button being checked.
-	 * @param IsButtonPressed A boolean indicating the current pressed state of the button (true if pressed, false otherwise).
+	 * @param Buttons The buttons decoded from the report, as laid out by FGamepadButtons.
 	 */
-	virtual void CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-								  const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-								  const FName ButtonName, const bool IsButtonPressed);
+	void DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+						 const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+						 const uint32 Buttons);
 	/**
 	 * @brief Updates the input state for a DualSense device.
 	 *
@@ -410,6 +282,89 @@ public:
 	{
 		return LevelBattery;
 	}
+	/**
+	 * Retrieves the recent raw input reports of the controller, with their host and device timestamps.
+	 *
+	 * @return The report history, or nullptr if the library is not initialized.
+	 */
+	virtual const FInputReportHistory* GetInputReportHistory() const override
+	{
+		return Reader.IsValid() ? &Reader->GetHistory() : nullptr;
+	}
+	/**
+	 * Retrieves the latency histograms and counters of the controller.
+	 *
+	 * @return The statistics, or nullptr if the library is not initialized.
+	 */
+	virtual FInputLatencyStats* GetLatencyStats() override
+	{
+		return LatencyStats.Get();
+	}
+	/**
+	 * Retrieves the number of input reports the reader dropped because they were not consumed in time.
+	 */
+	virtual uint64 GetDroppedReports() const override
+	{
+		return Reader.IsValid() ? Reader->GetDroppedReports() : 0;
+	}
+	/**
+	 * Retrieves the number of Bluetooth input reports the reader discarded because of a CRC mismatch.
+	 */
+	virtual uint64 GetCrcFailures() const override
+	{
+		return Reader.IsValid() ? Reader->GetCrcFailures() : 0;
+	}
+	/**
+	 * Retrieves the input state decoded from the most recent report of the controller.
+	 *
+	 * @param OutState Receives the latest state.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetGamepadState(FGamepadState& OutState) const override;
+	/**
+	 * Retrieves the orientation fused by the reader thread, as of the last UpdateInput.
+	 *
+	 * @param OutOrientation Receives the latest orientation.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetMotionOrientation(FQuat& OutOrientation) const override;
+	/**
+	 * Adds the motion of the last UpdateInput to the batch of the tick, averaged over every
+	 * sample read since the previous one, with the calibrated bias and dead zone.
+	 *
+	 * @return The slot of the controller, or INDEX_NONE if motion events are not dispatched.
+	 */
+	virtual int32 AddMotionToBatch(FMotionBatch& Batch) override;
+	/**
+	 * Forwards the processed motion of the controller to the message handler.
+	 */
+	virtual void DispatchMotion(const FMotionBatch& Batch, int32 Slot,
+	                            const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+	                            FPlatformUserId UserId, FInputDeviceId InputDeviceId) override;
+	/**
+	 * Retrieves the motion integrated by the reader thread between the two last UpdateInput.
+	 *
+	 * @param OutDelta Receives the motion of the last tick.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetMotionDelta(FMotionDelta& OutDelta) const override;
+	/**
+	 * Restarts orientation tracking from the next report.
+	 */
+	virtual void ResetMotionOrientation() override;
+	/**
+	 * Enables or disables forwarding input to the application message handler.
+	 *
+	 * @param bEnable True to forward input to the message handler.
+	 */
+	virtual void EnableMessageHandlerDispatch(bool bEnable) override;
+	/**
+	 * Retrieves the filter deciding which analog axes are forwarded to the message handler.
+	 */
+	virtual FAnalogDeltaFilter* GetAnalogFilter() override
+	{
+		return &AnalogFilter;
+	}
 	/**
 	 * @brief Sets the controller ID for the instance.
 	 *
@@ -618,6 +573,11 @@ public:
 	 * @param HasConnected Indicates whether the phone is connected (true) or not (false).
 	 */
 	void SetHasPhoneConnected(bool HasConnected);
+	/**
+	 * Takes the baselines and noise ranges of the latest calibration published by the reader,
+	 * and completes a requested calibration once the reader finished it.
+	 */
+	void ApplyMotionCalibration();
 	/**
 	 * Sets the battery level of the DualSense device.
 	 *
@@ -634,6 +594,27 @@ public:
 	 *             or EControllerHand::AnyHand.
 	 */
 	void StopTrigger(const EControllerHand& Hand);
+	/**
+	 * Applies an adaptive trigger effect encoded ahead of time to the specified controller hand.
+	 *
+	 * The effect parameters are copied into the output state and the encoded bytes are copied
+	 * into the next output report as is.
+	 *
+	 * @param Effect The encoded effect. An empty handle is ignored.
+	 * @param Hand The hand to apply the effect to.
+	 */
+	void SetTriggerEffect(const FTriggerEffectBlob& Effect, const EControllerHand& Hand);
+	/**
+	 * Plays a trigger effect sequence on the output writer thread of the controller.
+	 *
+	 * While it plays, the sequence overrides the trigger effect set through the other functions,
+	 * which applies again once the sequence is over or stopped.
+	 *
+	 * @param Sequence The snapshot of the sequence to play, or nullptr to stop the current one.
+	 * @param Hand The hand whose trigger plays the sequence.
+	 */
+	void PlayTriggerSequence(const TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe>& Sequence,
+	                         const EControllerHand& Hand);
 	/**
 	 * @brief Stops all ongoing input and feedback operations on the DualSense controller.
 	 *
@@ -690,6 +671,17 @@ public:
 	 *                 Set to true to enable touch or false to disable it.
 	 */
 	virtual void EnableTouch(const bool bIsTouch) override;
+	/**
+	 * Enables or disables the touchpad gestures, which are disabled by default.
+	 */
+	virtual void EnableTouchGestures(bool bEnable) override;
+	/**
+	 * Replaces the thresholds of the touchpad gestures.
+	 */
+	virtual void SetTouchGestureSettings(const FTouchGestureSettings& Settings) override
+	{
+		TouchGestures.Configure(Settings);
+	}
 	/**
 	 * @brief Enables or disables the motion sensor feature of the DualSense controller.
 	 *
@@ -724,6 +716,11 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) override;
+	/**
+	 * Enables or disables measuring the gyroscope bias in the background whenever the
+	 * controller rests, which is enabled by default.
+	 */
+	virtual void EnableMotionAutoCalibration(bool bEnable) override;
 	/**
 	 * Represents the unique identifier assigned to a specific DualSense controller.
 	 *
@@ -734,20 +731,58 @@ public:
 	 */
 	int32 ControllerID;
 	/**
-	 * A map representing the states of various buttons on a controller.
-	 *
-	 * Each key in the map is a button name (FName), and its associated value is a boolean
-	 * indicating whether the button is currently pressed (`true`) or not pressed (`false`).
+	 * Buttons held in the last dispatched report, one bit per button as laid out by
+	 * FGamepadButtons.
 	 *
-	 * This variable is primarily used for tracking button input states and ensuring
-	 * accurate representation of input events, such as detecting when a button's state
-	 * changes from pressed to released or vice versa.
-	 *
-	 * The map is updated dynamically during controller runtime, including in functions
-	 * like CheckButtonInput, which ensures real-time synchronization of input states.
-	 * It is reset during library shutdown to clear all stored button states.
+	 * Compared against each new report to find the buttons that were pressed or released.
+	 * It is reset during library shutdown so that no button is considered held afterwards.
+	 */
+	uint32 ButtonMask = 0;
+	/**
+	 * Decoder matching the device and connection of this controller, selected once when the
+	 * library is initialized so that parsing a report never branches on the report layout.
+	 */
+	FPlayStationInputDecoder::FDecodeFunction DecodeReport = nullptr;
+	/**
+	 * State decoded from the most recent report, refreshed on every UpdateInput.
+	 */
+	FGamepadState InputState = {};
+	/**
+	 * Whether InputState holds a decoded report yet.
 	 */
-	TMap<const FName, bool> ButtonStates;
+	bool bHasInputState = false;
+	/**
+	 * Sequence of the newest report decoded into InputState, so a report is never decoded
+	 * after a newer one.
+	 */
+	uint64 DecodedSequence = 0;
+	/**
+	 * Orientation carried by the most recent report, refreshed on every UpdateInput.
+	 */
+	FQuat MotionOrientation = FQuat::Identity;
+	/**
+	 * Motion sums of the report consumed by the last UpdateInput, and the motion since the
+	 * report consumed by the one before.
+	 */
+	FMotionIntegral ConsumedMotion;
+	FMotionDelta MotionDelta;
+	/**
+	 * Whether decoded input is forwarded to the message handler.
+	 */
+	bool bDispatchToMessageHandler = true;
+	/**
+	 * Forwards the analog axes to the message handler, every update or only on change.
+	 */
+	FAnalogDeltaFilter AnalogFilter;
+	/**
+	 * Recognizes gestures from the touch points of every report, see `EnableTouchGestures`.
+	 */
+	FTouchGestureRecognizer TouchGestures;
+	bool bEnableTouchGestures = false;
+	/**
+	 * Touch points last forwarded to the message handler, to send only their changes.
+	 */
+	FGamepadTouchState DispatchedTouch[2] = {};
 	
 protected:
 	/**
@@ -860,6 +895,9 @@ private:
 	 * A value of false indicates that no baseline calibration exists,
 	 * signaling that calibration might be required or motion sensor
 	 * readings could be unreliable.
+	 *
+	 * Only a requested calibration sets it, as it is the only one measuring the accelerometer.
+	 * Calibrations made while the controller rests refine `GyroBaseline` alone.
 	 */
 	bool bHasMotionSensorBaseline;
 	/**
@@ -877,93 +915,37 @@ private:
 	 */
 	bool bIsCalibrating;
 	/**
-	 * @var CalibrationStartTime
-	 * @brief Represents the starting time of a calibration process.
-	 *
-	 * This variable is used to store the timestamp indicating when a calibration
-	 * operation begins. It is typically measured in seconds or another relevant
-	 * time unit and functions as a reference point for tracking the duration
-	 * or progress of the calibration procedure.
-	 *
-	 * @details CalibrationStartTime is essential for systems that require precise
-	 * synchronization or monitoring of calibration events. It provides a time
-	 * reference that can be used to evaluate performance, validate timing,
-	 * or manage system states during the calibration process.
-	 */
-	double CalibrationStartTime;
-	/**
-	 * @variable CalibrationDuration
-	 * @brief Specifies the duration required for a calibration process in the system.
-	 *
-	 * The CalibrationDuration variable represents the amount of time, in seconds,
-	 * allocated for completing the calibration procedure of a specific component or
-	 * system. This value can be used to control timing and ensure proper operation
-	 * during the calibration phase.
+	 * @brief Represents the context of a Human Interface Device (HID) used by DualSense controllers.
 	 *
-	 * @details CalibrationDuration plays a crucial role in determining the time
-	 * limits for calibration workflows. It may be configured based on the requirements
-	 * of the specific hardware or software being calibrated. Proper calibration duration
-	 * is essential to achieve accurate results and optimal performance.
+	 * This variable holds the FDeviceContext structure, which encapsulates the necessary state and
+	 * configuration details for managing the connection, communication, and interaction with a
+	 * specific DualSense gamepad device. It is primarily used within the UDualSenseLibrary class for
+	 * initialization, input handling, and managing device-specific settings.
 	 */
-	float CalibrationDuration;
+	FDeviceContext HIDDeviceContexts;
 	/**
-	 * @class AccumulatedGyro
-	 * @brief Represents the accumulated gyroscopic sensor data.
-	 *
-	 * The AccumulatedGyro variable is used to store the cumulative measurements
-	 * from a gyroscope over a period of time. Gyroscopic data typically includes
-	 * angular velocity measurements along the X, Y, and Z axes, allowing for
-	 * tracking of rotational motion.
-	 *
-	 * This variable is commonly used in applications requiring precise angular
-	 * motion tracking or orientation changes, such as in controllers, VR/AR
-	 * systems, or robotics.
+	 * @brief Dedicated reader thread that receives every input report of the device.
 	 *
-	 * @details The data stored in AccumulatedGyro may include the sum of angular
-	 * velocities sampled periodically, providing an aggregate measure of
-	 * rotational movement. Proper handling of noise and sensor calibration is
-	 * recommended to ensure accuracy when interpreting this data.
+	 * Started by InitializeLibrary and destroyed by ShutdownLibrary. UpdateInput parses the
+	 * latest snapshot it publishes instead of scheduling a blocking read each tick.
 	 */
-	FVector AccumulatedGyro;
+	TUniquePtr<FHIDReaderRunnable> Reader;
 	/**
-	 * @class AccumulatedAccel
-	 * @brief Represents the total accumulated acceleration vector.
+	 * @brief Dedicated writer thread that composes and writes the output reports of the device.
 	 *
-	 * AccumulatedAccel is a variable intended to store the cumulative acceleration
-	 * values detected over time in the form of a 3D vector. This data is typically
-	 * used to track movement or behavior in applications requiring motion detection
-	 * or spatial calculations.
-	 *
-	 * @details The variable holds acceleration data along the X, Y, and Z axes,
-	 * aggregated over a period. It can be utilized in scenarios such as
-	 * gesture recognition, motion analysis, or input handling in systems that
-	 * rely on accelerometer-based data or similar sensors.
+	 * Started by InitializeLibrary and destroyed by ShutdownLibrary, which flushes the last
+	 * pending state. SendOut only submits the output state to it.
 	 */
-	FVector AccumulatedAccel;
+	TUniquePtr<FHIDWriterRunnable> Writer;
 	/**
-	 * @brief Specifies the number of calibration samples to be collected.
-	 *
-	 * CalibrationSampleCount is an integer variable that determines the quantity of
-	 * samples required for calibration in a given process or system. Increasing or
-	 * decreasing this value directly impacts the precision and accuracy of the calibration
-	 * process, as more samples generally provide more statistically significant data,
-	 * while fewer samples may reduce processing time.
-	 *
-	 * @details This variable is utilized in scenarios where data consistency, error
-	 * adjustment, or parameter tuning is needed for optimal functionality. It plays
-	 * a critical role in applications involving sensors, devices, or systems requiring
-	 * initialization or recalibration during operation.
+	 * @brief Latency histograms and counters, only recorded while instrumentation is enabled.
 	 */
-	int32 CalibrationSampleCount;
+	TSharedPtr<FInputLatencyStats, ESPMode::ThreadSafe> LatencyStats;
 	/**
-	 * @brief Represents the context of a Human Interface Device (HID) used by DualSense controllers.
-	 *
-	 * This variable holds the FDeviceContext structure, which encapsulates the necessary state and
-	 * configuration details for managing the connection, communication, and interaction with a
-	 * specific DualSense gamepad device. It is primarily used within the UDualSenseLibrary class for
-	 * initialization, input handling, and managing device-specific settings.
+	 * @brief Host time at which the report currently being dispatched was read, used to
+	 *        measure the input-to-event latency of every button edge it triggers.
 	 */
-	FDeviceContext HIDDeviceContexts;
+	uint64 DispatchReportCycles = 0;
 	/**
 	 * @variable GyroBaseline
 	 * @brief Represents the baseline gyroscope values for calibration or adjustment.
@@ -993,6 +975,18 @@ private:
 	 * accelerometer measurements.
 	 */
 	FVector AccelBaseline;
-
-	FSensorBounds Bounds;
+	/**
+	 * Spread of the sensor noise at rest, six standard deviations per axis, in raw counts.
+	 * The dead zone is a fraction of it.
+	 */
+	FVector GyroNoiseRange = FVector::ZeroVector;
+	FVector AccelNoiseRange = FVector::ZeroVector;
+	/**
+	 * Version of the reader calibration last applied, see FHIDReaderRunnable::GetCalibration.
+	 */
+	uint32 AppliedCalibrationVersion = 0;
+	/**
+	 * Number of calibrations the reader had completed when the current one was requested.
+	 */
+	uint32 CalibrationsAtStart = 0;
 };
@@ -8,6 +8,12 @@
 #include "UObject/Object.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
 #include "Core/Structs/FDualShockFeatureReport.h"
+#include "Core/HIDReaderRunnable.h"
+#include "Core/HIDWriterRunnable.h"
+#include "Core/InputLatencyStats.h"
+#include "Core/PlayStationInputDecoder.h"
+#include "Core/AnalogDeltaFilter.h"
+#include "Core/TouchGestureRecognizer.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "DualShockLibrary.generated.h"
 
@@ -81,25 +87,26 @@ public:
 	 *
 	 * @details The method first verifies the connection status of the HID
 	 * device context. If the device is not connected, the operation is aborted.
-	 * Otherwise, it delegates the responsibility of handling the output
-	 * buffering to the appropriate manager, ensuring proper data flow to the device.
+	 * Otherwise, it hands a copy of the output state to the writer thread and returns
+	 * immediately; changes submitted within one output interval are written as a single report.
 	 */
 	virtual void SendOut() override;
 	/**
-	 * @brief Handles button input events for a DualSense controller.
+	 * @brief Dispatches the digital buttons of a single input report.
 	 *
-	 * This function checks the current state of a button on a DualSense controller and triggers
-	 * appropriate input events (button press or release) based on the change in its state.
+	 * Every report read since the previous tick goes through this function in arrival order,
+	 * so a press and release that both happen between two ticks still produce both events.
+	 * The buttons are packed into a mask and compared with the previous one; only the bits
+	 * that changed are sent to the message handler, and nothing is done when none did.
 	 *
 	 * @param InMessageHandler The message handler responsible for dispatching input events.
 	 * @param UserId The platform user ID associated with the controller.
-	 * @param InputDeviceId The unique identifier for the DualSense input device.
-	 * @param ButtonName The name of the button being checked.
-	 * @param IsButtonPressed A boolean indicating the current pressed state of the button (true if pressed, false otherwise).
+	 * @param InputDeviceId The unique identifier for the DualShock 4 input device.
+	 * @param Buttons The buttons decoded from the report, as laid out by FGamepadButtons.
 	 */
-	virtual void CheckButtonInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
-								  const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
-								  const FName ButtonName, const bool IsButtonPressed);
+	void DispatchButtons(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+						 const FPlatformUserId UserId, const FInputDeviceId InputDeviceId,
+						 const uint32 Buttons);
 	/**
 	 * @brief Updates the input state for a DualSense device.
 	 *
@@ -123,6 +130,76 @@ public:
 	{
 		return LevelBattery;
 	}
+	/**
+	 * Retrieves the recent raw input reports of the controller, with their host and device timestamps.
+	 *
+	 * @return The report history, or nullptr if the library is not initialized.
+	 */
+	virtual const FInputReportHistory* GetInputReportHistory() const override
+	{
+		return Reader.IsValid() ? &Reader->GetHistory() : nullptr;
+	}
+	/**
+	 * Retrieves the latency histograms and counters of the controller.
+	 *
+	 * @return The statistics, or nullptr if the library is not initialized.
+	 */
+	virtual FInputLatencyStats* GetLatencyStats() override
+	{
+		return LatencyStats.Get();
+	}
+	/**
+	 * Retrieves the number of input reports the reader dropped because they were not consumed in time.
+	 */
+	virtual uint64 GetDroppedReports() const override
+	{
+		return Reader.IsValid() ? Reader->GetDroppedReports() : 0;
+	}
+	/**
+	 * Retrieves the number of Bluetooth input reports the reader discarded because of a CRC mismatch.
+	 */
+	virtual uint64 GetCrcFailures() const override
+	{
+		return Reader.IsValid() ? Reader->GetCrcFailures() : 0;
+	}
+	/**
+	 * Retrieves the input state decoded from the most recent report of the controller.
+	 *
+	 * @param OutState Receives the latest state.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetGamepadState(FGamepadState& OutState) const override;
+	/**
+	 * Retrieves the orientation fused by the reader thread, as of the last UpdateInput.
+	 *
+	 * @param OutOrientation Receives the latest orientation.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetMotionOrientation(FQuat& OutOrientation) const override;
+	/**
+	 * Retrieves the motion integrated by the reader thread between the two last UpdateInput.
+	 *
+	 * @param OutDelta Receives the motion of the last tick.
+	 * @return False if no report has been decoded since the library was initialized.
+	 */
+	virtual bool GetMotionDelta(FMotionDelta& OutDelta) const override;
+	/**
+	 * Restarts orientation tracking from the next report.
+	 */
+	virtual void ResetMotionOrientation() override;
+	/**
+	 * Enables or disables forwarding input to the application message handler.
+	 *
+	 * @param bEnable True to forward input to the message handler.
+	 */
+	virtual void EnableMessageHandlerDispatch(bool bEnable) override;
+	/**
+	 * Retrieves the filter deciding which analog axes are forwarded to the message handler.
+	 */
+	virtual FAnalogDeltaFilter* GetAnalogFilter() override
+	{
+		return &AnalogFilter;
+	}
 	/**
 	 * Sets the color of the lightbar on the Sony gamepad.
 	 *
@@ -202,6 +279,21 @@ public:
 	 * @param bIsTouch A boolean indicating whether touch input is enabled (true) or disabled (false).
 	 */
 	virtual void EnableTouch(const bool bIsTouch) override;
+	/**
+	 * Enables or disables the touchpad gestures, which are disabled by default.
+	 */
+	virtual void EnableTouchGestures(bool bEnable) override
+	{
+		bEnableTouchGestures = bEnable;
+		TouchGestures.Reset();
+	}
+	/**
+	 * Replaces the thresholds of the touchpad gestures.
+	 */
+	virtual void SetTouchGestureSettings(const FTouchGestureSettings& Settings) override
+	{
+		TouchGestures.Configure(Settings);
+	}
 	/**
 	 * Enables the motion sensor functionality of the gamepad.
 	 *
@@ -228,6 +320,17 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) override {return false;}
+	/**
+	 * Enables or disables measuring the gyroscope bias used by the orientation whenever the
+	 * controller rests.
+	 */
+	virtual void EnableMotionAutoCalibration(bool bEnable) override
+	{
+		if (Reader.IsValid())
+		{
+			Reader->SetAutoCalibration(bEnable);
+		}
+	}
 	/**
 	 * Represents the unique identifier assigned to a specific DualSense controller.
 	 *
@@ -238,20 +341,54 @@ public:
 	 */
 	int32 ControllerID;
 	/**
-	 * A map representing the states of various buttons on a controller.
-	 *
-	 * Each key in the map is a button name (FName), and its associated value is a boolean
-	 * indicating whether the button is currently pressed (`true`) or not pressed (`false`).
+	 * Buttons held in the last dispatched report, one bit per button as laid out by
+	 * FGamepadButtons.
 	 *
-	 * This variable is primarily used for tracking button input states and ensuring
-	 * accurate representation of input events, such as detecting when a button's state
-	 * changes from pressed to released or vice versa.
-	 *
-	 * The map is updated dynamically during controller runtime, including in functions
-	 * like CheckButtonInput, which ensures real-time synchronization of input states.
-	 * It is reset during library shutdown to clear all stored button states.
+	 * Compared against each new report to find the buttons that were pressed or released.
+	 * It is reset during library shutdown so that no button is considered held afterwards.
+	 */
+	uint32 ButtonMask = 0;
+	/**
+	 * Decoder matching the device and connection of this controller, selected once when the
+	 * library is initialized so that parsing a report never branches on the report layout.
+	 */
+	FPlayStationInputDecoder::FDecodeFunction DecodeReport = nullptr;
+	/**
+	 * State decoded from the most recent report, refreshed on every UpdateInput.
 	 */
-	TMap<const FName, bool> ButtonStates;
+	FGamepadState InputState = {};
+	/**
+	 * Whether InputState holds a decoded report yet.
+	 */
+	bool bHasInputState = false;
+	/**
+	 * Sequence of the newest report decoded into InputState, so a report is never decoded
+	 * after a newer one.
+	 */
+	uint64 DecodedSequence = 0;
+	/**
+	 * Orientation carried by the most recent report, refreshed on every UpdateInput.
+	 */
+	FQuat MotionOrientation = FQuat::Identity;
+	/**
+	 * Motion sums of the report consumed by the last UpdateInput, and the motion since the
+	 * report consumed by the one before.
+	 */
+	FMotionIntegral ConsumedMotion;
+	FMotionDelta MotionDelta;
+	/**
+	 * Whether decoded input is forwarded to the message handler.
+	 */
+	bool bDispatchToMessageHandler = true;
+	/**
+	 * Forwards the analog axes to the message handler, every update or only on change.
+	 */
+	FAnalogDeltaFilter AnalogFilter;
+	/**
+	 * Recognizes gestures from the touch points of every report, see `EnableTouchGestures`.
+	 */
+	FTouchGestureRecognizer TouchGestures;
+	bool bEnableTouchGestures = false;
 protected:
 	/**
 	 * @brief The PlatformInputDeviceMapper is responsible for mapping platform-specific
@@ -310,4 +447,27 @@ private:
 	 * initialization, input handling, and managing device-specific settings.
 	 */
 	FDeviceContext HIDDeviceContexts;
+	/**
+	 * @brief Dedicated reader thread that receives every input report of the device.
+	 *
+	 * Started by InitializeLibrary and destroyed by ShutdownLibrary. UpdateInput parses the
+	 * latest snapshot it publishes instead of scheduling a blocking read each tick.
+	 */
+	TUniquePtr<FHIDReaderRunnable> Reader;
+	/**
+	 * @brief Dedicated writer thread that composes and writes the output reports of the device.
+	 *
+	 * Started by InitializeLibrary and destroyed by ShutdownLibrary, which flushes the last
+	 * pending state. SendOut only submits the output state to it.
+	 */
+	TUniquePtr<FHIDWriterRunnable> Writer;
+	/**
+	 * @brief Latency histograms and counters, only recorded while instrumentation is enabled.
+	 */
+	TSharedPtr<FInputLatencyStats, ESPMode::ThreadSafe> LatencyStats;
+	/**
+	 * @brief Host time at which the report currently being dispatched was read, used to
+	 *        measure the input-to-event latency of every button edge it triggers.
+	 */
+	uint64 DispatchReportCycles = 0;
 };
@@ -0,0 +1,104 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
+
+/**
+ * @brief Packs the digital buttons of a report into a 32-bit mask and dispatches edges.
+ *
+ * The mask layout mirrors the report bytes so decoding is a handful of shifts: the face
+ * buttons come from the upper nibble of the first button byte, the d-pad is expanded from
+ * the hat switch through a lookup table, and the shoulder/trigger/stick/option byte and the
+ * DualSense system byte are copied as they are.
+ *
+ * Edges between two masks are found with a single XOR, and only the changed bits are
+ * dispatched, each through a static table of the key names it maps to.
+ */
+class WINDOWSDUALSENSE_DS5W_API FGamepadButtons
+{
+public:
+	/**
+	 * Bit positions of every button in the mask.
+	 */
+	enum EButton : uint32
+	{
+		Square = 0,
+		Cross = 1,
+		Circle = 2,
+		Triangle = 3,
+		DPadUp = 4,
+		DPadDown = 5,
+		DPadLeft = 6,
+		DPadRight = 7,
+		LeftShoulder = 8,
+		RightShoulder = 9,
+		LeftTrigger = 10,
+		RightTrigger = 11,
+		Share = 12,
+		Options = 13,
+		LeftStick = 14,
+		RightStick = 15,
+		Playstation = 16,
+		TouchPad = 17,
+		Mic = 18,
+		FunctionLeft = 20,
+		FunctionRight = 21,
+		PaddleLeft = 22,
+		PaddleRight = 23,
+		Count = 24
+	};
+
+	/**
+	 * Decodes the button bytes of an input report.
+	 *
+	 * Both controllers share the layout of the first two bytes: face buttons and hat switch,
+	 * then shoulders, trigger thresholds, Share/Options and stick clicks. The DualSense adds a
+	 * third byte with the PlayStation, touchpad and mic buttons, the Edge function buttons and
+	 * the paddles.
+	 *
+	 * @tparam NumBytes Number of button bytes in the report, 2 or 3.
+	 * @param ButtonBytes The first button byte of the report.
+	 */
+	template <int32 NumBytes>
+	static uint32 Decode(const unsigned char* ButtonBytes)
+	{
+		static_assert(NumBytes == 2 || NumBytes == 3, "Reports carry two or three button bytes");
+
+		uint32 Mask = (ButtonBytes[0] >> 4) |
+			(HatToDPad(ButtonBytes[0]) << DPadUp) |
+			(static_cast<uint32>(ButtonBytes[1]) << LeftShoulder);
+		if constexpr (NumBytes == 3)
+		{
+			Mask |= (static_cast<uint32>(ButtonBytes[2]) & 0xF7u) << Playstation;
+		}
+		return Mask;
+	}
+
+	/**
+	 * Sends a press or release event for every bit that differs between two masks.
+	 *
+	 * @param MessageHandler The handler receiving the events.
+	 * @param UserId The platform user owning the device.
+	 * @param InputDeviceId The device the events originate from.
+	 * @param Previous The mask that was last dispatched.
+	 * @param Current The newly decoded mask.
+	 * @return The number of events sent.
+	 */
+	static int32 DispatchChanges(FGenericApplicationMessageHandler& MessageHandler, FPlatformUserId UserId,
+	                             FInputDeviceId InputDeviceId, uint32 Previous, uint32 Current);
+
+private:
+	/**
+	 * Expands the hat switch in the low nibble of a button byte into the four d-pad bits.
+	 */
+	static uint32 HatToDPad(const unsigned char Hat)
+	{
+		// Up = 1, Down = 2, Left = 4, Right = 8, indexed by the hat direction; 8 and above is centered.
+		static constexpr uint8 Table[16] = {1, 9, 8, 10, 2, 6, 4, 5, 0, 0, 0, 0, 0, 0, 0, 0};
+		return Table[Hat & 0x0F];
+	}
+};
@@ -3,43 +3,24 @@
 // Planned Release Year: 2025
 
 #pragma once
-#define NOMINMAX
 
 #include "CoreMinimal.h"
-#include "Windows/AllowWindowsPlatformTypes.h"
-#include <Windows.h>
-#include "Windows/HideWindowsPlatformTypes.h"
-#include <chrono>
 #include "Structs/FDeviceContext.h"
-
-enum class EPollResult {
-	ReadOk,
-	NoIoThisTick,
-	TransientError,
-	Disconnected
-};
+#include "Interfaces/HidTransport.h"
 
 /**
  * @brief Represents a static class for HID device management and operations.
  *
  * This class encapsulates various tasks related to managing multiple HID devices, including handling connections,
  * transmitting and receiving data, detecting device presence, and managing device-specific states or contexts.
+ *
+ * Detection and opening go through the active `IHidTransport`, and every later operation on a device through
+ * the transport it was detected with. The platform transport is installed by default; tests and benchmarks may
+ * replace it with `SetTransport`, for instance with an `FLoopbackHidTransport`.
  */
 class FHIDDeviceInfo
 {
-	/**
-	 * @brief Reads data from the specified HID device context.
-	 *
-	 * This method performs the process of retrieving input data from an HID device, verifying the context's validity,
-	 * handling connection states, and managing input buffers. It also utilizes polling mechanisms to detect and
-	 * report disconnection events or communication failures during the read process.
-	 *
-	 * @param Context Pointer to the device context representing the HID device being read. Must not be null and
-	 *        should contain a valid device handle and input buffer. If the context is invalid or disconnected,
-	 *        the method will handle associated cleanup and reporting.
-	 */
 public:
-	static void Read(FDeviceContext* Context);
 	/**
 	 * @brief Writes data to the specified HID device context.
 	 *
@@ -53,6 +34,12 @@ public:
 	 *        represent a valid device handle for a successful write operation.
 	 */
 	static void Write(FDeviceContext* Context);
+	/**
+	 * @brief Returns the size, in bytes, of the output report written to a device.
+	 *
+	 * @param Context The context of the device, used for its type and connection type.
+	 */
+	static size_t GetOutputReportLength(const FDeviceContext& Context);
 	/**
 	 * @brief Detects available HID devices and updates the provided list of device contexts.
 	 *
@@ -75,75 +62,56 @@ public:
 	 * @param DeviceContext Pointer to the FDeviceContext object that contains the
 	 *        path and other device-specific information required to establish the
 	 *        connection. Must not be null and must represent a valid device path.
-	 * @return A HANDLE to the opened device if successful, or INVALID_HANDLE_VALUE
+	 * @return A handle to the opened device if successful, or `IHidTransport::InvalidHandle()`
 	 *         if the operation fails.
 	 */
-	static HANDLE CreateHandle(FDeviceContext* Context);
+	static void* CreateHandle(FDeviceContext* Context);
 	/**
 	 * @brief Invalidates the handle of the specified HID device context and updates its connection status.
 	 *
 	 * This method ensures that the handle associated with the provided device context is properly invalidated.
-	 * If the handle is valid, it will be closed and set to INVALID_HANDLE_VALUE. The connection status of the
+	 * If the handle is valid, it will be closed and set to `IHidTransport::InvalidHandle()`. The connection status of the
 	 * device context will also be updated to indicate that the device is no longer connected.
 	 *
 	 * @param Context Pointer to the device context representing the HID device whose handle is to be invalidated.
 	 *        If the provided context is null, the method will return without performing any operations.
 	 */
 	static void InvalidateHandle(FDeviceContext* Context);
-	static void InvalidateHandle(HANDLE Handle);
-
 	/**
-	 * @brief Performs a single ping operation on an HID device handle.
+	 * @brief Flags a device whose I/O failed as disconnected, without closing its handle.
 	 *
-	 * This method checks the accessibility and basic functionality of the specified
-	 * HID device by attempting to retrieve file information through the provided handle.
-	 * It validates whether the device is responsive and updates the error code if the
-	 * operation fails.
+	 * The watchdog may still be pinging the handle, so it is only closed once the registry has
+	 * stopped watching the device and released its library, see `FDeviceRegistry::RemoveLibraryInstance`.
 	 *
-	 * @param Handle The handle to the HID device that will be pinged. Must be a valid and open handle
-	 *        to a device that supports the required operations.
-	 * @param OutLastError Pointer to a DWORD variable that receives the error code if the operation
-	 *        fails. If the operation is successful, this will be set to ERROR_SUCCESS. This parameter
-	 *        is optional and can be null.
-	 * @return true if the ping operation succeeds and the device is accessible; false if an error occurs.
+	 * @param Context Pointer to the device context of the failed device. Ignored if null.
 	 */
-	static bool PingOnce(HANDLE Handle, DWORD* OutLastError = nullptr);
+	static void MarkDisconnected(FDeviceContext* Context);
+
 	/**
-	 * @brief Polls and processes a single tick for a HID device, performing ping and read operations.
+	 * @brief Replaces the transport used by every HID operation.
 	 *
-	 * This method checks the device's state, performs a ping operation if necessary, and reads data from the device.
-	 * It updates the polling state accordingly and determines the result of this polling iteration.
+	 * Only affects the devices detected afterwards. Every device context keeps the transport it
+	 * was detected through, see `FDeviceContext::Transport`, and its handle is read, written,
+	 * pinged and closed through that transport until it is released.
 	 *
-	 * @param Handle A handle to the HID device being polled.
-	 * @param Buffer A pointer to a buffer where the method writes the data read from the device.
-	 * @param Length The maximum number of bytes that can be read into the buffer.
-	 * @param OutBytesRead A reference to a variable where the number of bytes successfully read will be stored.
-	 * @return An enumeration value of type EPollResult indicating the result of the polling operation.
+	 * @param InTransport The transport to install. Passing null restores the platform transport.
 	 */
-	static EPollResult PollTick(HANDLE Handle, BYTE* Buffer, DWORD Length, DWORD& OutBytesRead);
-
+	static void SetTransport(const TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& InTransport);
 	/**
-	 * @brief Determines whether the given error code should be treated as a device disconnection.
-	 *
-	 * This method evaluates the provided error code and identifies if it corresponds
-	 * to a scenario where a device should be considered as disconnected.
+	 * @brief Returns the transport currently used by every HID operation.
+	 */
+	static TSharedPtr<IHidTransport, ESPMode::ThreadSafe> GetTransport();
+	/**
+	 * @brief Returns the transport that owns the handle of a device.
 	 *
-	 * @param Error The error code to evaluate.
-	 * @return true if the error code indicates a device disconnection, false otherwise.
+	 * @param Context The device context. Falls back to the current transport if the device
+	 *        was neither detected nor opened through one yet.
+	 */
+	static TSharedPtr<IHidTransport, ESPMode::ThreadSafe> GetTransport(const FDeviceContext& Context);
+
+private:
+	/**
+	 * @brief Creates the transport for the platform the plugin is running on.
 	 */
-	static bool ShouldTreatAsDisconnected(const DWORD Error)
-	{
-		switch (Error)
-		{
-		case ERROR_DEVICE_NOT_CONNECTED:
-		case ERROR_GEN_FAILURE:
-		case ERROR_INVALID_HANDLE:
-		case ERROR_BAD_COMMAND:
-		case ERROR_FILE_NOT_FOUND:
-		case ERROR_ACCESS_DENIED:
-			return true;
-		default:
-			return false;
-		}
-	}
+	static TSharedPtr<IHidTransport, ESPMode::ThreadSafe> CreatePlatformTransport();
 };
@@ -0,0 +1,406 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/CircularQueue.h"
+#include "Containers/TripleBuffer.h"
+#include "Core/Structs/FDeviceContext.h"
+#include "Core/Structs/FInputReport.h"
+#include "Core/Structs/FInputReportHistory.h"
+#include "Core/Interfaces/HidTransport.h"
+#include "Core/MotionCalibrator.h"
+#include "Core/MotionFusionFilter.h"
+#include <atomic>
+
+/**
+ * A long-lived runnable that reads every input report of a single HID device.
+ *
+ * `FHIDReaderRunnable` owns a dedicated read stream to the device, opened through the
+ * transport that owns the device, and blocks on it until a report arrives, the device goes away, or a stop is
+ * requested. Transports that service many devices from one thread, such as hidraw, take the
+ * stream over instead, see `IHidTransport::AttachReader`; no thread is then created for the
+ * device, and the shared thread hands each report to this reader through `IHidReportSink`.
+ * Each report is read straight into the write slot of a triple buffer and
+ * published as the latest snapshot, then pushed into a single-producer/single-consumer
+ * lock-free queue. The game thread parses the snapshot from `UpdateInput`, so it never
+ * blocks, never races with an in-flight read and always sees one coherent, most recent report.
+ *
+ * Every report is stamped with the host time at which its read completed and with the sensor
+ * timestamp of the device. Reports removed from the channel are also recorded in a fixed-size
+ * history owned by the consumer, see `GetHistory`.
+ *
+ * The reader keeps running at the native report rate of the controller (around 250 Hz over
+ * USB and up to 800 Hz over Bluetooth), independently of the game tick. It also feeds the
+ * motion sensors of every report into a fusion filter, stepped with the sensor timestamp, and
+ * stamps the report with the resulting orientation; motion the game thread never sees, between
+ * two ticks, still contributes to the estimate. Each report also carries the running sums of
+ * every motion sample read so far, see `FMotionIntegral`, from which the game thread derives
+ * the exact motion of its last tick. The same samples calibrate the sensors, see
+ * `FMotionCalibrator`: requested calibrations and the gyroscope bias measured whenever the
+ * controller rests are applied to the filter here and published to the game thread.
+ *
+ * Full Bluetooth input reports end with a CRC32 of the report. While CRC validation is
+ * enabled, which is the default, a report whose checksum does not match is counted and
+ * discarded before it is published, so a packet corrupted over the radio never reaches
+ * `UpdateInput` as phantom input.
+ */
+class FHIDReaderRunnable final : public FRunnable, public IHidReportSink
+{
+public:
+	/**
+	 * Constructs a reader for the device described by the given context.
+	 *
+	 * Only the device path, type and connection type are copied from the context; the
+	 * reader opens its own read stream so it never shares a handle with the output path.
+	 *
+	 * @param InContext The context of the device to read from.
+	 */
+	explicit FHIDReaderRunnable(const FDeviceContext& InContext);
+	/**
+	 * Stops the thread, waits for it to finish and releases the read stream.
+	 */
+	virtual ~FHIDReaderRunnable() override;
+
+	/**
+	 * Verifies that the read stream was opened before the thread started.
+	 *
+	 * @return True if the stream is open and the thread may run, false otherwise.
+	 */
+	virtual bool Init() override;
+	/**
+	 * Blocks on the device and enqueues each report as it arrives.
+	 *
+	 * The loop ends when a stop is requested, the device reports a disconnection, or reads
+	 * keep failing for `IHidTransport::MaxTransientErrors` attempts in a row.
+	 *
+	 * @return `0` on a requested stop, `1` when the device was lost.
+	 */
+	virtual uint32 Run() override;
+	/**
+	 * Requests the thread to stop and wakes up any read that is currently blocking.
+	 */
+	virtual void Stop() override;
+	/**
+	 * Called on the reader thread once the loop has finished.
+	 */
+	virtual void Exit() override;
+
+	/**
+	 * Opens the read stream on the calling thread, then attaches it to the shared reader of
+	 * the transport or, if it has none, creates the underlying thread and starts reading. If
+	 * the stream cannot be opened the reader is flagged as disconnected and no thread is created.
+	 */
+	void StartThread();
+
+	/**
+	 * Returns the write slot of the triple buffer, which the next report is read into.
+	 */
+	virtual unsigned char* GetReportBuffer(size_t& OutLength) override;
+	/**
+	 * Validates, stamps and publishes the report just read into the write slot.
+	 */
+	virtual void OnReport(size_t BytesRead) override;
+	/**
+	 * Flags the reader as disconnected.
+	 */
+	virtual void OnDisconnected() override;
+
+	/**
+	 * Returns the most recent report published by the reader thread.
+	 *
+	 * Swaps in the newest snapshot when the reader published one since the previous call,
+	 * otherwise returns the same report again. The reference stays valid and unchanged until
+	 * the next call, regardless of what the reader thread does in the meantime.
+	 *
+	 * Must only be called from the consumer (game) thread.
+	 *
+	 * @return The latest complete report. Zero-filled until the first report arrives.
+	 */
+	const FInputReport& ReadLatest()
+	{
+		return Snapshot.SwapAndRead();
+	}
+
+	/**
+	 * Indicates whether the reader published a report that the next call to `ReadLatest`
+	 * has yet to swap in.
+	 */
+	bool HasNewReport() const
+	{
+		return Snapshot.IsDirty();
+	}
+
+	/**
+	 * Removes the oldest pending report from the channel and records it in the history.
+	 *
+	 * Must only be called from the consumer (game) thread.
+	 *
+	 * @param OutReport Receives the dequeued report.
+	 * @return True if a report was dequeued, false if the channel is empty.
+	 */
+	bool Dequeue(FInputReport& OutReport)
+	{
+		if (!Reports.Dequeue(OutReport))
+		{
+			return false;
+		}
+
+		History.Push(OutReport);
+		return true;
+	}
+
+	/**
+	 * Recent reports removed from the channel, oldest overwritten first.
+	 *
+	 * Must only be accessed from the consumer (game) thread.
+	 */
+	const FInputReportHistory& GetHistory() const
+	{
+		return History;
+	}
+
+	/**
+	 * Indicates whether the reader stopped because the device was lost.
+	 *
+	 * @return True once a read failed with an error treated as a disconnection.
+	 */
+	bool IsDisconnected() const
+	{
+		return bDisconnected.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Number of reports discarded because the consumer did not drain the channel in time.
+	 */
+	uint64 GetDroppedReports() const
+	{
+		return DroppedReports.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Number of Bluetooth reports discarded because their CRC did not match.
+	 */
+	uint64 GetCrcFailures() const
+	{
+		return CrcFailures.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Whether the CRC of Bluetooth input reports is checked, for every reader.
+	 */
+	static bool IsCrcValidationEnabled()
+	{
+		return bCrcValidation.load(std::memory_order_relaxed);
+	}
+
+	static void SetCrcValidationEnabled(const bool bInEnabled)
+	{
+		bCrcValidation.store(bInEnabled, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Restarts orientation tracking from the next report. Safe to call from any thread.
+	 */
+	void ResetOrientation()
+	{
+		bOrientationResetRequested.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Starts calibrating the motion sensors over the given duration of sensor time, replacing
+	 * any calibration in progress. Safe to call from any thread.
+	 */
+	void StartCalibration(const double DurationSeconds)
+	{
+		CalibrationProgress.store(0.0f, std::memory_order_relaxed);
+		RequestedCalibrationSeconds.store(DurationSeconds, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Progress of the last requested calibration, from 0 to 1, or a negative value if none
+	 * was requested.
+	 */
+	float GetCalibrationProgress() const
+	{
+		return CalibrationProgress.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Number of requested calibrations completed so far.
+	 */
+	uint32 GetCompletedCalibrations() const
+	{
+		return CompletedCalibrations.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Retrieves the latest calibration if it changed since the given version. The gyroscope
+	 * values follow the most recent rest, the accelerometer values the last requested calibration.
+	 * `bExplicit` is set once a requested calibration completed, so the accelerometer values are
+	 * meaningful; until then they are zero.
+	 *
+	 * @param OutCalibration Receives the calibration when it changed.
+	 * @param InOutVersion The version the caller last retrieved, updated on return.
+	 * @return True if a newer calibration was retrieved.
+	 */
+	bool GetCalibration(FMotionCalibration& OutCalibration, uint32& InOutVersion);
+
+	/**
+	 * Enables or disables measuring the gyroscope bias whenever the controller rests.
+	 * Safe to call from any thread.
+	 */
+	void SetAutoCalibration(const bool bEnable)
+	{
+		bAutoCalibrationRequested.store(bEnable, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Sets the weight of the accelerometer correction of the fusion filter, see
+	 * `FMotionFusionFilter::SetGain`. Safe to call from any thread.
+	 */
+	void SetFusionGain(const float Gain)
+	{
+		FusionGain.store(Gain, std::memory_order_relaxed);
+	}
+
+private:
+	/**
+	 * Reads the sensor timestamp embedded in a raw report of the given device.
+	 */
+	static uint32 ExtractDeviceTimestamp(const FDeviceContext& Context, const FInputReport& Report);
+	/**
+	 * Checks the CRC32 trailer of a full Bluetooth report. Reports without a trailer, such as
+	 * USB reports or the reduced reports sent before the full mode is enabled, are accepted.
+	 */
+	static bool HasValidCrc(const FDeviceContext& Context, const FInputReport& Report);
+	/**
+	 * Reads the raw gyroscope and accelerometer samples of a report.
+	 *
+	 * @return False for reports without motion data, such as the reduced Bluetooth reports.
+	 */
+	static bool ReadMotion(const FDeviceContext& Context, const FInputReport& Report, int16 (&OutGyro)[3],
+	                       int16 (&OutAccel)[3]);
+	/**
+	 * Feeds the motion samples of a report to the calibrator, the fusion filter and the motion
+	 * sums, and stamps the report with the resulting orientation and sums.
+	 */
+	void FuseMotion(FInputReport& Report);
+
+	/**
+	 * Length of the part of a full Bluetooth report covered by its CRC, which follows it.
+	 */
+	static constexpr uint32 CrcCoveredLength = 74;
+
+	/**
+	 * Number of reports the channel can hold before new reports are dropped.
+	 *
+	 * Sized to cover several game ticks at the highest Bluetooth report rate.
+	 */
+	static constexpr uint32 ChannelCapacity = 64;
+
+	/**
+	 * Transport the read stream belongs to, kept alive for the lifetime of the reader.
+	 */
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport;
+	/**
+	 * Copy of the device description used to open the read stream.
+	 */
+	FDeviceContext Context;
+	/**
+	 * Length, in bytes, requested from the device on each read.
+	 */
+	uint32 ReportLength;
+	/**
+	 * Opaque read stream returned by `IHidTransport::OpenReader`.
+	 */
+	void* ReadStream;
+	/**
+	 * Thread executing this runnable, or null when the stream is attached to the shared
+	 * reader of the transport.
+	 */
+	FRunnableThread* Thread;
+	/**
+	 * Whether `ReadStream` is serviced by the shared reader of the transport.
+	 */
+	bool bAttached;
+	/**
+	 * Wait-free triple buffer holding the latest report published by the reader thread.
+	 */
+	TTripleBuffer<FInputReport> Snapshot;
+	/**
+	 * Lock-free single-producer/single-consumer channel of reports.
+	 */
+	TCircularQueue<FInputReport> Reports;
+	/**
+	 * History of dequeued reports, only touched by the consumer thread.
+	 */
+	FInputReportHistory History;
+	/**
+	 * Number of reports read so far, used to stamp `FInputReport::Sequence`.
+	 */
+	uint64 ReportsRead;
+	/**
+	 * Duration, in seconds, of one tick of the device timestamp, and the width of the counter.
+	 */
+	double DeviceTimestampPeriod;
+	uint32 DeviceTimestampMask;
+	/**
+	 * Orientation estimate and sensor calibration, only touched by the reader thread.
+	 */
+	FMotionFusionFilter Fusion;
+	FMotionCalibrator Calibrator;
+	bool bAutoCalibration;
+	/**
+	 * Gyroscope bias of the latest calibration, removed from the integrated angles.
+	 */
+	FVector GyroBias;
+	/**
+	 * Sums of every motion sample read so far, stamped on each report.
+	 */
+	FMotionIntegral Motion;
+	/**
+	 * Sensor timestamp of the last motion sample fused, valid once `bHasMotionTimestamp` is set.
+	 */
+	uint32 LastMotionTimestamp;
+	bool bHasMotionTimestamp;
+	/**
+	 * Settings of the fusion filter requested by other threads, applied before each sample.
+	 */
+	std::atomic_bool bOrientationResetRequested;
+	std::atomic<float> FusionGain;
+	std::atomic_bool bAutoCalibrationRequested;
+	/**
+	 * Duration of a requested calibration not picked up yet, or a negative value.
+	 */
+	std::atomic<double> RequestedCalibrationSeconds;
+	std::atomic<float> CalibrationProgress;
+	/**
+	 * Guards `LatestCalibration`, which is published with a new `CalibrationVersion`.
+	 */
+	FCriticalSection CalibrationLock;
+	FMotionCalibration LatestCalibration;
+	std::atomic<uint32> CalibrationVersion;
+	std::atomic<uint32> CompletedCalibrations;
+	/**
+	 * Set when a stop has been requested.
+	 */
+	std::atomic_bool bStopRequested;
+	/**
+	 * Set when the device was lost while reading.
+	 */
+	std::atomic_bool bDisconnected;
+	/**
+	 * Count of reports dropped because the channel was full.
+	 */
+	std::atomic<uint64> DroppedReports;
+	/**
+	 * Count of reports discarded because of a CRC mismatch.
+	 */
+	std::atomic<uint64> CrcFailures;
+
+	static std::atomic_bool bCrcValidation;
+};
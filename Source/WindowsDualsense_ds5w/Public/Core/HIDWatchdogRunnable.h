@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include "Core/Interfaces/HidTransport.h"
+#include <atomic>
+#include <chrono>
+
+/**
+ * A single runnable that checks the liveness of every connected HID device.
+ *
+ * Each watched device is pinged through the transport that owns its handle, at its own interval.
+ * Pending pings are kept in a min-heap ordered by due time, so the thread sleeps exactly
+ * until the next ping is due and the cost of a wake-up does not depend on how many devices
+ * are watched. Removing a device only drops it from the device map; its stale heap entry is
+ * discarded when it reaches the top of the heap.
+ *
+ * Pings run with the schedule lock held, so once `RemoveDevice` returns no ping is in flight
+ * for that device and its handle may safely be closed. Destroying the runnable stops the
+ * thread and waits for it to finish.
+ */
+class FHIDWatchdogRunnable final : public FRunnable
+{
+public:
+	/**
+	 * Constructs the watchdog. The thread is only created by `StartThread`.
+	 *
+	 * @param InOnDisconnected Invoked on the watchdog thread, without any lock held, with the
+	 *        identifier of each device whose ping reported a disconnection. The device is no
+	 *        longer watched by the time the callback runs.
+	 */
+	explicit FHIDWatchdogRunnable(TFunction<void(int32 DeviceId)> InOnDisconnected);
+	/**
+	 * Stops the thread, waits for it to finish and releases the wake event.
+	 */
+	virtual ~FHIDWatchdogRunnable() override;
+
+	/**
+	 * Services every ping that is due, then sleeps until the next one or until woken up.
+	 *
+	 * @return `0` once a stop is requested.
+	 */
+	virtual uint32 Run() override;
+	/**
+	 * Requests the thread to stop and wakes it up.
+	 */
+	virtual void Stop() override;
+
+	/**
+	 * Creates the underlying thread.
+	 */
+	void StartThread();
+
+	/**
+	 * Starts watching a device. Replaces any device previously registered with the same identifier.
+	 *
+	 * @param DeviceId Identifier of the device, reported back to the disconnection callback.
+	 * @param DeviceTransport The transport that owns the handle, which every ping goes through.
+	 * @param DeviceHandle The transport handle to ping. It must stay open until `RemoveDevice`
+	 *        returns for this identifier.
+	 * @param Interval The time between two pings of this device.
+	 */
+	void AddDevice(int32 DeviceId, const TSharedPtr<IHidTransport, ESPMode::ThreadSafe>& DeviceTransport,
+	               void* DeviceHandle, std::chrono::milliseconds Interval);
+	/**
+	 * Stops watching a device. Blocks while a ping is in flight, so the handle may be closed
+	 * as soon as this returns.
+	 */
+	void RemoveDevice(int32 DeviceId);
+	/**
+	 * Returns the number of devices currently watched.
+	 */
+	int32 GetNumDevices() const;
+
+private:
+	/**
+	 * A device registered with the watchdog.
+	 */
+	struct FWatchedDevice
+	{
+		TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport;
+		void* Handle = nullptr;
+		double IntervalSeconds = 0.0;
+		/**
+		 * Incremented on every registration, so heap entries left by a removed device are
+		 * never applied to a device registered again under the same identifier.
+		 */
+		uint64 Generation = 0;
+	};
+
+	/**
+	 * A pending ping stored in the heap.
+	 */
+	struct FScheduledPing
+	{
+		double DueTime = 0.0;
+		int32 DeviceId = 0;
+		uint64 Generation = 0;
+
+		bool operator<(const FScheduledPing& Other) const
+		{
+			return DueTime < Other.DueTime;
+		}
+	};
+
+	/**
+	 * Guards `Devices`, `Schedule` and `NextGeneration`, and is held for the duration of every ping.
+	 */
+	mutable FCriticalSection Lock;
+	TMap<int32, FWatchedDevice> Devices;
+	/**
+	 * Min-heap of pending pings, ordered by due time.
+	 */
+	TArray<FScheduledPing> Schedule;
+	uint64 NextGeneration = 0;
+
+	TFunction<void(int32 DeviceId)> OnDisconnected;
+	/**
+	 * Auto-reset event used to wake the thread when a device is added or a stop is requested.
+	 */
+	FEvent* WakeEvent;
+	FRunnableThread* Thread;
+	std::atomic_bool bStopRequested;
+};
@@ -0,0 +1,254 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
+#include "InputCoreTypes.h"
+#include "Core/Structs/FDeviceContext.h"
+#include "Core/Structs/FOutputContext.h"
+#include "Core/Interfaces/HidTransport.h"
+#include <atomic>
+
+class FInputLatencyStats;
+struct FTriggerSequenceData;
+
+/**
+ * A long-lived runnable that writes the output reports of a single HID device.
+ *
+ * Libraries no longer compose and write a report on the calling thread. Each change to the
+ * output state is handed to `Submit`, which only copies the `FOutputContext` into a pending
+ * slot, marks it dirty and wakes the writer. The writer composes the report from the most
+ * recent pending state and writes it, at most once per output interval, so a frame that
+ * changes the lightbar, both triggers and the rumble results in a single write, and the
+ * blocking write never runs on the game thread.
+ *
+ * The writer owns a private copy of the device context, so its output buffer, including the
+ * sequence bits the composer toggles on every report, is never touched by another thread.
+ *
+ * The last report written is kept, and a newly composed report carrying the same payload is
+ * not written; the output buffer is then restored so the toggled bits stay in step with what
+ * the device last received. Over Bluetooth, the last state is written again once the refresh
+ * interval elapsed without any write, to keep the link and the controller state alive.
+ *
+ * The writer also plays trigger effect sequences. While a sequence plays on a trigger, the
+ * writer wakes up every output interval, evaluates the sequence and overrides the effect of
+ * that trigger in the submitted state, so the animation runs at the report rate without any
+ * work on the game thread.
+ * A failed write stops the writer and is reported through `HasFailed`; the owner is
+ * responsible for invalidating the device on its own thread.
+ *
+ * Owners release the writer with `Release`: the last state is written by the writer thread,
+ * and the owner waits for it for at most `ReleaseTimeoutSeconds`.
+ */
+class FHIDWriterRunnable final : public FRunnable
+{
+public:
+	/**
+	 * Default minimum time between two writes, matching the 250 Hz USB report rate.
+	 */
+	static constexpr double DefaultWriteIntervalSeconds = 0.004;
+	/**
+	 * Time without any write after which the last state is written again over Bluetooth.
+	 */
+	static constexpr double BluetoothRefreshIntervalSeconds = 1.0;
+	/**
+	 * Longest time `Release` waits for the writer thread to write the last state and exit.
+	 */
+	static constexpr double ReleaseTimeoutSeconds = 0.1;
+
+	/**
+	 * Constructs a writer for the device described by the given context.
+	 *
+	 * @param InContext The context of the device to write to. The handle must stay open until
+	 *        the writer is destroyed.
+	 * @param InComposer Fills the output buffer of a context from its output state, without writing it.
+	 * @param InStats Optional statistics recording the duration of each write.
+	 * @param InWriteIntervalSeconds Minimum time between two writes.
+	 */
+	FHIDWriterRunnable(const FDeviceContext& InContext, void (*InComposer)(FDeviceContext*),
+	                   TSharedPtr<FInputLatencyStats, ESPMode::ThreadSafe> InStats,
+	                   double InWriteIntervalSeconds = DefaultWriteIntervalSeconds);
+	/**
+	 * Stops the thread and waits for it to finish, without any bound. Owners on the game thread
+	 * use `Release` instead.
+	 */
+	virtual ~FHIDWriterRunnable() override;
+
+	/**
+	 * Stops a writer and destroys it once its thread wrote the last state and exited.
+	 *
+	 * Waits for the thread at most `ReleaseTimeoutSeconds`. A writer still blocked on the device
+	 * after that is parked and destroyed by a later call or by `ReleaseParked`, so the calling
+	 * thread never waits on an unresponsive device. The pointer is always reset.
+	 */
+	static void Release(TUniquePtr<FHIDWriterRunnable>& Writer);
+	/**
+	 * Waits for every writer parked by `Release` and destroys it. Called on module shutdown.
+	 */
+	static void ReleaseParked();
+
+	/**
+	 * Waits for pending output and writes it, never more often than the write interval. Once a
+	 * stop is requested, writes any state still pending so the last change before shutdown,
+	 * such as stopping the rumble, reaches the device. Nothing is written at that point once a
+	 * write failed or `DiscardPending` was called.
+	 *
+	 * @return `0` on a requested stop, `1` when a write failed.
+	 */
+	virtual uint32 Run() override;
+	/**
+	 * Requests the thread to stop and wakes it up.
+	 */
+	virtual void Stop() override;
+	/**
+	 * Signals the owner that the thread no longer touches the device.
+	 */
+	virtual void Exit() override;
+
+	/**
+	 * Creates the underlying thread.
+	 */
+	void StartThread();
+
+	/**
+	 * Queues an output state to be written. Replaces any state that was not written yet.
+	 *
+	 * Never blocks on the device; safe to call from any thread.
+	 */
+	void Submit(const FOutputContext& Output);
+
+	/**
+	 * Plays a trigger effect sequence, replacing any sequence playing on the same trigger.
+	 *
+	 * Safe to call from any thread.
+	 *
+	 * @param Sequence The sequence to play, or nullptr to stop the current one.
+	 * @param Hand The trigger, or both for `AnyHand`.
+	 */
+	void PlayTriggerSequence(TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe> Sequence, EControllerHand Hand);
+
+	/**
+	 * Drops the state still pending when the writer stops, for a device known to be lost, so
+	 * the last write is never attempted on a dead handle. Safe to call from any thread.
+	 */
+	void DiscardPending()
+	{
+		bDiscardPending.store(true, std::memory_order_release);
+	}
+	/**
+	 * Indicates whether a write to the device failed.
+	 */
+	bool HasFailed() const
+	{
+		return bFailed.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Number of states passed to `Submit`.
+	 */
+	uint64 GetSubmittedCount() const
+	{
+		return SubmittedCount.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Number of reports written to the device.
+	 */
+	uint64 GetWrittenCount() const
+	{
+		return WrittenCount.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Number of composed reports not written because they matched the last one sent.
+	 */
+	uint64 GetSkippedCount() const
+	{
+		return SkippedCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	/**
+	 * Composes the pending state, if any, and writes it unless it matches the last report sent.
+	 *
+	 * @param bRefresh Writes the current state even if nothing is pending or it is unchanged.
+	 * @return False if the write failed.
+	 */
+	bool WritePending(bool bRefresh = false);
+	/**
+	 * Overrides the trigger effects of the context with the sequences playing at the given time
+	 * and forgets the sequences that are over.
+	 */
+	void ApplyTriggerSequences(double NowSeconds);
+	bool IsPlayingSequence() const
+	{
+		return Sequences[0].Data.IsValid() || Sequences[1].Data.IsValid();
+	}
+
+	struct FSequencePlayback
+	{
+		TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe> Data;
+		/**
+		 * Time the first report of the sequence was composed, valid once `bStarted` is set.
+		 */
+		double StartSeconds = 0.0;
+		bool bStarted = false;
+	};
+
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport;
+	/**
+	 * Private copy of the device context, only accessed by the writer.
+	 */
+	FDeviceContext Context;
+	void (*Composer)(FDeviceContext*);
+	TSharedPtr<FInputLatencyStats, ESPMode::ThreadSafe> Stats;
+	double WriteIntervalSeconds;
+	double LastWriteSeconds;
+	/**
+	 * Keep-alive interval, zero when the connection does not need one.
+	 */
+	double RefreshIntervalSeconds;
+	/**
+	 * The report last written to the device, valid once `bHasSent` is set.
+	 */
+	unsigned char LastSent[sizeof(FDeviceContext::BufferOutput)];
+	bool bHasSent;
+
+	/**
+	 * Last submitted state, the base every report is composed from.
+	 */
+	FOutputContext Latest;
+	/**
+	 * Sequences playing on the left and right triggers, only accessed by the writer.
+	 */
+	FSequencePlayback Sequences[2];
+
+	/**
+	 * Guards `Pending`, `bDirty` and the requested sequences.
+	 */
+	FCriticalSection PendingLock;
+	FOutputContext Pending;
+	bool bDirty;
+	TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe> RequestedSequences[2];
+	bool bSequenceRequested[2];
+
+	/**
+	 * Auto-reset event used to wake the thread when a state is submitted or a stop is requested.
+	 */
+	FEvent* WakeEvent;
+	/**
+	 * Manual-reset event triggered once `Run` returned.
+	 */
+	FEvent* FinishedEvent;
+	FRunnableThread* Thread;
+	std::atomic_bool bStopRequested;
+	std::atomic_bool bFailed;
+	std::atomic_bool bDiscardPending;
+	std::atomic<uint64> SubmittedCount;
+	std::atomic<uint64> WrittenCount;
+	std::atomic<uint64> SkippedCount;
+};
@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("DualSense"), STATGROUP_DualSense, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateInput"), STAT_DualSense_UpdateInput, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DispatchButtons"), STAT_DualSense_DispatchButtons, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SendOut"), STAT_DualSense_SendOut, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Reports Consumed"), STAT_DualSense_ReportsConsumed, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Button Events"), STAT_DualSense_ButtonEvents, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Analog Events"), STAT_DualSense_AnalogEvents, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Analog Events Suppressed"), STAT_DualSense_AnalogSuppressed, STATGROUP_DualSense, WINDOWSDUALSENSE_DS5W_API);
+
+/**
+ * @brief Lock-free latency histogram with logarithmic buckets and bounded relative error.
+ *
+ * Values are recorded in microseconds. Below 16 us every value has its own bucket; above,
+ * each power of two is split into 16 linear sub-buckets, in the spirit of HDR histograms, so
+ * any recorded value is reported with at most 1/16 relative error up to about 16 seconds.
+ * Larger values are clamped into the last bucket.
+ *
+ * Recording is a couple of relaxed atomic increments, safe from any thread, and the
+ * histogram can be read concurrently while being recorded into.
+ */
+class WINDOWSDUALSENSE_DS5W_API FLatencyHistogram
+{
+public:
+	static constexpr uint32 SubBucketBits = 4;
+	static constexpr uint32 SubBucketCount = 1u << SubBucketBits;
+	static constexpr uint32 MaxExponent = 23;
+	static constexpr uint32 NumBuckets = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+	FLatencyHistogram();
+
+	/**
+	 * Records one sample, in microseconds.
+	 */
+	void Record(uint64 Microseconds);
+	/**
+	 * Records the time elapsed between two `FPlatformTime::Cycles64` readings.
+	 */
+	void RecordCycles(const uint64 StartCycles, const uint64 EndCycles)
+	{
+		Record(EndCycles > StartCycles ? static_cast<uint64>(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1000000.0) : 0);
+	}
+
+	/**
+	 * Clears every sample.
+	 */
+	void Reset();
+
+	uint64 GetCount() const
+	{
+		return Count.load(std::memory_order_relaxed);
+	}
+
+	uint64 GetMax() const
+	{
+		return MaxValue.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Mean of the recorded samples, in microseconds.
+	 */
+	double GetMean() const;
+	/**
+	 * Value below which the given fraction of the samples fall, in microseconds.
+	 *
+	 * @param Percentile A value in [0, 100].
+	 */
+	uint64 GetPercentile(double Percentile) const;
+	/**
+	 * Formats the count, mean, p50, p90, p99 and max of the histogram on one line.
+	 */
+	FString ToString() const;
+
+private:
+	static uint32 GetBucketIndex(uint64 Value);
+	static uint64 GetBucketValue(uint32 Index);
+
+	std::atomic<uint32> Buckets[NumBuckets];
+	std::atomic<uint64> Count;
+	std::atomic<uint64> Sum;
+	std::atomic<uint64> MaxValue;
+};
+
+/**
+ * @brief Latency histograms and counters kept for one controller.
+ *
+ * Nothing is recorded while instrumentation is disabled, which is the default: each
+ * instrumented site then only pays for a relaxed load of a global flag. Instrumentation is
+ * toggled with the `DUALSENSE STATS ON|OFF` console command.
+ */
+class WINDOWSDUALSENSE_DS5W_API FInputLatencyStats
+{
+public:
+	/**
+	 * Whether latency instrumentation is currently enabled.
+	 */
+	static bool IsEnabled()
+	{
+		return bEnabled.load(std::memory_order_relaxed);
+	}
+
+	static void SetEnabled(const bool bInEnabled)
+	{
+		bEnabled.store(bInEnabled, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Time from the read of a report completing on the reader thread to the game thread consuming it.
+	 */
+	FLatencyHistogram ReadLatency;
+	/**
+	 * Time spent in `UpdateInput` for one tick, parsing and dispatching every pending report.
+	 */
+	FLatencyHistogram ParseTime;
+	/**
+	 * Time spent dispatching the buttons of one report to the message handler.
+	 */
+	FLatencyHistogram DispatchTime;
+	/**
+	 * Time from the read of a report completing to the press or release event it triggered being fired.
+	 */
+	FLatencyHistogram InputToEvent;
+	/**
+	 * Time spent composing and writing one output report, on the writer thread.
+	 */
+	FLatencyHistogram OutputWrite;
+
+	std::atomic<uint64> ReportsConsumed{0};
+	std::atomic<uint64> ButtonEvents{0};
+	std::atomic<uint64> OutputSubmits{0};
+	std::atomic<uint64> OutputWrites{0};
+	std::atomic<uint64> OutputSkips{0};
+
+	/**
+	 * Clears every histogram and counter.
+	 */
+	void Reset();
+	/**
+	 * Writes every histogram and counter to the given output device, one per line.
+	 *
+	 * @param Ar The output device.
+	 * @param DroppedReports Number of reports the reader dropped, reported alongside the counters.
+	 * @param CrcFailures Number of reports the reader discarded because of a CRC mismatch.
+	 */
+	void Dump(FOutputDevice& Ar, uint64 DroppedReports, uint64 CrcFailures) const;
+
+private:
+	static std::atomic_bool bEnabled;
+};
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Structs/FDeviceContext.h"
+
+/**
+ * @brief Outcome of a single read or ping issued against a transport.
+ */
+enum class EPollResult {
+	ReadOk,
+	NoIoThisTick,
+	TransientError,
+	Disconnected
+};
+
+/**
+ * @brief Receives the reports of a read stream serviced by a reader thread shared by many
+ *        devices, see `IHidTransport::AttachReader`.
+ *
+ * Calls for one stream are never made concurrently, and always from the shared reader thread.
+ */
+class WINDOWSDUALSENSE_DS5W_API IHidReportSink
+{
+public:
+	virtual ~IHidReportSink() = default;
+
+	/**
+	 * @brief Returns the buffer the next report of the stream is read into.
+	 *
+	 * @param OutLength Receives the number of bytes requested from the device.
+	 */
+	virtual unsigned char* GetReportBuffer(size_t& OutLength) = 0;
+	/**
+	 * @brief Called once a report was read into the buffer returned by `GetReportBuffer`.
+	 *
+	 * @param BytesRead Number of bytes of the report.
+	 */
+	virtual void OnReport(size_t BytesRead) = 0;
+	/**
+	 * @brief Called once the device is lost. The stream is no longer serviced afterwards.
+	 */
+	virtual void OnDisconnected() = 0;
+};
+
+/**
+ * @brief Abstraction over the operating system layer used to talk to HID devices.
+ *
+ * Every operation performed by `FHIDDeviceInfo` and the device readers goes through a
+ * transport, so the rest of the plugin never touches platform APIs. Implementations are
+ * expected to be thread safe: detection runs on a background task, reads run on the reader
+ * threads and writes run on the writer threads.
+ *
+ * Device handles and read streams are opaque pointers owned by the transport that
+ * created them. A transport returns `InvalidHandle()` from `Open` when a device cannot
+ * be opened, matching the value stored in `FDeviceContext::Handle` for closed devices.
+ */
+class WINDOWSDUALSENSE_DS5W_API IHidTransport
+{
+public:
+	virtual ~IHidTransport() = default;
+
+	/**
+	 * @brief Pause, in seconds, a reader takes after a read failed with a transient error, and
+	 *        the number of such failures in a row after which the device is treated as lost.
+	 *
+	 * Shared by the per-device reader threads and the shared readers of the transports, so a
+	 * device is given the same time to recover whichever thread reads it.
+	 */
+	static constexpr float TransientErrorBackoffSeconds = 0.005f;
+	static constexpr uint32 MaxTransientErrors = 100;
+
+	/**
+	 * @brief Sentinel value representing a device handle that is not open.
+	 */
+	static void* InvalidHandle()
+	{
+		return reinterpret_cast<void*>(static_cast<intptr_t>(-1));
+	}
+
+	/**
+	 * @brief Enumerates the supported controllers currently present.
+	 *
+	 * @param Devices Receives one context per detected controller, with path, device type
+	 *        and connection type filled in.
+	 */
+	virtual void Detect(TArray<FDeviceContext>& Devices) = 0;
+	/**
+	 * @brief Opens a handle used for output reports and pings.
+	 *
+	 * @param Context The context describing the device to open.
+	 * @return The opened handle, or `InvalidHandle()` on failure.
+	 */
+	virtual void* Open(const FDeviceContext& Context) = 0;
+	/**
+	 * @brief Closes a handle returned by `Open`.
+	 */
+	virtual void Close(void* Handle) = 0;
+	/**
+	 * @brief Sends one output report to an open handle.
+	 *
+	 * @return True if the whole report was written, false on failure.
+	 */
+	virtual bool Write(void* Handle, const unsigned char* Buffer, size_t Length) = 0;
+	/**
+	 * @brief Checks whether the device behind a handle is still reachable.
+	 *
+	 * @return ReadOk when the device answered, Disconnected when it is gone, or
+	 *         TransientError for any other failure.
+	 */
+	virtual EPollResult Ping(void* Handle) = 0;
+
+	/**
+	 * @brief Opens a dedicated read stream used by a reader thread.
+	 *
+	 * @return An opaque read stream, or nullptr if the device could not be opened.
+	 */
+	virtual void* OpenReader(const FDeviceContext& Context) = 0;
+	/**
+	 * @brief Blocks until the next input report arrives on a read stream.
+	 *
+	 * Returns when a report was read, when the device is lost, or when `CancelRead`
+	 * is called from another thread, in which case NoIoThisTick is returned.
+	 */
+	virtual EPollResult ReadReport(void* Reader, unsigned char* Buffer, size_t Length, size_t& OutBytesRead) = 0;
+	/**
+	 * @brief Wakes up a read blocking on the given stream. Safe to call from any thread.
+	 */
+	virtual void CancelRead(void* Reader) = 0;
+	/**
+	 * @brief Releases a read stream. Must not be in use by another thread.
+	 */
+	virtual void CloseReader(void* Reader) = 0;
+	/**
+	 * @brief Hands a read stream to a reader thread shared by every stream of the transport.
+	 *
+	 * Transports that can wait on many devices at once read the stream on that thread and
+	 * deliver each report to the sink, so no thread is needed per device. The others keep
+	 * the default implementation, and the caller reads the stream on its own thread with
+	 * `ReadReport`.
+	 *
+	 * @param Reader A read stream returned by `OpenReader`.
+	 * @param Sink Receives the reports until `DetachReader` returns or the device is lost.
+	 * @return True if the transport services the stream, false if the caller must read it.
+	 */
+	virtual bool AttachReader(void* Reader, IHidReportSink& Sink)
+	{
+		return false;
+	}
+	/**
+	 * @brief Stops servicing a stream passed to `AttachReader`. Once this returns, the sink is
+	 *        no longer called and the stream may be closed.
+	 */
+	virtual void DetachReader(void* Reader)
+	{
+	}
+
+	/**
+	 * @brief Starts reporting device arrivals and removals.
+	 *
+	 * The callback may be invoked from any thread, possibly several times for a single
+	 * physical change, and must only flag that an enumeration is needed. Transports that
+	 * cannot watch for changes keep the default implementation, and callers fall back to
+	 * polling `Detect`.
+	 *
+	 * @param OnDevicesChanged Invoked whenever a HID device may have appeared or disappeared.
+	 * @return True if notifications are active, false if the caller must poll instead.
+	 */
+	virtual bool StartDeviceNotifications(TFunction<void()> OnDevicesChanged)
+	{
+		return false;
+	}
+	/**
+	 * @brief Stops the notifications started by `StartDeviceNotifications`. Once this
+	 *        returns, the callback is no longer invoked.
+	 */
+	virtual void StopDeviceNotifications()
+	{
+	}
+};
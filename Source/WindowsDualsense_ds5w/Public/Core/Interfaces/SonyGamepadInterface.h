@@ -15,6 +15,14 @@
 #include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
 #include "SonyGamepadInterface.generated.h"
 
+class FInputReportHistory;
+class FInputLatencyStats;
+struct FGamepadState;
+struct FMotionDelta;
+class FMotionBatch;
+struct FTouchGestureSettings;
+class FAnalogDeltaFilter;
+
 USTRUCT(BlueprintType)
 struct FFeatureReport
 {
@@ -129,6 +137,21 @@ public:
 	 * @param bIsTouch A boolean indicating whether touch input is enabled (true) or disabled (false).
 	 */
 	virtual void EnableTouch(const bool bIsTouch) = 0;
+	/**
+	 * Enables or disables recognizing taps, swipes, pinches and scrolls on the touchpad, see
+	 * `FTouchGestureRecognizer`.
+	 *
+	 * @param bEnable True to send the gesture keys and axes; they are off until enabled.
+	 */
+	virtual void EnableTouchGestures(bool bEnable)
+	{
+	}
+	/**
+	 * Replaces the thresholds of the touchpad gesture recognizer.
+	 */
+	virtual void SetTouchGestureSettings(const FTouchGestureSettings& Settings)
+	{
+	}
 	/**
 	 * Enables the motion sensor functionality of the gamepad.
 	 *
@@ -150,6 +173,15 @@ public:
 	 * @return True if the calibration status was successfully retrieved, false otherwise.
 	 */
 	virtual bool GetMotionSensorCalibrationStatus(float& OutProgress) = 0;
+	/**
+	 * Enables or disables measuring the gyroscope bias in the background whenever the gamepad
+	 * rests, so motion stays calibrated without a calibration step.
+	 *
+	 * @param bEnable True to recalibrate automatically, which is the default.
+	 */
+	virtual void EnableMotionAutoCalibration(bool bEnable)
+	{
+	}
 	/**
 	 * Stops all currently active operations or actions associated with the interface.
 	 * This method must be implemented by any derived class to handle the termination
@@ -184,4 +216,131 @@ public:
 	 * @param InputDeviceId The identifier for the input device being updated.
 	 */
 	virtual void UpdateInput(const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler, const FPlatformUserId UserId, const FInputDeviceId InputDeviceId) = 0;
+	/**
+	 * Retrieves the recent raw input reports of the gamepad, each stamped with the host time
+	 * at which it was read and the sensor timestamp of the device.
+	 *
+	 * Only valid on the game thread, and only until the library is shut down.
+	 *
+	 * @return The report history, or nullptr if the device has no active reader.
+	 */
+	virtual const FInputReportHistory* GetInputReportHistory() const
+	{
+		return nullptr;
+	}
+	/**
+	 * Retrieves the latency histograms and counters recorded for the gamepad while
+	 * instrumentation is enabled.
+	 *
+	 * @return The statistics, or nullptr if the gamepad does not record any.
+	 */
+	virtual FInputLatencyStats* GetLatencyStats()
+	{
+		return nullptr;
+	}
+	/**
+	 * Retrieves the number of input reports dropped because they were not consumed in time.
+	 */
+	virtual uint64 GetDroppedReports() const
+	{
+		return 0;
+	}
+	/**
+	 * Retrieves the number of Bluetooth input reports discarded because their CRC did not match.
+	 */
+	virtual uint64 GetCrcFailures() const
+	{
+		return 0;
+	}
+	/**
+	 * Retrieves the input state decoded from the most recent report of the gamepad.
+	 *
+	 * The state is refreshed by UpdateInput, once per input tick, and can be polled from the
+	 * game thread by systems that only need raw values, without going through the message
+	 * handler.
+	 *
+	 * @param OutState Receives the latest state.
+	 * @return False if no report has been decoded yet.
+	 */
+	virtual bool GetGamepadState(FGamepadState& OutState) const
+	{
+		return false;
+	}
+	/**
+	 * Retrieves the orientation of the gamepad fused from its motion sensors.
+	 *
+	 * The estimate is updated on the reader thread for every report, at the native rate of
+	 * the controller, and refreshed here by UpdateInput. See `FMotionFusionFilter` for its frame.
+	 *
+	 * @param OutOrientation Receives the latest orientation.
+	 * @return False if no report has been read yet or the gamepad has no motion sensors.
+	 */
+	virtual bool GetMotionOrientation(FQuat& OutOrientation) const
+	{
+		return false;
+	}
+	/**
+	 * Adds the motion of the last UpdateInput to the batch processed once for every gamepad
+	 * of the tick, see `FMotionBatch`.
+	 *
+	 * @param Batch The batch of the tick.
+	 * @return The slot of the gamepad, or INDEX_NONE if it has no motion event to dispatch.
+	 */
+	virtual int32 AddMotionToBatch(FMotionBatch& Batch)
+	{
+		return INDEX_NONE;
+	}
+	/**
+	 * Forwards the motion of the gamepad to the message handler once the batch was processed.
+	 *
+	 * @param Batch The processed batch of the tick.
+	 * @param Slot The slot returned by AddMotionToBatch.
+	 */
+	virtual void DispatchMotion(const FMotionBatch& Batch, int32 Slot,
+	                            const TSharedRef<FGenericApplicationMessageHandler>& InMessageHandler,
+	                            const FPlatformUserId UserId, const FInputDeviceId InputDeviceId)
+	{
+	}
+	/**
+	 * Retrieves the motion of the gamepad between the two last calls to UpdateInput.
+	 *
+	 * Integrated by the reader thread from every motion sample, at the native rate of the
+	 * controller, so the rotation is exact whatever the tick rate and no sample is lost.
+	 *
+	 * @param OutDelta Receives the motion of the last tick.
+	 * @return False if no report has been read yet or the gamepad has no motion sensors.
+	 */
+	virtual bool GetMotionDelta(FMotionDelta& OutDelta) const
+	{
+		return false;
+	}
+	/**
+	 * Restarts orientation tracking: pitch and roll are taken again from gravity and the
+	 * current heading becomes yaw zero.
+	 */
+	virtual void ResetMotionOrientation()
+	{
+	}
+	/**
+	 * Enables or disables forwarding input to the application message handler.
+	 *
+	 * While disabled, UpdateInput still decodes the latest report into the state returned by
+	 * GetGamepadState, but fires no button, analog, touch or motion events. Buttons held or
+	 * released in the meantime are reported once dispatch is enabled again.
+	 *
+	 * @param bEnable True to forward input to the message handler, which is the default.
+	 */
+	virtual void EnableMessageHandlerDispatch(bool bEnable)
+	{
+	}
+	/**
+	 * Retrieves the filter deciding which analog axes are forwarded to the message handler,
+	 * used to switch to delta-only dispatch and to read how many events it saved.
+	 *
+	 * @return The filter, or nullptr if the gamepad has no analog axes.
+	 */
+	virtual FAnalogDeltaFilter* GetAnalogFilter()
+	{
+		return nullptr;
+	}
 };
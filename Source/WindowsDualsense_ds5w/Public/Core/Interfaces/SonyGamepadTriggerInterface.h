@@ -7,8 +7,11 @@
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
 #include "Templates/SharedPointer.h"
+#include "Core/Structs/FTriggerEffectBlob.h"
 #include "SonyGamepadTriggerInterface.generated.h"
 
+struct FTriggerSequenceData;
+
 // This class does not need to be modified.
 UINTERFACE()
 class USonyGamepadTriggerInterface : public UInterface
@@ -119,6 +122,20 @@ public:
 	 * @param Hand An enum indicating which controller hand's trigger effects should be stopped.
 	 */
 	virtual void StopTrigger(const EControllerHand& Hand) = 0;
+	/**
+	 * Applies an adaptive trigger effect encoded ahead of time, see `FTriggerEffectCache`.
+	 *
+	 * @param Effect The encoded effect. An empty handle is ignored.
+	 * @param Hand The controller hand to which the effect will be applied.
+	 */
+	virtual void SetTriggerEffect(const FTriggerEffectBlob& Effect, const EControllerHand& Hand) = 0;
+	/**
+	 * Plays a trigger effect sequence on the output thread of the gamepad, see `UTriggerEffectSequence`.
+	 *
+	 * @param Sequence The snapshot of the sequence to play, or nullptr to stop the current one.
+	 * @param Hand The controller hand whose trigger plays the sequence.
+	 */
+	virtual void PlayTriggerSequence(const TSharedPtr<const FTriggerSequenceData, ESPMode::ThreadSafe>& Sequence, const EControllerHand& Hand) = 0;
 	/**
 	 * Configures the gamepad vibration based on audio feedback parameters.
 	 *
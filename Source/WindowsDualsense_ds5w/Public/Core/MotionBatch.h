@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Motion samples of every controller of a tick, laid out as a structure of arrays.
+ *
+ * Each library adds the motion of its last update to the batch, which splits the gyroscope
+ * and accelerometer axes into one array per channel along with the bias and dead zone of the
+ * device. `Process` then bias-corrects and dead-zones all the devices at once with
+ * 4-wide vector operations (SSE on x64, NEON on ARM), after which each library reads its slot
+ * back to dispatch its motion event.
+ *
+ * Arrays are 16-byte aligned and padded to a multiple of four devices; padding lanes are
+ * zero-filled and their results ignored. Storage grows with the number of devices and is then
+ * reused every tick without allocating.
+ *
+ * Only used from the game thread.
+ */
+class WINDOWSDUALSENSE_DS5W_API FMotionBatch
+{
+public:
+	/**
+	 * Gyroscope X, Y and Z, then accelerometer X, Y and Z.
+	 */
+	static constexpr int32 NumChannels = 6;
+	static constexpr int32 Lanes = 4;
+
+	/**
+	 * Empties the batch, keeping its storage.
+	 */
+	void Reset();
+
+	/**
+	 * Adds the motion of one device.
+	 *
+	 * @param Gyro Angular velocity, in raw counts.
+	 * @param Accel Acceleration, in raw counts.
+	 * @param GyroBias Gyroscope reading at rest, subtracted from the angular velocity.
+	 * @param AccelBias Accelerometer reading at rest, subtracted from the acceleration.
+	 * @param GyroDeadZone Smallest bias-corrected angular velocity that is not zeroed, per axis.
+	 * @param AccelDeadZone Smallest bias-corrected acceleration that is not zeroed, per axis.
+	 * @return The slot of the device, to read its results with `GetGyro` and `GetAccel`.
+	 */
+	int32 Add(const FVector& Gyro, const FVector& Accel, const FVector& GyroBias, const FVector& AccelBias,
+	          const FVector& GyroDeadZone, const FVector& AccelDeadZone);
+
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	/**
+	 * Processes every slot with the vector kernel.
+	 */
+	void Process();
+	/**
+	 * Processes every slot one value at a time; the reference for the vector kernel.
+	 */
+	void ProcessScalar();
+
+	/**
+	 * Results of a slot once processed, in raw counts like the readings they come from.
+	 */
+	FVector GetGyro(const int32 Slot) const
+	{
+		return FVector(Output[0][Slot], Output[1][Slot], Output[2][Slot]);
+	}
+
+	FVector GetAccel(const int32 Slot) const
+	{
+		return FVector(Output[3][Slot], Output[4][Slot], Output[5][Slot]);
+	}
+
+	/**
+	 * Times both kernels over a synthetic batch and logs the results, for `DUALSENSE MOTIONBENCH`.
+	 *
+	 * @param NumDevices Number of devices in the batch.
+	 * @param Iterations Number of times each kernel processes the batch.
+	 * @param Ar The output device to log to.
+	 */
+	static void Benchmark(int32 NumDevices, int32 Iterations, FOutputDevice& Ar);
+
+private:
+	using FChannel = TArray<float, TAlignedHeapAllocator<16>>;
+
+	int32 Count = 0;
+	FChannel Input[NumChannels];
+	FChannel Bias[NumChannels];
+	FChannel DeadZone[NumChannels];
+	FChannel Output[NumChannels];
+};
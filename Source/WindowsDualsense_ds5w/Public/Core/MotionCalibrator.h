@@ -0,0 +1,169 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Running mean and variance of the six motion channels, updated one sample at a time.
+ *
+ * Uses Welford's recurrence, so the statistics of any number of samples take constant memory
+ * and stay accurate when the variance is tiny next to the mean, as with a gyroscope bias.
+ * Channels 0 to 2 are the gyroscope axes and 3 to 5 the accelerometer axes.
+ */
+struct FMotionWelford
+{
+	static constexpr int32 NumChannels = 6;
+
+	uint32 Count = 0;
+	double Mean[NumChannels] = {};
+	double M2[NumChannels] = {};
+
+	void Reset()
+	{
+		*this = FMotionWelford();
+	}
+
+	void Add(const int16 (&Gyro)[3], const int16 (&Accel)[3])
+	{
+		++Count;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			const double Value = Channel < 3 ? Gyro[Channel] : Accel[Channel - 3];
+			const double Delta = Value - Mean[Channel];
+			Mean[Channel] += Delta / Count;
+			M2[Channel] += Delta * (Value - Mean[Channel]);
+		}
+	}
+
+	double Variance(const int32 Channel) const
+	{
+		return Count > 1 ? M2[Channel] / (Count - 1) : 0.0;
+	}
+};
+
+/**
+ * @brief Result of a motion sensor calibration, in raw sensor counts.
+ */
+struct FMotionCalibration
+{
+	/**
+	 * Mean reading of each sensor while the controller was still.
+	 */
+	FVector GyroMean = FVector::ZeroVector;
+	FVector AccelMean = FVector::ZeroVector;
+	/**
+	 * Standard deviation of each sensor while the controller was still, its noise level.
+	 */
+	FVector GyroStdDev = FVector::ZeroVector;
+	FVector AccelStdDev = FVector::ZeroVector;
+	/**
+	 * Number of samples the result was computed from.
+	 */
+	uint32 SampleCount = 0;
+	/**
+	 * Whether the result comes from a requested calibration, or from the stillness detector
+	 * in which case only the gyroscope values are meaningful.
+	 */
+	bool bExplicit = false;
+};
+
+/**
+ * @brief Calibrates the motion sensors of a controller from every raw report.
+ *
+ * Fed by the reader thread with the raw samples of each report, stamped with the sensor
+ * clock, so a calibration window of a given length always holds every sample the controller
+ * sent during it, at 250 to 1000 Hz, instead of one per game tick.
+ *
+ * Two kinds of calibration run side by side:
+ * - A requested calibration collects the statistics of every sample over a fixed duration,
+ *   still or not, as `StartMotionSensorCalibration` always did.
+ * - The stillness detector keeps a window of consecutive samples that all stay within a small
+ *   band around the window mean. Once the window spans `StillSeconds`, the controller is
+ *   resting, and the window mean becomes the new gyroscope bias. Any sample outside of the band
+ *   restarts the window, so moving the controller never biases the result. A slow steady
+ *   rotation stays within the band too, so the window mean must also lie close to the current
+ *   bias, or close to zero before the first calibration, for the window to be accepted.
+ *
+ * Only used from the reader thread.
+ */
+class WINDOWSDUALSENSE_DS5W_API FMotionCalibrator
+{
+public:
+	/**
+	 * Time the controller has to stay still before its gyroscope bias is measured again.
+	 */
+	static constexpr double StillSeconds = 1.5;
+	/**
+	 * Largest distance, in raw counts, from the window mean that still counts as resting:
+	 * about 1.5 degrees per second for the gyroscope and 0.05 g for the accelerometer.
+	 */
+	static constexpr double GyroStillBand = 24.0;
+	static constexpr double AccelStillBand = 410.0;
+	/**
+	 * Largest distance, in raw counts, on any gyroscope axis between the mean of a resting
+	 * window and the current bias, about 1 degree per second. Before the first calibration the
+	 * mean is compared with zero against `MaxGyroBias` instead, about 5 degrees per second.
+	 */
+	static constexpr double GyroBiasTolerance = 16.0;
+	static constexpr double MaxGyroBias = 80.0;
+
+	/**
+	 * Starts a requested calibration of the given duration, in sensor time. Discards any
+	 * calibration in progress.
+	 */
+	void Begin(double DurationSeconds);
+
+	/**
+	 * Adds one sample.
+	 *
+	 * @param Gyro Raw angular velocity.
+	 * @param Accel Raw acceleration.
+	 * @param DeltaSeconds Sensor time elapsed since the previous sample, zero for the first one.
+	 * @param OutResult Receives a new calibration when this sample completes one.
+	 * @return True when a requested calibration finished or the controller was found resting.
+	 */
+	bool Add(const int16 (&Gyro)[3], const int16 (&Accel)[3], double DeltaSeconds, FMotionCalibration& OutResult);
+
+	/**
+	 * Progress of the requested calibration, from 0 to 1, or a negative value when none runs.
+	 */
+	double GetProgress() const
+	{
+		return RequestedDuration > 0.0 ? FMath::Min(RequestedElapsed / RequestedDuration, 1.0) : -1.0;
+	}
+
+	/**
+	 * Enables or disables the stillness detector, which is enabled by default.
+	 */
+	void SetAutoCalibration(const bool bEnable)
+	{
+		bAutoCalibration = bEnable;
+		Still.Reset();
+		StillElapsed = 0.0;
+	}
+
+private:
+	static FMotionCalibration ToResult(const FMotionWelford& Stats, bool bExplicit);
+	/**
+	 * Whether the gyroscope mean of a resting window is close enough to the known bias to be
+	 * a rest rather than a steady rotation.
+	 */
+	bool IsNearGyroBias(const FMotionWelford& Stats) const;
+
+	FMotionWelford Requested;
+	double RequestedDuration = 0.0;
+	double RequestedElapsed = 0.0;
+
+	FMotionWelford Still;
+	double StillElapsed = 0.0;
+	bool bAutoCalibration = true;
+
+	/**
+	 * Gyroscope mean of the last calibration of either kind, valid once `bHasGyroBias` is set.
+	 */
+	FVector GyroBias = FVector::ZeroVector;
+	bool bHasGyroBias = false;
+};
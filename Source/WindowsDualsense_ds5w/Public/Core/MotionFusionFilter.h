@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Estimates the orientation of a controller from its gyroscope and accelerometer.
+ *
+ * Implements the IMU variant of Madgwick's gradient descent filter: every sample integrates
+ * the angular velocity, then corrects the estimate by one step towards the orientation in
+ * which the measured acceleration points up, weighted by `Gain`. Pitch and roll therefore
+ * stay anchored to gravity however long the controller is tracked, while yaw only drifts by
+ * the residual gyroscope bias, which is removed before integration when one is known.
+ *
+ * The filter works in the sensor frame of the PlayStation controllers (X to the right,
+ * Y out of the face, Z towards the player) and reports its estimate in the Unreal frame of
+ * the controller held flat: X forward, away from the player, Y to the right and Z up. The
+ * first sample after a reset sets pitch and roll from gravity; yaw starts at zero.
+ *
+ * Owned and updated by the reader thread of a device, one sample per input report.
+ */
+class WINDOWSDUALSENSE_DS5W_API FMotionFusionFilter
+{
+public:
+	/**
+	 * Raw gyroscope counts per degree per second, shared by the DualSense and DualShock 4.
+	 */
+	static constexpr float GyroCountsPerDegree = 16.0f;
+	/**
+	 * Default weight of the accelerometer correction, in radians per second. Higher values
+	 * converge faster after a reset but let more of the hand's acceleration into the estimate.
+	 */
+	static constexpr float DefaultGain = 0.1f;
+	/**
+	 * Longest interval integrated as a single step. Longer gaps between samples, such as the
+	 * first report or a stalled link, are skipped rather than integrated.
+	 */
+	static constexpr double MaxStepSeconds = 0.05;
+
+	FMotionFusionFilter();
+
+	/**
+	 * Integrates one raw sample.
+	 *
+	 * @param Gyro Raw angular velocity, in sensor counts.
+	 * @param Accel Raw acceleration, in sensor counts. Only its direction is used.
+	 * @param DeltaSeconds Time elapsed since the previous sample, from the sensor clock.
+	 */
+	void Update(const int16 (&Gyro)[3], const int16 (&Accel)[3], double DeltaSeconds);
+
+	/**
+	 * Restarts tracking from the identity.
+	 */
+	void Reset();
+
+	/**
+	 * Current estimate, in the Unreal frame described above.
+	 */
+	FQuat GetOrientation() const;
+
+	/**
+	 * Sets the weight of the accelerometer correction once the filter converged.
+	 */
+	void SetGain(const float InGain)
+	{
+		Gain = FMath::Max(0.0f, InGain);
+	}
+
+	/**
+	 * Sets the gyroscope bias subtracted from every sample, in raw counts.
+	 */
+	void SetGyroBias(const FVector3f& InBias)
+	{
+		GyroBias = InBias;
+	}
+
+private:
+	/**
+	 * Orientation in the right-handed filter frame (X right, Y forward, Z up), scalar first.
+	 */
+	float Q0, Q1, Q2, Q3;
+	float Gain;
+	FVector3f GyroBias;
+	/**
+	 * False until the first sample after a reset, which aligns the estimate with gravity.
+	 */
+	bool bInitialized;
+};
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief CRC32 used by the Bluetooth reports of PlayStation controllers.
+ *
+ * The checksum is the standard reflected CRC32 (polynomial 0xEDB88320) of the report,
+ * prefixed with a transaction header byte (0xA2 for output reports, 0xA1 for input reports).
+ * `FPlayStationOutputComposer::Compute` is the byte-at-a-time reference; this class provides
+ * faster variants operating on the raw CRC state, so a constant prefix can be folded into a
+ * precomputed state and only the variable part of a report is hashed at runtime:
+ *
+ * - slicing-by-8 tables, available everywhere;
+ * - carry-less multiplication folding (PCLMULQDQ) on x86 CPUs that support it;
+ * - the CRC32 instructions of ARMv8 when the compiler targets them.
+ *
+ * The fastest variant available is selected on first use, after checking it against the
+ * reference implementation; a variant that disagrees is never used.
+ */
+class WINDOWSDUALSENSE_DS5W_API FPlayStationCrc32
+{
+public:
+	/**
+	 * Implementations of `Update`, from the slowest to the fastest.
+	 */
+	enum class EImplementation : uint8
+	{
+		Table,
+		SlicingBy8,
+		Pclmul,
+		Armv8
+	};
+
+	/**
+	 * State before any byte is hashed.
+	 */
+	static constexpr uint32 InitialState = 0xFFFFFFFF;
+
+	/**
+	 * Hashes a single byte, usable in constant expressions to precompute the state after a
+	 * constant prefix.
+	 */
+	static constexpr uint32 UpdateByte(uint32 State, const uint8 Byte)
+	{
+		State ^= Byte;
+		for (int32 Bit = 0; Bit < 8; ++Bit)
+		{
+			State = (State >> 1) ^ (0xEDB88320u & (0u - (State & 1u)));
+		}
+		return State;
+	}
+
+	/**
+	 * Turns a state into the checksum written to a report.
+	 */
+	static constexpr uint32 Finalize(const uint32 State)
+	{
+		return ~State;
+	}
+
+	/**
+	 * State after the header byte of Bluetooth output reports.
+	 */
+	static constexpr uint32 OutputSeedState = 0x1525D2B6;
+	/**
+	 * State after the header byte of Bluetooth input reports.
+	 */
+	static constexpr uint32 InputSeedState = 0x8C2C830C;
+
+	/**
+	 * Continues a CRC state over a buffer with the implementation selected for this CPU.
+	 *
+	 * @param State The state after the bytes already hashed.
+	 * @param Buffer The bytes to hash.
+	 * @param Len The number of bytes to hash.
+	 * @return The state after the buffer, to pass to `Finalize`.
+	 */
+	static uint32 Update(uint32 State, const unsigned char* Buffer, size_t Len);
+
+	/**
+	 * Byte-at-a-time implementation, used as the fallback of the others.
+	 */
+	static uint32 UpdateTable(uint32 State, const unsigned char* Buffer, size_t Len);
+	/**
+	 * Slicing-by-8 implementation, hashing eight bytes per step.
+	 */
+	static uint32 UpdateSlicingBy8(uint32 State, const unsigned char* Buffer, size_t Len);
+	/**
+	 * Hardware implementation, or the slicing-by-8 one when the CPU has no suitable instructions.
+	 */
+	static uint32 UpdateHardware(uint32 State, const unsigned char* Buffer, size_t Len);
+
+	/**
+	 * The implementation used by `Update`.
+	 */
+	static EImplementation GetImplementation();
+	static const TCHAR* GetImplementationName(EImplementation Implementation);
+};
+
+static_assert(FPlayStationCrc32::OutputSeedState == FPlayStationCrc32::UpdateByte(FPlayStationCrc32::InitialState, 0xA2),
+              "The output seed must be the state after the 0xA2 header byte.");
+static_assert(FPlayStationCrc32::InputSeedState == FPlayStationCrc32::UpdateByte(FPlayStationCrc32::InitialState, 0xA1),
+              "The input seed must be the state after the 0xA1 header byte.");
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/GamepadButtons.h"
+#include "Core/Enums/EDeviceConnection.h"
+#include "Core/Structs/FGamepadState.h"
+
+/**
+ * @brief Layout of a DualSense input report read over USB (report id 0x01).
+ *
+ * A layout only describes where each field lives; `FPlayStationInputDecoder::Decode` is
+ * instantiated once per layout, so every offset below is a compile-time constant in the
+ * generated decoder. Offsets are relative to the payload, which starts `Padding` bytes into
+ * the raw report, past the report id and any Bluetooth header.
+ *
+ * Variants that only move the payload, such as Bluetooth reports, derive from this layout
+ * and override `Padding`. The DualSense Edge shares the DualSense layout; its extra buttons
+ * live in bits the DualSense leaves at zero.
+ */
+struct FDualSenseUsbReportLayout
+{
+	static constexpr EDeviceType Family = DualSense;
+	static constexpr int32 Padding = 1;
+	static constexpr int32 LeftStickX = 0x00;
+	static constexpr int32 LeftStickY = 0x01;
+	static constexpr int32 RightStickX = 0x02;
+	static constexpr int32 RightStickY = 0x03;
+	static constexpr int32 LeftTrigger = 0x04;
+	static constexpr int32 RightTrigger = 0x05;
+	static constexpr int32 Buttons = 0x07;
+	static constexpr int32 ButtonBytes = 3;
+	static constexpr int32 Gyro = 0x0F;
+	static constexpr int32 Accel = 0x15;
+	static constexpr int32 Timestamp = 0x1B;
+	static constexpr int32 TimestampBytes = 4;
+	static constexpr int32 Touch1 = 0x20;
+	static constexpr int32 Touch2 = 0x24;
+	static constexpr int32 Status = 0x34;
+};
+
+/**
+ * @brief Layout of a DualSense input report read over Bluetooth (report id 0x31).
+ *
+ * The payload matches the USB report after a one byte sequence/tag header.
+ */
+struct FDualSenseBluetoothReportLayout : FDualSenseUsbReportLayout
+{
+	static constexpr int32 Padding = 2;
+};
+
+/**
+ * @brief Layout of a DualShock 4 input report read over USB (report id 0x01).
+ */
+struct FDualShockUsbReportLayout
+{
+	static constexpr EDeviceType Family = DualShock4;
+	static constexpr int32 Padding = 1;
+	static constexpr int32 LeftStickX = 0x00;
+	static constexpr int32 LeftStickY = 0x01;
+	static constexpr int32 RightStickX = 0x02;
+	static constexpr int32 RightStickY = 0x03;
+	static constexpr int32 LeftTrigger = 0x07;
+	static constexpr int32 RightTrigger = 0x08;
+	static constexpr int32 Buttons = 0x04;
+	static constexpr int32 ButtonBytes = 2;
+	static constexpr int32 Gyro = 0x0C;
+	static constexpr int32 Accel = 0x12;
+	static constexpr int32 Timestamp = 0x09;
+	static constexpr int32 TimestampBytes = 2;
+	static constexpr int32 Touch1 = 0x22;
+	static constexpr int32 Touch2 = 0x26;
+	static constexpr int32 Status = 0x1D;
+};
+
+/**
+ * @brief Layout of a DualShock 4 input report read over Bluetooth (report id 0x11).
+ *
+ * The payload matches the USB report after a two byte header.
+ */
+struct FDualShockBluetoothReportLayout : FDualShockUsbReportLayout
+{
+	static constexpr int32 Padding = 3;
+};
+
+/**
+ * @brief Decodes raw input reports into `FGamepadState`.
+ *
+ * One decoder is generated per report layout. A library picks the decoder matching its
+ * device and connection once, with `GetDecoder`, and then calls it through a plain function
+ * pointer for every report, so parsing a report never branches on the device or the
+ * connection type.
+ */
+class WINDOWSDUALSENSE_DS5W_API FPlayStationInputDecoder
+{
+public:
+	/**
+	 * Signature shared by every generated decoder.
+	 *
+	 * @param Report The raw report, starting with the report id.
+	 * @param OutState Receives every field of the report.
+	 */
+	using FDecodeFunction = void (*)(const unsigned char* Report, FGamepadState& OutState);
+
+	/**
+	 * Returns the decoder for a device and connection type.
+	 *
+	 * The DualSense Edge uses the DualSense decoders. Unrecognized connections are treated
+	 * as USB.
+	 */
+	static FDecodeFunction GetDecoder(EDeviceType DeviceType, EDeviceConnection ConnectionType);
+
+	/**
+	 * Decodes a report described by the given layout.
+	 *
+	 * @tparam TLayout One of the report layout structs.
+	 * @param Report The raw report, starting with the report id.
+	 * @param OutState Receives every field of the report.
+	 */
+	template <typename TLayout>
+	static void Decode(const unsigned char* Report, FGamepadState& OutState)
+	{
+		const unsigned char* Payload = Report + TLayout::Padding;
+
+		OutState.LeftAnalogX = ToAxis(Payload[TLayout::LeftStickX]);
+		OutState.LeftAnalogY = ToInvertedAxis(Payload[TLayout::LeftStickY]);
+		OutState.RightAnalogX = ToAxis(Payload[TLayout::RightStickX]);
+		OutState.RightAnalogY = ToInvertedAxis(Payload[TLayout::RightStickY]);
+		OutState.LeftTrigger = Payload[TLayout::LeftTrigger] / 256.0f;
+		OutState.RightTrigger = Payload[TLayout::RightTrigger] / 256.0f;
+
+		OutState.Buttons = FGamepadButtons::Decode<TLayout::ButtonBytes>(&Payload[TLayout::Buttons]);
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			OutState.Gyro[Axis] = ReadInt16(&Payload[TLayout::Gyro + Axis * 2]);
+			OutState.Accel[Axis] = ReadInt16(&Payload[TLayout::Accel + Axis * 2]);
+		}
+
+		OutState.DeviceTimestamp = Payload[TLayout::Timestamp] | (Payload[TLayout::Timestamp + 1] << 8);
+		if constexpr (TLayout::TimestampBytes == 4)
+		{
+			OutState.DeviceTimestamp |= (Payload[TLayout::Timestamp + 2] << 16) |
+				(static_cast<uint32>(Payload[TLayout::Timestamp + 3]) << 24);
+		}
+
+		ReadTouch(&Payload[TLayout::Touch1], OutState.Touch[0]);
+		ReadTouch(&Payload[TLayout::Touch2], OutState.Touch[1]);
+
+		const unsigned char Status = Payload[TLayout::Status];
+		if constexpr (TLayout::Family == DualShock4)
+		{
+			// Level in the low nibble, 0 to 10 on battery and up to 11 on cable; bit 4 is the
+			// cable and bit 5 the headphones.
+			const bool bCable = (Status & 0x10) != 0;
+			const uint8 Level = Status & 0x0F;
+			OutState.BatteryLevel = FMath::Min<uint8>(Level, 10);
+			OutState.bCharging = bCable && Level < 11;
+			OutState.bFullyCharged = bCable && Level >= 11;
+			OutState.bHeadsetConnected = (Status & 0x20) != 0;
+		}
+		else
+		{
+			// Level in the low nibble, charging state in the high nibble; headphones are
+			// flagged in the byte that follows.
+			OutState.BatteryLevel = FMath::Min<uint8>(Status & 0x0F, 10);
+			OutState.bCharging = (Status >> 4) == 0x1;
+			OutState.bFullyCharged = (Status >> 4) == 0x2;
+			OutState.bHeadsetConnected = (Payload[TLayout::Status + 1] & 0x01) != 0;
+		}
+	}
+
+private:
+	static float ToAxis(const unsigned char Value)
+	{
+		return static_cast<char>(static_cast<short>(Value - 128)) / 128.0f;
+	}
+
+	static float ToInvertedAxis(const unsigned char Value)
+	{
+		return static_cast<char>(static_cast<short>(Value - 127) * -1) / 128.0f;
+	}
+
+	static int16 ReadInt16(const unsigned char* Bytes)
+	{
+		return static_cast<int16>(Bytes[0] | (Bytes[1] << 8));
+	}
+
+	/**
+	 * Reads one touch point: the id with an inverted contact flag in bit 7, then two 12-bit
+	 * coordinates packed over three bytes.
+	 */
+	static void ReadTouch(const unsigned char* Bytes, FGamepadTouchState& OutTouch)
+	{
+		OutTouch.Id = Bytes[0] & 0x7F;
+		OutTouch.bDown = (Bytes[0] & 0x80) == 0;
+		OutTouch.X = static_cast<uint16>(Bytes[1] | ((Bytes[2] & 0x0F) << 8));
+		OutTouch.Y = static_cast<uint16>((Bytes[2] >> 4) | (Bytes[3] << 4));
+	}
+};
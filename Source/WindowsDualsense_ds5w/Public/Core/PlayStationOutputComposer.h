@@ -26,7 +26,7 @@ class WINDOWSDUALSENSE_DS5W_API FPlayStationOutputComposer
 	 * Acts as the initial value for the hash generation algorithm employed in the Compute method.
 	 * Ensures consistent and reliable hash results by providing a stable starting point.
 	 */
-	const static UINT32 CRCSeed;
+	const static uint32 CRCSeed;
 	/**
 	 * @variable HashTable
 	 *
@@ -43,7 +43,7 @@ class WINDOWSDUALSENSE_DS5W_API FPlayStationOutputComposer
 	 * The structure of the table ensures constant-time retrieval of hash values,
 	 * making it integral to performance-critical systems where such operations are frequent.
 	 */
-	const static UINT32 HashTable[256];
+	const static uint32 HashTable[256];
 public:
 	/**
 	 * @fn FPlayStationOutputComposer::FreeContext(FDeviceContext* Context)
@@ -57,31 +57,35 @@ public:
 	 */
 	static void FreeContext(FDeviceContext* Context);
 	/**
-	 * @brief Configures and sends output data to a DualSense device using the provided device context.
+	 * @brief Builds the DualSense output report of a device context without writing it.
 	 *
-	 * This method builds and formats an output data buffer with specific device settings,
-	 * trigger effects, audio configurations, and LED adjustments, applying specifics
-	 * based on the connection type (e.g., Bluetooth or USB). Additionally, it computes
-	 * and appends a CRC checksum when operating over Bluetooth for data integrity checking.
-	 * Finally, the prepared output data is submitted to the device for execution.
+	 * Fills `BufferOutput` from the output state of the context, including the Bluetooth
+	 * header and CRC. Used by the output writer thread, which performs the write itself.
 	 *
-	 * @param DeviceContext A pointer to the device's context that holds input/output
-	 *                      buffers, connection details, and configuration preferences.
+	 * @param DeviceContext The context whose output buffer is filled.
 	 */
-	static void OutputDualSense(FDeviceContext* DeviceContext);
+	static void ComposeDualSense(FDeviceContext* DeviceContext);
 	/**
-	 * Writes DualShock controller output values into the device buffer for communication.
-	 * This method prepares the output packet for a DualShock controller, handling
-	 * connection-specific adjustments (e.g., Bluetooth or wired) and configuring output
-	 * features like rumble effects and lightbar settings.
+	 * Builds the DualShock output report of a device context without writing it.
 	 *
-	 * @param DeviceContext The context containing details of the targeted device,
-	 *                      including connection type, output buffer, and settings
-	 *                      for the controller's output functionalities.
+	 * @param DeviceContext The context whose output buffer is filled.
 	 */
-	static void OutputDualShock(FDeviceContext* DeviceContext);
+	static void ComposeDualShock(FDeviceContext* DeviceContext);
+	/**
+	 * Compares the report composed in a device context with a report previously written to the
+	 * same device.
+	 *
+	 * The bits the DualSense composer toggles on every report and the Bluetooth CRC, which
+	 * depends on them, are ignored, so two reports built from the same output state compare equal.
+	 *
+	 * @param DeviceContext The context whose `BufferOutput` holds the newly composed report.
+	 * @param Previous The report last written, at least as long as the output report of the device.
+	 * @return True if writing the new report would not change anything on the device.
+	 */
+	static bool HasSamePayload(const FDeviceContext& DeviceContext, const unsigned char* Previous);
 	/**
 	 * Configures the trigger effect settings on a PlayStation controller using the provided haptic effect data.
+	 * When the effect carries an encoded blob, its bytes are copied as is instead.
 	 *
 	 * @param Trigger A pointer to the memory location where the trigger effect configuration is set.
 	 *                This array represents the hardware-specific register values for the controller trigger effects.
@@ -92,10 +96,11 @@ public:
 	/**
 	 * Computes the CRC32 hash for the given buffer using a predefined hash table and seed value.
 	 * The function iterates through each byte of the input buffer to calculate the resulting hash.
+	 * It is kept as the reference the faster variants of `FPlayStationCrc32` are checked against.
 	 *
 	 * @param Buffer A pointer to the input buffer containing the data for which the CRC32 hash is to be computed.
 	 * @param Len The length of the input buffer in bytes.
 	 * @return The computed CRC32 hash value.
 	 */
-	static UINT32 Compute(const unsigned char* Buffer, size_t Len);
+	static uint32 Compute(const unsigned char* Buffer, size_t Len);
 };
@@ -9,6 +9,8 @@
 #include "Core/Enums/EDeviceConnection.h"
 #include "FDeviceContext.generated.h"
 
+class IHidTransport;
+
 /**
  * @brief Represents the context and state of a connected device.
  *
@@ -40,12 +42,12 @@ struct FDeviceContext
 	 */
 	void* Handle;
 	/**
-	 * A wchar_t array that represents the path to the device or resource
+	 * A TCHAR array that represents the path to the device or resource
 	 * associated with the FDeviceContext structure. The path is limited
 	 * to 260 characters, which is commonly considered a maximum path length
 	 * in various systems.
 	 */
-	wchar_t Path[260];
+	TCHAR Path[260];
 	/**
 	 * @brief Internal data buffer for device communication.
 	 *
@@ -150,6 +152,14 @@ struct FDeviceContext
 	 * enabling seamless interaction and device-specific operations.
 	 */
 	FInputDeviceId UniqueInputDeviceId;
+	/**
+	 * @brief The transport the device was detected through, which owns `Handle`.
+	 *
+	 * Every operation on the handle goes through this transport, so replacing the active
+	 * transport with `FHIDDeviceInfo::SetTransport` never sends it to another backend.
+	 * Null until the device is detected or opened.
+	 */
+	TSharedPtr<IHidTransport, ESPMode::ThreadSafe> Transport;
 
 	FDeviceContext(): Handle(nullptr), Path{}, Buffer{}, BufferDS4{}, BufferOutput{}, IsConnected(false),
 	                  ConnectionType(), DeviceType(),
@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief One finger on the touchpad, as decoded from an input report.
+ */
+struct FGamepadTouchState
+{
+	/**
+	 * Horizontal position, 0 to 1919 on the DualSense and DualShock 4.
+	 */
+	uint16 X;
+	/**
+	 * Vertical position, 0 to 1079 on the DualSense and 0 to 941 on the DualShock 4.
+	 */
+	uint16 Y;
+	/**
+	 * Tracking id of the finger, incremented by the controller on every new contact.
+	 */
+	uint8 Id;
+	/**
+	 * Whether the finger is currently on the touchpad.
+	 */
+	bool bDown;
+};
+
+/**
+ * @brief Device independent snapshot of a controller's input, decoded from one report.
+ *
+ * A plain aggregate with no constructor or pointers, so it can be copied freely between
+ * threads and filled by the decoders in `FPlayStationInputDecoder` without any allocation.
+ * Analog values are already normalized; motion values are the raw sensor readings.
+ */
+struct FGamepadState
+{
+	/**
+	 * Stick positions in [-1, 1], with up as positive Y.
+	 */
+	float LeftAnalogX;
+	float LeftAnalogY;
+	float RightAnalogX;
+	float RightAnalogY;
+	/**
+	 * Trigger positions in [0, 1).
+	 */
+	float LeftTrigger;
+	float RightTrigger;
+	/**
+	 * Digital buttons, one bit per button as laid out by `FGamepadButtons`.
+	 */
+	uint32 Buttons;
+	/**
+	 * Raw angular velocity on the X, Y and Z axes.
+	 */
+	int16 Gyro[3];
+	/**
+	 * Raw acceleration on the X, Y and Z axes.
+	 */
+	int16 Accel[3];
+	/**
+	 * The two fingers tracked by the touchpad.
+	 */
+	FGamepadTouchState Touch[2];
+	/**
+	 * Raw sensor timestamp, see `FInputReport::DeviceTimestamp` for its unit.
+	 */
+	uint32 DeviceTimestamp;
+	/**
+	 * Battery level in tenths, 0 to 10.
+	 */
+	uint8 BatteryLevel;
+	/**
+	 * Whether the battery is being charged.
+	 */
+	bool bCharging;
+	/**
+	 * Whether the battery is fully charged while on cable.
+	 */
+	bool bFullyCharged;
+	/**
+	 * Whether headphones are plugged into the controller's audio jack.
+	 */
+	bool bHeadsetConnected;
+};
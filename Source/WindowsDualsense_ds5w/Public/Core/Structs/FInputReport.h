@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Structs/FMotionIntegral.h"
+
+/**
+ * @brief A single raw input report as received from a HID device.
+ *
+ * Reports are produced by the per-device reader thread and handed to the game thread
+ * through a lock-free channel. The payload is copied verbatim from the device, including
+ * the report id and any Bluetooth header bytes, so consumers apply the same padding rules
+ * they would when parsing `FDeviceContext::Buffer` or `FDeviceContext::BufferDS4`.
+ *
+ * The data array is sized for the largest report handled by the plugin (DualShock 4 over
+ * Bluetooth), so a single type can travel through the channel for every device.
+ *
+ * Each report is stamped by the reader thread as soon as the read completes, with both the
+ * host clock and the sensor timestamp the controller embeds in the report, and carries the
+ * orientation the reader fused from every motion sample up to and including this report.
+ */
+struct FInputReport
+{
+	/**
+	 * Maximum number of bytes a report may carry.
+	 */
+	static constexpr uint32 MaxLength = 547;
+	/**
+	 * Raw report bytes, starting with the report id.
+	 */
+	unsigned char Data[MaxLength];
+	/**
+	 * Number of valid bytes in Data.
+	 */
+	uint32 Length;
+	/**
+	 * Host time at which the read completed, in `FPlatformTime::Cycles64` units (QPC on Windows).
+	 */
+	uint64 HostCycles;
+	/**
+	 * Raw sensor timestamp reported by the device. 32-bit in 1/3 microsecond units on the
+	 * DualSense, 16-bit in 16/3 microsecond units on the DualShock 4.
+	 */
+	uint32 DeviceTimestamp;
+	/**
+	 * Position of the report in the stream read from the device, starting at one.
+	 */
+	uint64 Sequence;
+	/**
+	 * Orientation of the controller estimated by the reader thread, see `FMotionFusionFilter`.
+	 * Identity until the first report carrying motion data.
+	 */
+	FQuat Orientation;
+	/**
+	 * Sums of every motion sample read up to and including this report.
+	 */
+	FMotionIntegral Motion;
+
+	FInputReport(): Data{}, Length(0), HostCycles(0), DeviceTimestamp(0), Sequence(0), Orientation(FQuat::Identity)
+	{
+	}
+};
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/Function.h"
+#include "Core/Structs/FInputReport.h"
+
+/**
+ * @brief Fixed-capacity history of the most recent raw input reports of a device.
+ *
+ * Storage for every slot is allocated once on construction, so recording a report and
+ * querying the history never allocate. When full, each new report overwrites the oldest one.
+ *
+ * Reports keep the host timestamp taken by the reader thread when the read completed and the
+ * device's own sensor timestamp, which makes the history suitable for latency measurements,
+ * motion integration with the real sample interval and input-buffer style queries.
+ *
+ * The history is owned by the consumer side of the reader: it is filled from the game thread
+ * as reports are dequeued and must only be read from that thread.
+ */
+class FInputReportHistory
+{
+public:
+	/**
+	 * Number of reports kept. About half a second at the DualSense USB report rate.
+	 */
+	static constexpr int32 Capacity = 128;
+
+	/**
+	 * @param InDeviceTimestampPeriod Duration, in seconds, of one tick of the device timestamp.
+	 * @param InDeviceTimestampBits Width of the device timestamp counter, used to unwrap deltas.
+	 */
+	FInputReportHistory(const double InDeviceTimestampPeriod, const uint32 InDeviceTimestampBits):
+		DeviceTimestampPeriod(InDeviceTimestampPeriod),
+		DeviceTimestampMask(InDeviceTimestampBits >= 32 ? 0xFFFFFFFFu : (1u << InDeviceTimestampBits) - 1u),
+		Head(0),
+		Count(0)
+	{
+		Reports.SetNum(Capacity);
+	}
+
+	/**
+	 * Records a report, overwriting the oldest one once the history is full.
+	 */
+	void Push(const FInputReport& Report)
+	{
+		Reports[Head] = Report;
+		Head = (Head + 1) % Capacity;
+		Count = FMath::Min(Count + 1, Capacity);
+	}
+
+	/**
+	 * Number of reports currently held.
+	 */
+	int32 Num() const
+	{
+		return Count;
+	}
+
+	/**
+	 * Removes every report from the history.
+	 */
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+
+	/**
+	 * Returns a report by age.
+	 *
+	 * @param Index Zero for the most recent report, up to `Num() - 1` for the oldest.
+	 */
+	const FInputReport& GetFromNewest(const int32 Index) const
+	{
+		check(Index >= 0 && Index < Count);
+		return Reports[(Head - 1 - Index + Capacity) % Capacity];
+	}
+
+	/**
+	 * Visits, from oldest to newest, every report read at or after the given host time.
+	 *
+	 * @param SinceCycles Host timestamp, in `FPlatformTime::Cycles64` units.
+	 * @param Visitor Invoked for each matching report.
+	 * @return The number of reports visited.
+	 */
+	int32 ForEachSince(const uint64 SinceCycles, TFunctionRef<void(const FInputReport&)> Visitor) const
+	{
+		int32 First = Count;
+		while (First > 0 && GetFromNewest(First - 1).HostCycles < SinceCycles)
+		{
+			--First;
+		}
+
+		for (int32 Index = First - 1; Index >= 0; --Index)
+		{
+			Visitor(GetFromNewest(Index));
+		}
+		return First;
+	}
+
+	/**
+	 * Time elapsed on the host between two reports, in seconds.
+	 */
+	static double GetHostDeltaSeconds(const FInputReport& Older, const FInputReport& Newer)
+	{
+		return FPlatformTime::ToSeconds64(Newer.HostCycles - Older.HostCycles);
+	}
+
+	/**
+	 * Time elapsed on the device between two reports, in seconds, according to the sensor
+	 * timestamp carried by the reports. Handles a single wrap of the device counter.
+	 */
+	double GetDeviceDeltaSeconds(const FInputReport& Older, const FInputReport& Newer) const
+	{
+		const uint32 Ticks = (Newer.DeviceTimestamp - Older.DeviceTimestamp) & DeviceTimestampMask;
+		return Ticks * DeviceTimestampPeriod;
+	}
+
+	/**
+	 * Age of a report relative to now, in seconds, as seen by the host.
+	 */
+	static double GetAgeSeconds(const FInputReport& Report)
+	{
+		return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Report.HostCycles);
+	}
+
+private:
+	double DeviceTimestampPeriod;
+	uint32 DeviceTimestampMask;
+	TArray<FInputReport> Reports;
+	int32 Head;
+	int32 Count;
+};
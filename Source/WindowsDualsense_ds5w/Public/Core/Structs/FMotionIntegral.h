@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Motion accumulated over the consumer's interval, as the difference of two integrals.
+ */
+struct FMotionDelta
+{
+	/**
+	 * Rotation over the interval around the X, Y and Z sensor axes, in degrees, without the
+	 * gyroscope bias.
+	 */
+	FVector AngleDegrees = FVector::ZeroVector;
+	/**
+	 * Mean angular velocity over the interval, in raw counts, weighted by sample duration.
+	 */
+	FVector AverageGyro = FVector::ZeroVector;
+	/**
+	 * Mean acceleration of the samples of the interval, in raw counts.
+	 */
+	FVector AverageAccel = FVector::ZeroVector;
+	/**
+	 * Sensor time covered by the interval.
+	 */
+	double Seconds = 0.0;
+	/**
+	 * Number of motion samples in the interval. Zero when no report arrived, in which case
+	 * the averages are meaningless.
+	 */
+	uint32 Samples = 0;
+};
+
+/**
+ * @brief Running sums of every motion sample a reader has seen since it started.
+ *
+ * The reader thread adds each sample and stamps the current sums on the report it publishes.
+ * A consumer only needs the sums of the latest report it took and of the one before to know
+ * the exact motion in between, however many reports it skipped, without any lock and without
+ * walking the queue. Sums are kept in double precision, which stays exact to far below one
+ * count over any realistic session.
+ */
+struct FMotionIntegral
+{
+	/**
+	 * Integral of the raw angular velocity over sensor time, in counts times seconds.
+	 */
+	FVector GyroSeconds = FVector::ZeroVector;
+	/**
+	 * Integral of the angular velocity without the gyroscope bias, in degrees.
+	 */
+	FVector AngleDegrees = FVector::ZeroVector;
+	/**
+	 * Sum of the raw acceleration samples, in counts.
+	 */
+	FVector AccelSum = FVector::ZeroVector;
+	/**
+	 * Sensor time integrated so far.
+	 */
+	double Seconds = 0.0;
+	/**
+	 * Number of samples added so far.
+	 */
+	uint64 Samples = 0;
+
+	/**
+	 * Computes the motion between an older and a newer set of sums of the same reader.
+	 */
+	static FMotionDelta Delta(const FMotionIntegral& Older, const FMotionIntegral& Newer)
+	{
+		FMotionDelta Result;
+		Result.Samples = static_cast<uint32>(Newer.Samples - Older.Samples);
+		Result.Seconds = Newer.Seconds - Older.Seconds;
+		Result.AngleDegrees = Newer.AngleDegrees - Older.AngleDegrees;
+		if (Result.Seconds > 0.0)
+		{
+			Result.AverageGyro = (Newer.GyroSeconds - Older.GyroSeconds) / Result.Seconds;
+		}
+		if (Result.Samples > 0)
+		{
+			Result.AverageAccel = (Newer.AccelSum - Older.AccelSum) / Result.Samples;
+		}
+		return Result;
+	}
+};
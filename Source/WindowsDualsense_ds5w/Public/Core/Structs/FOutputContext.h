@@ -5,6 +5,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FTriggerEffectBlob.h"
 #include "FOutputContext.generated.h"
 
 /**
@@ -443,6 +444,12 @@ struct FHapticTriggers
 	 * response patterns.
 	 */
 	FStrengths Strengths;
+	/**
+	 * The effect encoded ahead of time, copied as is into the output report when set.
+	 * Must be cleared whenever one of the fields above is changed on its own, so the report
+	 * is encoded from the fields again.
+	 */
+	FTriggerEffectBlob Encoded;
 };
 
 /**
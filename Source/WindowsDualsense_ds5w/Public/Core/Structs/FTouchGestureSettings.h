@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FTouchGestureSettings.generated.h"
+
+/**
+ * @brief Thresholds of the touchpad gesture recognizer, see `FTouchGestureRecognizer`.
+ *
+ * Distances are fractions of the touchpad width, so the same settings behave alike on the
+ * DualSense and the DualShock 4. Durations are in seconds.
+ */
+USTRUCT(BlueprintType)
+struct FTouchGestureSettings
+{
+	GENERATED_BODY()
+
+	/**
+	 * Longest contact that still counts as a tap.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float TapMaxSeconds = 0.2f;
+	/**
+	 * Farthest a finger may travel during a tap.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float TapMaxDistance = 0.03f;
+	/**
+	 * Longest time between the end of a tap and the end of the next one for both to form a
+	 * double tap.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float DoubleTapMaxSeconds = 0.3f;
+	/**
+	 * Farthest apart the two taps of a double tap may be.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float DoubleTapMaxDistance = 0.08f;
+	/**
+	 * Shortest travel of a single finger, within `SwipeMaxSeconds` before it lifts, that counts
+	 * as a swipe.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float SwipeMinDistance = 0.2f;
+	/**
+	 * Length of the window, before the finger lifts, the swipe travel is measured over. Slow
+	 * drags that end still never cover `SwipeMinDistance` within it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float SwipeMaxSeconds = 0.3f;
+	/**
+	 * Change of the distance between two fingers that starts a pinch.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float PinchMinDistance = 0.04f;
+	/**
+	 * Travel of the midpoint of two fingers that starts a scroll.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Touch Gestures", meta = (ClampMin = "0.0"))
+	float ScrollMinDistance = 0.03f;
+};
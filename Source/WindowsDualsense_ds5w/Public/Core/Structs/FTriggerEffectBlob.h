@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "FTriggerEffectBlob.generated.h"
+
+struct FTriggerEffectData;
+
+/**
+ * @brief Handle to an adaptive trigger effect encoded ahead of time.
+ *
+ * The handle points to an immutable block holding the 11 bytes of the effect, exactly as
+ * they appear in a DualSense output report, and the parameters they were encoded from. Copies
+ * share the same block, so one baked effect can be kept in a Blueprint variable or a data
+ * asset and applied to any number of controllers; applying it only copies the bytes.
+ *
+ * Handles are created by `FTriggerEffectCache`, or from Blueprint through the `Bake` functions
+ * of `UDualSenseProxy`. A default-constructed handle is empty.
+ */
+USTRUCT(BlueprintType)
+struct WINDOWSDUALSENSE_DS5W_API FTriggerEffectBlob
+{
+	GENERATED_BODY()
+
+	/**
+	 * Size, in bytes, of the trigger block of an output report.
+	 */
+	static constexpr int32 Size = 11;
+
+	FTriggerEffectBlob() = default;
+
+	explicit FTriggerEffectBlob(TSharedPtr<const FTriggerEffectData, ESPMode::ThreadSafe> InData):
+		Data(MoveTemp(InData))
+	{
+	}
+
+	bool IsValid() const
+	{
+		return Data.IsValid();
+	}
+
+	/**
+	 * The encoded effect, or nullptr for an empty handle.
+	 */
+	const FTriggerEffectData* Get() const
+	{
+		return Data.Get();
+	}
+
+	bool operator==(const FTriggerEffectBlob& Other) const
+	{
+		return Data == Other.Data;
+	}
+
+	bool operator!=(const FTriggerEffectBlob& Other) const
+	{
+		return Data != Other.Data;
+	}
+
+private:
+	TSharedPtr<const FTriggerEffectData, ESPMode::ThreadSafe> Data;
+};
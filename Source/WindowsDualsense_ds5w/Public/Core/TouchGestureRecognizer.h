@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/ApplicationCore/Public/GenericPlatform/GenericApplicationMessageHandler.h"
+#include "Core/Structs/FGamepadState.h"
+#include "Core/Structs/FTouchGestureSettings.h"
+
+/**
+ * @brief Recognizes taps, swipes, pinches and two-finger scrolls on the touchpad.
+ *
+ * Each library owns one recognizer and feeds it the touch points of every report it dequeues,
+ * in arrival order and stamped with the host time of the read, so a quick tap or flick that
+ * starts and ends between two game ticks is still seen. The touch points are kept in a ring of
+ * recent samples, from which the travel of a swipe is measured over the last moments before
+ * the finger lifts.
+ *
+ * Recognized gestures are forwarded once per update by `Dispatch`:
+ * - A single finger that lifts quickly without moving is a tap, sent as a press and release of
+ *   `PS_TouchTap`. A second tap close by in time and place also sends `PS_TouchDoubleTap`.
+ * - A single finger that travels far enough just before it lifts is a swipe, sent as a press
+ *   and release of `PS_TouchSwipeLeft`, `Right`, `Up` or `Down` along its main direction.
+ * - Two fingers that move apart or together form a pinch, sent on the `PS_TouchPinch` axis as
+ *   the change of their distance during the update, positive when spreading.
+ * - Two fingers that move together form a scroll, sent on the `PS_TouchScrollX` and
+ *   `PS_TouchScrollY` axes as the travel of their midpoint during the update.
+ *
+ * Distances are fractions of the touchpad width. Axes go back to zero on the update after
+ * the motion stops.
+ *
+ * Only used from the game thread.
+ */
+class WINDOWSDUALSENSE_DS5W_API FTouchGestureRecognizer
+{
+public:
+	/**
+	 * Gestures sent as a press and release, as bits of the pending mask.
+	 */
+	enum EGesture : uint32
+	{
+		Tap = 0,
+		DoubleTap = 1,
+		SwipeLeft = 2,
+		SwipeRight = 3,
+		SwipeUp = 4,
+		SwipeDown = 5,
+		Count = 6
+	};
+
+	/**
+	 * Number of samples kept, about half a second at the highest report rate, which covers
+	 * the default swipe window.
+	 */
+	static constexpr int32 HistoryCapacity = 512;
+	/**
+	 * Width of the touchpad in raw units, on both controllers.
+	 */
+	static constexpr float PadWidth = 1920.0f;
+
+	FTouchGestureRecognizer();
+
+	/**
+	 * Replaces the thresholds. Gestures in progress continue with the new values.
+	 */
+	void Configure(const FTouchGestureSettings& InSettings)
+	{
+		Settings = InSettings;
+	}
+
+	const FTouchGestureSettings& GetSettings() const
+	{
+		return Settings;
+	}
+
+	/**
+	 * Adds the touch points of one report.
+	 *
+	 * Samples that are not newer than the last one added are ignored, so the latest snapshot
+	 * can be added after the queued reports without counting a report twice.
+	 *
+	 * @param Touch Both touch points of the report.
+	 * @param Seconds Host time of the report, in seconds.
+	 */
+	void AddSample(const FGamepadTouchState (&Touch)[2], double Seconds);
+
+	/**
+	 * Forwards the gestures recognized since the previous call.
+	 *
+	 * @param MessageHandler The handler receiving the events.
+	 * @param UserId The platform user owning the device.
+	 * @param InputDeviceId The device the events originate from.
+	 */
+	void Dispatch(FGenericApplicationMessageHandler& MessageHandler, FPlatformUserId UserId,
+	              FInputDeviceId InputDeviceId);
+
+	/**
+	 * Drops the samples, the contacts and the gestures in progress.
+	 */
+	void Reset();
+
+private:
+	/**
+	 * Touch points of one report, in fractions of the touchpad width.
+	 */
+	struct FTouchSample
+	{
+		double Seconds;
+		FVector2f Position[2];
+		uint8 Id[2];
+		bool bDown[2];
+	};
+
+	/**
+	 * A finger currently or last on the touchpad.
+	 */
+	struct FContact
+	{
+		bool bDown;
+		uint8 Id;
+		FVector2f Start;
+		FVector2f Last;
+		double StartSeconds;
+	};
+
+	/**
+	 * What two fingers on the touchpad are doing.
+	 */
+	enum class ETwoFingerMode : uint8
+	{
+		None,
+		Undecided,
+		Pinch,
+		Scroll
+	};
+
+	/**
+	 * Classifies the single-finger gesture of a contact that just lifted.
+	 */
+	void EndSingleFinger(const FContact& Contact, double Seconds);
+	/**
+	 * Follows two fingers on the touchpad, accumulating the axes of a pinch or a scroll.
+	 */
+	void UpdateTwoFingers();
+
+	FTouchGestureSettings Settings;
+
+	FTouchSample History[HistoryCapacity];
+	int32 Head;
+	int32 NumSamples;
+	double LastSampleSeconds;
+
+	FContact Contacts[2];
+	/**
+	 * Most fingers down at once since the touchpad was last empty, and whether any of them
+	 * moved beyond the tap distance.
+	 */
+	int32 SessionFingers;
+	bool bSessionMoved;
+
+	/**
+	 * End time and place of the last tap, which a double tap pairs with.
+	 */
+	bool bHasLastTap;
+	double LastTapSeconds;
+	FVector2f LastTapPosition;
+
+	ETwoFingerMode TwoFingerMode;
+	float StartSpread;
+	float LastSpread;
+	FVector2f StartMidpoint;
+	FVector2f LastMidpoint;
+
+	/**
+	 * Gestures and axis motion recognized since the last dispatch.
+	 */
+	uint32 PendingGestures;
+	float PendingPinch;
+	FVector2f PendingScroll;
+	/**
+	 * Whether the axes were last dispatched with a non-zero value, and have to go back to zero.
+	 */
+	bool bPinchDispatched;
+	bool bScrollDispatched;
+};
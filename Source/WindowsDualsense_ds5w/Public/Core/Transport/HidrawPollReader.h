@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Interfaces/HidTransport.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+#if PLATFORM_LINUX
+
+/**
+ * @brief A single thread that reads the input reports of every open hidraw descriptor.
+ *
+ * Each registered descriptor must be non-blocking. The thread waits in one `poll()` on all
+ * of them together with an `eventfd`, signalled whenever a descriptor is added or removed or
+ * a stop is requested. When a descriptor becomes readable, every report it has buffered is
+ * read into the buffer of its sink and delivered in arrival order, until the read would block.
+ * A descriptor that hangs up or fails with an error treated as a disconnection is dropped and
+ * its sink notified. After any other error the descriptor is left out of the poll set for
+ * `IHidTransport::TransientErrorBackoffSeconds`, the pause the per-device readers take, and it
+ * is dropped once `IHidTransport::MaxTransientErrors` reads in a row have failed.
+ *
+ * Reports are delivered with the lock held, so once `Remove` returns no call to the sink is
+ * in flight and the descriptor may be closed.
+ */
+class WINDOWSDUALSENSE_DS5W_API FHidrawPollReader final : public FRunnable
+{
+public:
+	FHidrawPollReader();
+	/**
+	 * Stops the thread, waits for it to finish and releases the wake event.
+	 */
+	virtual ~FHidrawPollReader() override;
+
+	/**
+	 * Creates the underlying thread.
+	 *
+	 * @return False if the wake event or the thread could not be created.
+	 */
+	bool StartThread();
+
+	/**
+	 * Waits for reports on every descriptor and delivers them to their sinks.
+	 *
+	 * @return `0` once a stop is requested, `1` if polling failed.
+	 */
+	virtual uint32 Run() override;
+	/**
+	 * Requests the thread to stop and wakes it up.
+	 */
+	virtual void Stop() override;
+
+	/**
+	 * Starts reading a descriptor.
+	 *
+	 * @param Fd A non-blocking descriptor, which must stay open until `Remove` returns for it
+	 *        or its sink is notified of the disconnection.
+	 * @param Sink Receives the reports of the descriptor.
+	 */
+	void Add(int Fd, IHidReportSink& Sink);
+	/**
+	 * Stops reading a descriptor. Blocks while its reports are being delivered.
+	 */
+	void Remove(int Fd);
+	/**
+	 * Returns the number of descriptors currently read.
+	 */
+	int32 GetNumStreams() const;
+
+private:
+	/**
+	 * A descriptor registered with the reader.
+	 */
+	struct FStream
+	{
+		int Fd = -1;
+		IHidReportSink* Sink = nullptr;
+		/**
+		 * Number of reads in a row that failed with an error not treated as a disconnection.
+		 */
+		uint32 TransientErrors = 0;
+		/**
+		 * Time, in seconds, before which the descriptor is not polled again after such a failure.
+		 * `poll()` keeps reporting a failing descriptor, so polling it would spin the thread.
+		 */
+		double RetrySeconds = 0.0;
+	};
+
+	/**
+	 * Reads every report buffered by a descriptor.
+	 *
+	 * @return False if the device is lost.
+	 */
+	static bool Drain(FStream& Stream);
+	/**
+	 * Wakes the thread up, so it polls the current set of descriptors.
+	 */
+	void Wake() const;
+
+	/**
+	 * Guards `Streams` and `Generation`, and is held while reports are delivered.
+	 */
+	mutable FCriticalSection Lock;
+	TArray<FStream> Streams;
+	/**
+	 * Incremented whenever `Streams` changes, so the thread never delivers the result of a
+	 * poll to a descriptor that was removed meanwhile.
+	 */
+	uint64 Generation;
+
+	FRunnableThread* Thread;
+	int WakeFd;
+	std::atomic_bool bStopRequested;
+};
+
+#endif
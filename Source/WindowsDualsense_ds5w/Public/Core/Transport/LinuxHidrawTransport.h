@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Interfaces/HidTransport.h"
+#include "Core/Enums/EDeviceConnection.h"
+#include "Core/Transport/HidrawPollReader.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+
+#if PLATFORM_LINUX
+
+/**
+ * @brief HID transport backed by the Linux hidraw interface.
+ *
+ * Controllers are enumerated from `/sys/class/hidraw`, matching the vendor and product
+ * identifiers reported in each node's `uevent`, and opened through their `/dev/hidrawN`
+ * node. Any device exposed through hidraw is supported, including virtual devices created
+ * with `/dev/uhid`, which allows the transport to be exercised without real hardware.
+ *
+ * Every descriptor is opened non-blocking. Read streams are attached to a single
+ * `FHidrawPollReader` shared by every controller, which waits on all of them in one
+ * `poll()`, so one thread services any number of controllers. A stream read directly with
+ * `ReadReport` waits in `poll()` on the device together with an `eventfd` used to cancel the wait.
+ *
+ * Device arrivals and removals are detected by watching `/dev` with inotify for hidraw
+ * nodes being created or deleted, on a small dedicated thread.
+ *
+ * Every hidraw node seen by `Detect` is remembered together with the HID device it was bound
+ * to and the outcome of probing it, so later passes only probe nodes that are new or were
+ * reassigned to another device.
+ */
+class WINDOWSDUALSENSE_DS5W_API FLinuxHidrawTransport final : public IHidTransport
+{
+public:
+	virtual ~FLinuxHidrawTransport() override;
+
+	virtual void Detect(TArray<FDeviceContext>& Devices) override;
+	virtual void* Open(const FDeviceContext& Context) override;
+	virtual void Close(void* Handle) override;
+	virtual bool Write(void* Handle, const unsigned char* Buffer, size_t Length) override;
+	virtual EPollResult Ping(void* Handle) override;
+
+	virtual void* OpenReader(const FDeviceContext& Context) override;
+	virtual EPollResult ReadReport(void* Reader, unsigned char* Buffer, size_t Length, size_t& OutBytesRead) override;
+	virtual void CancelRead(void* Reader) override;
+	virtual void CloseReader(void* Reader) override;
+	virtual bool AttachReader(void* Reader, IHidReportSink& Sink) override;
+	virtual void DetachReader(void* Reader) override;
+
+	virtual bool StartDeviceNotifications(TFunction<void()> OnDevicesChanged) override;
+	virtual void StopDeviceNotifications() override;
+
+	/**
+	 * @brief Determines whether the given errno value should be treated as a device disconnection.
+	 *
+	 * @param Error The errno value to evaluate.
+	 * @return true if the error indicates the device is gone, false otherwise.
+	 */
+	static bool ShouldTreatAsDisconnected(int32 Error);
+
+private:
+	/**
+	 * Outcome of probing a hidraw node, cached for as long as the node stays bound to the same device.
+	 */
+	struct FEnumerationCacheEntry
+	{
+		/**
+		 * Name of the HID device the node belonged to when probed, e.g. `0005:054C:0CE6.0007`.
+		 * The kernel reuses hidraw minors, but never this instance suffix.
+		 */
+		FString HidDevice;
+		bool bRejected = true;
+		uint16 VendorId = 0;
+		uint16 ProductId = 0;
+		EDeviceType DeviceType = DualSense;
+		EDeviceConnection ConnectionType = Usb;
+	};
+
+	/**
+	 * Identifies the controller behind a hidraw node.
+	 *
+	 * @param NodeName The node name, e.g. `hidraw3`.
+	 * @param OutEntry Receives the identification, or a rejected entry for unsupported devices.
+	 * @return True if the result is final and can be cached, false if the node could not be
+	 *         queried and must be probed again on the next pass.
+	 */
+	static bool ProbeDevice(const char* NodeName, FEnumerationCacheEntry& OutEntry);
+
+	/**
+	 * Probe results keyed by node name. Entries are dropped once their node disappears.
+	 */
+	TMap<FString, FEnumerationCacheEntry> EnumerationCache;
+	/**
+	 * Guards `EnumerationCache`, as detection runs on background tasks.
+	 */
+	FCriticalSection EnumerationCacheLock;
+	/**
+	 * Thread watching `/dev` for hidraw nodes, or null when notifications are not running.
+	 */
+	TUniquePtr<FRunnable> HotplugWatcher;
+	/**
+	 * Thread reading every attached stream, started by the first `AttachReader`.
+	 */
+	TUniquePtr<FHidrawPollReader> PollReader;
+	/**
+	 * Guards the creation of `PollReader`, as readers are attached from several libraries.
+	 */
+	FCriticalSection PollReaderLock;
+};
+
+#endif
@@ -0,0 +1,137 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Interfaces/HidTransport.h"
+#include "Core/Enums/EDeviceConnection.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * @brief Callback used to fill a synthesized input report.
+ *
+ * Receives the path of the virtual device, the sequence number of the report, the report
+ * buffer (already initialized with a valid neutral report, including the report id) and
+ * its length. The CRC trailer of Bluetooth reports is written after the generator runs.
+ */
+using FLoopbackReportGenerator = TFunction<void(const FString& Path, uint64 Sequence, unsigned char* Report, size_t Length)>;
+
+/**
+ * @brief In-memory HID transport that emulates controllers without any hardware.
+ *
+ * Virtual DualSense and DualShock 4 devices are registered with `AddDevice`. They are
+ * returned by `Detect` like physical controllers, produce input reports at a configurable
+ * rate on every read stream, and capture every output report written to them. Devices can
+ * be unplugged at runtime to exercise the disconnection paths. Adding, plugging or unplugging
+ * a device raises a device notification, exactly like a hot-plug on a physical transport.
+ *
+ * Install it with `FHIDDeviceInfo::SetTransport` before the first detection to drive the
+ * whole input/output pipeline on machines with no controller attached, such as build
+ * agents running benchmarks or regression tests.
+ */
+class WINDOWSDUALSENSE_DS5W_API FLoopbackHidTransport final : public IHidTransport
+{
+public:
+	/**
+	 * @brief Registers a virtual controller.
+	 *
+	 * @param DeviceType The kind of controller to emulate.
+	 * @param ConnectionType The connection to emulate, which selects the report layout.
+	 * @param ReportRateHz Number of input reports produced per second. Zero produces
+	 *        reports as fast as they are read, which is useful for throughput benchmarks.
+	 * @return The path identifying the virtual device.
+	 */
+	FString AddDevice(EDeviceType DeviceType, EDeviceConnection ConnectionType, float ReportRateHz = 250.0f);
+	/**
+	 * @brief Plugs or unplugs a virtual controller.
+	 *
+	 * An unplugged device disappears from `Detect`, and every pending or future read, write
+	 * and ping on it reports a disconnection.
+	 */
+	void SetDeviceConnected(const FString& Path, bool bConnected);
+	/**
+	 * @brief Replaces the function used to fill input reports. Pass an empty function to
+	 *        restore the built-in generator, which sweeps the sticks and cycles the face buttons.
+	 */
+	void SetReportGenerator(FLoopbackReportGenerator InGenerator);
+	/**
+	 * @brief Moves every output report captured for a device into the given array.
+	 *
+	 * @return The number of reports moved.
+	 */
+	int32 ConsumeWrittenReports(const FString& Path, TArray<TArray<uint8>>& OutReports);
+	/**
+	 * @brief Total number of output reports written to a device since it was added.
+	 */
+	uint64 GetWriteCount(const FString& Path) const;
+	/**
+	 * @brief Total number of input reports produced for a device since it was added.
+	 */
+	uint64 GetReportCount(const FString& Path) const;
+
+	virtual void Detect(TArray<FDeviceContext>& Devices) override;
+	virtual void* Open(const FDeviceContext& Context) override;
+	virtual void Close(void* Handle) override;
+	virtual bool Write(void* Handle, const unsigned char* Buffer, size_t Length) override;
+	virtual EPollResult Ping(void* Handle) override;
+
+	virtual void* OpenReader(const FDeviceContext& Context) override;
+	virtual EPollResult ReadReport(void* Reader, unsigned char* Buffer, size_t Length, size_t& OutBytesRead) override;
+	virtual void CancelRead(void* Reader) override;
+	virtual void CloseReader(void* Reader) override;
+
+	virtual bool StartDeviceNotifications(TFunction<void()> OnDevicesChanged) override;
+	virtual void StopDeviceNotifications() override;
+
+private:
+	/**
+	 * Maximum number of output reports kept per device before the oldest are discarded.
+	 */
+	static constexpr int32 MaxCapturedReports = 4096;
+
+	/**
+	 * State of a single virtual controller, shared with every handle opened on it.
+	 */
+	struct FVirtualDevice
+	{
+		FString Path;
+		EDeviceType DeviceType = DualSense;
+		EDeviceConnection ConnectionType = Usb;
+		double ReportInterval = 0.0;
+		std::atomic_bool bConnected{true};
+		std::atomic<uint64> ReportCount{0};
+		std::atomic<uint64> WriteCount{0};
+		FCriticalSection CaptureLock;
+		TArray<TArray<uint8>> CapturedReports;
+	};
+
+	/**
+	 * Handle returned by `Open`.
+	 */
+	struct FDeviceHandle;
+	/**
+	 * Read stream returned by `OpenReader`.
+	 */
+	struct FReadStream;
+
+	/**
+	 * Finds a registered device by path, or returns null.
+	 */
+	TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe> FindDevice(const FString& Path) const;
+	/**
+	 * Fills one input report for the device and advances its sequence.
+	 */
+	size_t Synthesize(FVirtualDevice& Device, unsigned char* Buffer, size_t Length);
+	/**
+	 * Invokes the device notification callback, if any.
+	 */
+	void NotifyDevicesChanged() const;
+
+	mutable FCriticalSection DevicesLock;
+	TArray<TSharedPtr<FVirtualDevice, ESPMode::ThreadSafe>> Devices;
+	FLoopbackReportGenerator Generator;
+	TFunction<void()> DevicesChangedCallback;
+};
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Interfaces/HidTransport.h"
+#include "Core/Enums/EDeviceConnection.h"
+#include "HAL/CriticalSection.h"
+
+#if PLATFORM_WINDOWS
+
+/**
+ * @brief HID transport backed by the Win32 SetupAPI, HidD_* and file I/O functions.
+ *
+ * Handles returned by `Open` are raw Win32 `HANDLE`s. Read streams use a separate
+ * handle opened for overlapped I/O together with a cancel event, so a blocking read
+ * can be woken up from another thread.
+ *
+ * Device arrivals and removals are reported through `CM_Register_Notification` on the HID
+ * device interface class, so enumeration only runs when something actually changed.
+ *
+ * Every interface path seen by `Detect` is remembered together with the outcome of probing
+ * it, so later passes only open and query devices whose path was not seen before.
+ */
+class WINDOWSDUALSENSE_DS5W_API FWindowsHidTransport final : public IHidTransport
+{
+public:
+	virtual ~FWindowsHidTransport() override;
+
+	virtual void Detect(TArray<FDeviceContext>& Devices) override;
+	virtual void* Open(const FDeviceContext& Context) override;
+	virtual void Close(void* Handle) override;
+	virtual bool Write(void* Handle, const unsigned char* Buffer, size_t Length) override;
+	virtual EPollResult Ping(void* Handle) override;
+
+	virtual void* OpenReader(const FDeviceContext& Context) override;
+	virtual EPollResult ReadReport(void* Reader, unsigned char* Buffer, size_t Length, size_t& OutBytesRead) override;
+	virtual void CancelRead(void* Reader) override;
+	virtual void CloseReader(void* Reader) override;
+
+	virtual bool StartDeviceNotifications(TFunction<void()> OnDevicesChanged) override;
+	virtual void StopDeviceNotifications() override;
+
+	/**
+	 * @brief Determines whether the given Win32 error code should be treated as a device disconnection.
+	 *
+	 * @param Error The error code to evaluate.
+	 * @return true if the error code indicates a device disconnection, false otherwise.
+	 */
+	static bool ShouldTreatAsDisconnected(uint32 Error);
+
+private:
+	/**
+	 * Number of input reports the HID class driver buffers on read streams.
+	 */
+	static constexpr unsigned long InputBufferCount = 128;
+
+	/**
+	 * Outcome of probing a HID interface path, cached for as long as the path stays present.
+	 */
+	struct FEnumerationCacheEntry
+	{
+		bool bRejected = true;
+		uint16 VendorId = 0;
+		uint16 ProductId = 0;
+		EDeviceType DeviceType = DualSense;
+		EDeviceConnection ConnectionType = Usb;
+	};
+
+	/**
+	 * Opens a HID interface path and identifies the controller behind it.
+	 *
+	 * @param DevicePath The interface path returned by SetupAPI.
+	 * @param OutEntry Receives the identification, or a rejected entry for unsupported devices.
+	 * @return True if the result is final and can be cached, false if the device could not be
+	 *         queried and must be probed again on the next pass.
+	 */
+	static bool ProbeDevice(const TCHAR* DevicePath, FEnumerationCacheEntry& OutEntry);
+
+	/**
+	 * Probe results keyed by interface path. Entries are dropped once their path disappears.
+	 */
+	TMap<FString, FEnumerationCacheEntry> EnumerationCache;
+	/**
+	 * Guards `EnumerationCache`, as detection runs on background tasks.
+	 */
+	FCriticalSection EnumerationCacheLock;
+	/**
+	 * Registration handle returned by `CM_Register_Notification`, or null when not registered.
+	 */
+	void* NotificationHandle = nullptr;
+	/**
+	 * Callback invoked from the configuration manager thread pool on every arrival or removal.
+	 */
+	TFunction<void()> DevicesChangedCallback;
+};
+
+#endif
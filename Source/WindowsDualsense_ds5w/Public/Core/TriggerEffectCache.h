@@ -0,0 +1,77 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/Structs/FOutputContext.h"
+#include "Core/Structs/FTriggerEffectBlob.h"
+
+/**
+ * @brief Immutable block referenced by an `FTriggerEffectBlob`.
+ */
+struct FTriggerEffectData
+{
+	/**
+	 * The parameters the effect was encoded from, with an empty `Encoded` handle.
+	 */
+	FHapticTriggers Parameters;
+	/**
+	 * The trigger block of the output report, starting with the effect mode.
+	 */
+	unsigned char Bytes[FTriggerEffectBlob::Size];
+};
+
+/**
+ * @brief Encodes adaptive trigger effects once and shares the result.
+ *
+ * Each effect function derives the zone and strength tables of an effect from its arguments,
+ * encodes the 11-byte trigger block and returns a handle to it. Results are kept in a
+ * process-wide cache keyed by the effect and its arguments, so the same effect requested
+ * again, by any controller, returns the same handle without encoding anything.
+ *
+ * Safe to call from any thread, which allows effects to be baked while assets load.
+ */
+class WINDOWSDUALSENSE_DS5W_API FTriggerEffectCache
+{
+public:
+	/**
+	 * Encodes an effect from raw parameters, without going through the cache.
+	 */
+	static FTriggerEffectBlob Encode(const FHapticTriggers& Effect);
+	/**
+	 * Sets an encoded effect on the trigger state of an output context. Only the mode and the
+	 * fields that mode uses are copied, so a field set on its own, such as the frequency of
+	 * `SetHapticFeedback`, survives effects that do not use it.
+	 */
+	static void Apply(const FTriggerEffectBlob& Effect, FHapticTriggers& Trigger);
+
+	static FTriggerEffectBlob Off();
+	static FTriggerEffectBlob ContinuousResistance(int32 StartPosition, int32 Strength);
+	static FTriggerEffectBlob Resistance(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength);
+	static FTriggerEffectBlob AutomaticGun(int32 BeginStrength, int32 MiddleStrength, int32 EndStrength, bool bKeepEffect);
+	static FTriggerEffectBlob Weapon(int32 StartPosition, int32 EndPosition, int32 Strength);
+	static FTriggerEffectBlob Galloping(int32 StartPosition, int32 EndPosition, int32 FirstFoot, int32 SecondFoot,
+	                                    float Frequency);
+	static FTriggerEffectBlob Machine(int32 StartPosition, int32 EndPosition, int32 AmplitudeBegin, int32 AmplitudeEnd,
+	                                  float Frequency, float Period);
+	static FTriggerEffectBlob Bow(int32 StartPosition, int32 EndPosition, int32 BeginStrength, int32 EndStrength);
+
+	/**
+	 * Number of distinct effects currently cached.
+	 */
+	static int32 Num();
+	/**
+	 * Forgets every cached effect. Handles already returned stay valid.
+	 */
+	static void Empty();
+
+private:
+	/**
+	 * Returns the cached effect for a key, or encodes it with the given builder and caches it.
+	 * Keys pack the mode of the effect and up to seven byte-sized arguments; arguments outside
+	 * of a byte are encoded without being cached.
+	 */
+	static FTriggerEffectBlob FindOrEncode(uint64 Key, bool bCacheable, TFunctionRef<FHapticTriggers()> Build);
+};
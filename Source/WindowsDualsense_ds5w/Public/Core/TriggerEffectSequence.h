@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Rafael Valoto/Publisher. All rights reserved.
+// Created for: WindowsDualsense_ds5w - Plugin to support DualSense controller on Windows.
+// Planned Release Year: 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Templates/SharedPointer.h"
+#include "TriggerEffectSequence.generated.h"
+
+struct FHapticTriggers;
+
+/**
+ * @brief Adaptive trigger effect animated by a sequence.
+ */
+UENUM(BlueprintType)
+enum class ETriggerSequenceEffect : uint8
+{
+	/**
+	 * Resistance per zone of the trigger travel.
+	 */
+	Resistance UMETA(DisplayName = "Resistance"),
+	/**
+	 * Vibration per zone of the trigger travel, at the keyframe frequency.
+	 */
+	Vibration UMETA(DisplayName = "Vibration")
+};
+
+/**
+ * @brief State of an adaptive trigger at a point of a sequence.
+ */
+USTRUCT(BlueprintType)
+struct FTriggerEffectKeyframe
+{
+	GENERATED_BODY()
+
+	/**
+	 * Time of the keyframe, in seconds from the start of the sequence.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Effect", meta = (ClampMin = "0"))
+	float Time = 0.0f;
+	/**
+	 * Strength of each of the ten zones along the trigger travel, from 0 (off) to 8.
+	 * Missing zones are off.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Effect", meta = (ClampMin = "0", ClampMax = "8"))
+	TArray<float> ZoneStrengths;
+	/**
+	 * Vibration frequency, from 0 to 1. Only used by vibration sequences.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trigger Effect", meta = (ClampMin = "0", ClampMax = "1"))
+	float Frequency = 0.0f;
+};
+
+/**
+ * @brief Immutable snapshot of a trigger effect sequence, evaluated by the output writer thread.
+ */
+struct WINDOWSDUALSENSE_DS5W_API FTriggerSequenceData
+{
+	static constexpr int32 NumZones = 10;
+
+	struct FKey
+	{
+		double Time;
+		float Strengths[NumZones];
+		float Frequency;
+	};
+
+	/**
+	 * Keys sorted by time.
+	 */
+	TArray<FKey> Keys;
+	unsigned char Mode = 0x21;
+	bool bLoop = false;
+
+	/**
+	 * Time of the last key.
+	 */
+	double GetDuration() const
+	{
+		return Keys.Num() > 0 ? Keys.Last().Time : 0.0;
+	}
+
+	/**
+	 * Interpolates the keys around the given time and encodes the result as a trigger effect.
+	 *
+	 * @param Seconds Time elapsed since the sequence started.
+	 * @param OutEffect Receives the effect. Its encoded handle is cleared.
+	 * @return False once a sequence that does not loop is over, or if it has no key.
+	 */
+	bool Evaluate(double Seconds, FHapticTriggers& OutEffect) const;
+};
+
+/**
+ * @brief Keyframed adaptive trigger effect played by the plugin on its own timer.
+ *
+ * Playing a sequence hands an immutable snapshot of it to the output writer thread of the
+ * controller, which interpolates the zone strengths and frequency between keyframes at the
+ * output report rate and writes only the reports that actually change, independently of the
+ * game frame rate. The game thread is not involved until the sequence is stopped or replaced.
+ */
+UCLASS(BlueprintType)
+class WINDOWSDUALSENSE_DS5W_API UTriggerEffectSequence : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trigger Effect")
+	ETriggerSequenceEffect Effect = ETriggerSequenceEffect::Resistance;
+	/**
+	 * Restarts the sequence from its first keyframe once the last one is reached. Otherwise
+	 * the trigger returns to the effect set by the game. The first keyframe is always sent
+	 * when the sequence starts, even if it is also the last one.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trigger Effect")
+	bool bLoop = false;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Trigger Effect")
+	TArray<FTriggerEffectKeyframe> Keyframes;
+
+	/**
+	 * Creates the snapshot played by the writer thread from the current keyframes.
+	 */
+	TSharedRef<const FTriggerSequenceData, ESPMode::ThreadSafe> CreateSnapshot() const;
+};
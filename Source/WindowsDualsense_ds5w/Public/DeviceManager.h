@@ -8,6 +8,9 @@
 #include "IHapticDevice.h"
 #include "IInputDevice.h"
 #include "InputCoreTypes.h"
+#include "Core/MotionBatch.h"
+
+class ISonyGamepadInterface;
 
 
 
@@ -78,12 +81,24 @@ public:
 	 * Executes a command in the context of the provided world.
 	 * This function is typically used for handling console commands.
 	 *
+	 * Supported commands:
+	 * - `DUALSENSE STATS` prints the latency histograms and counters of every controller.
+	 * - `DUALSENSE STATS ON|OFF` enables or disables latency instrumentation.
+	 * - `DUALSENSE STATS RESET` clears the recorded histograms and counters.
+	 * - `DUALSENSE ANALOG` prints the analog dispatch mode and the dispatched and suppressed
+	 *   event counts of every controller.
+	 * - `DUALSENSE ANALOG DELTA|ALWAYS [EPSILON=<value>] [KEEPALIVE=<seconds>]` switches every
+	 *   controller to delta-only or per-update analog dispatch.
+	 * - `DUALSENSE ANALOG RESET` clears the analog event counters.
+	 * - `DUALSENSE CRC [ON|OFF]` enables or disables the CRC check of Bluetooth input reports
+	 *   and prints how many reports each controller discarded.
+	 *
 	 * @param InWorld The world context in which the command is executed.
 	 * @param Cmd The command string to be executed.
 	 * @param Ar The output device to log execution results or messages.
-	 * @return True if the command was successfully executed, otherwise false.
+	 * @return True if the command was handled by this device, otherwise false.
 	 */
-	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override { return true; }
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override;
 	/**
 	 * Sets the haptic feedback values for a specific controller and hand.
 	 * This function updates the haptic feedback values for the specified controller using the supplied values structure.
@@ -165,6 +180,13 @@ public:
 
 private:
 	FInputDeviceId GetGamepadInterface(int32 ControllerId);
+	/**
+	 * Handles the arguments of the `DUALSENSE ANALOG` console command.
+	 *
+	 * @param Cmd The remaining command string, past `ANALOG`.
+	 * @param Ar The output device to log results to.
+	 */
+	static void ExecAnalog(const TCHAR* Cmd, FOutputDevice& Ar);
 	/**
 	 * Determines whether resources or data are loaded on demand rather than
 	 * during the initial application startup or initialization phase.
@@ -190,6 +212,23 @@ private:
 	 * This data structure is used to track and update connection status dynamically.
 	 */
 	TMap<int32, bool> IsConnectionChange = TMap<int32, bool>();
+	/**
+	 * A gamepad whose motion was added to the batch of the tick, waiting for its dispatch.
+	 */
+	struct FPendingMotion
+	{
+		ISonyGamepadInterface* Gamepad;
+		int32 Slot;
+		FPlatformUserId UserId;
+		FInputDeviceId Device;
+		FString ContextDrive;
+	};
+	/**
+	 * Motion of every gamepad of the tick, processed at once after all of them were updated.
+	 * Kept between ticks so its storage is only allocated when a controller is added.
+	 */
+	FMotionBatch MotionBatch;
+	TArray<FPendingMotion> PendingMotion;
 	/**
 	 * Handles application-level messages and events, facilitating communication
 	 * between the application framework and platform-specific input systems.
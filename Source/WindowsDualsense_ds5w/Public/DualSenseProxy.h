@@ -12,6 +12,8 @@
 #include "Runtime/ApplicationCore/Public/GenericPlatform/IInputInterface.h"
 #include "Core/Enums/EDeviceCommons.h"
 #include "Core/Structs/FDualSenseFeatureReport.h"
+#include "Core/Structs/FTriggerEffectBlob.h"
+#include "Core/TriggerEffectSequence.h"
 #include "Core/Interfaces/SonyGamepadInterface.h"
 #include "Core/Interfaces/SonyGamepadTriggerInterface.h"
 #include "DualSenseProxy.generated.h"
@@ -262,6 +264,146 @@ public:
 		EControllerHand Hand
 	);
 
+	/**
+	 * Applies a trigger effect baked with one of the `Bake` functions.
+	 *
+	 * Baked effects are encoded once and only copied into the output report when applied, so
+	 * they are meant to be created at load time, stored, and applied as often as needed on
+	 * any controller.
+	 *
+	 * @param ControllerId The ID of the controller to apply the effect to.
+	 * @param Effect The baked effect. An empty effect is ignored.
+	 * @param Hand The hand (left or right) where the effect will be applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DualSense Effects|Baked")
+	static void ApplyTriggerEffect(int32 ControllerId, const FTriggerEffectBlob& Effect, EControllerHand Hand);
+
+	/**
+	 * Plays a keyframed trigger effect sequence on a DualSense controller.
+	 *
+	 * The plugin plays the sequence on its own timer, at the output report rate and
+	 * independently of the frame rate, so it does not need to be driven from Tick. Playing
+	 * another sequence on the same trigger replaces it.
+	 *
+	 * @param ControllerId The ID of the controller to play the sequence on.
+	 * @param Sequence The sequence asset. The keyframes are copied when playback starts.
+	 * @param Hand The hand (left or right) whose trigger plays the sequence.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DualSense Effects|Sequence")
+	static void PlayTriggerSequence(int32 ControllerId, UTriggerEffectSequence* Sequence, EControllerHand Hand);
+
+	/**
+	 * Stops the trigger effect sequence playing on a DualSense controller. The trigger goes
+	 * back to the last effect set on it.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param Hand The hand (left or right) whose sequence is stopped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DualSense Effects|Sequence")
+	static void StopTriggerSequence(int32 ControllerId, EControllerHand Hand);
+
+	/**
+	 * Bakes the automatic gun effect, see `AutomaticGun`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeAutomaticGun(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 BeginStrength,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 MiddleStrength,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndStrength,
+		bool KeepEffect
+	);
+
+	/**
+	 * Bakes the resistance effect, see `Resistance`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeResistance(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 Strength
+	);
+
+	/**
+	 * Bakes the continuous resistance effect, see `ContinuousResistance`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeContinuousResistance(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 Strength
+	);
+
+	/**
+	 * Bakes the bow effect, see `Bow`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeBow(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 BeginStrength,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndStrength
+	);
+
+	/**
+	 * Bakes the galloping effect, see `Galloping`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeGalloping(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 FirstFoot,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 SecondFoot,
+		UPARAM(meta = (ClampMin = "0.001", ClampMax = "1.0", UIMin = "0.001", UIMax = "1.0"))
+		float Frequency
+	);
+
+	/**
+	 * Bakes the machine effect, see `Machine`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeMachine(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 FirstFoot,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 LasFoot,
+		UPARAM(meta = (ClampMin = "0.015", ClampMax = "1.0", UIMin = "0.01", UIMax = "1.0"))
+		float Frequency,
+		UPARAM(meta = (ClampMin = "0.015", ClampMax = "1.0", UIMin = "0.01", UIMax = "1.0"))
+		float Period
+	);
+
+	/**
+	 * Bakes the weapon effect, see `Weapon`.
+	 */
+	UFUNCTION(BlueprintPure, Category = "DualSense Effects|Baked")
+	static FTriggerEffectBlob BakeWeapon(
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 StartPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 EndPosition,
+		UPARAM(meta = (ClampMin = "0", ClampMax = "8", UIMin = "0", UIMax = "8"))
+		int32 Strength
+	);
+
 	// /**
 	//  * Updates the LED color effects on a DualSense controller using the specified color.
 	//  *
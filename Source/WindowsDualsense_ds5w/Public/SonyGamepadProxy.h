@@ -8,7 +8,10 @@
 #include "UObject/Object.h"
 #include "Core/Enums/EDeviceCommons.h"
 #include "Core/Enums/EDeviceConnection.h"
+#include "Core/Structs/FTouchGestureSettings.h"
+#if PLATFORM_WINDOWS
 #include "Windows/WindowsApplication.h"
+#endif
 #include "SonyGamepadProxy.generated.h"
 
 
@@ -121,6 +124,24 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Touch")
 	static void EnableTouch(int32 ControllerId, bool bEnableTouch);
+	/**
+	 * Enables or disables the touchpad gestures of a controller, which are disabled by default.
+	 * Taps and swipes are sent as the PS_TouchTap, PS_TouchDoubleTap and PS_TouchSwipe keys,
+	 * pinches and two-finger scrolls as the PS_TouchPinch, PS_TouchScrollX and PS_TouchScrollY axes.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param bEnable True to recognize gestures.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Touch")
+	static void EnableTouchGestures(int32 ControllerId, bool bEnable);
+	/**
+	 * Replaces the thresholds the touchpad gestures of a controller are recognized with.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param Settings The new thresholds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad: Dualsense or DualShock Touch")
+	static void SetTouchGestureSettings(int32 ControllerId, const FTouchGestureSettings& Settings);
 	/**
 	 * Enables or disables the gyroscope functionality for a specified DualSense controller.
 	 *
@@ -129,6 +150,52 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
 	static void EnableGyroscopeValues(int32 ControllerId, bool bEnableGyroscope);
+	/**
+	 * Retrieves the orientation of the controller fused from its gyroscope and accelerometer.
+	 *
+	 * The orientation is tracked by the plugin for every report the controller sends, so it
+	 * does not depend on the frame rate. Pitch and roll are relative to gravity; yaw is relative
+	 * to the heading of the controller when tracking started or was last reset.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param Orientation Receives the orientation, X forward and Z up.
+	 * @return True if an orientation is available for the controller.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
+	static bool GetMotionOrientation(int32 ControllerId, FRotator& Orientation);
+	/**
+	 * Restarts orientation tracking, making the current heading of the controller yaw zero.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
+	static void ResetMotionOrientation(int32 ControllerId);
+	/**
+	 * Retrieves the motion of the controller during the last input tick.
+	 *
+	 * The rotation is integrated from every gyroscope sample the controller sent during the
+	 * tick, so it is suited to gyro aiming: adding it to the aim every frame tracks the
+	 * controller exactly, at any frame rate.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param RotationDegrees Rotation around the X, Y and Z axes of the controller, in degrees.
+	 * @param AverageAcceleration Mean raw acceleration over the tick.
+	 * @param DeltaSeconds Controller time covered by the tick.
+	 * @return True if motion is available for the controller.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
+	static bool GetMotionDelta(int32 ControllerId, FVector& RotationDegrees, FVector& AverageAcceleration,
+	                           float& DeltaSeconds);
+	/**
+	 * Enables or disables background calibration of the gyroscope. While enabled, which is the
+	 * default, the plugin measures the gyroscope bias again every time the controller rests,
+	 * so motion input stays calibrated without calling StartMotionSensorCalibration.
+	 *
+	 * @param ControllerId The ID of the controller.
+	 * @param bEnable True to recalibrate automatically.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SonyGamepad|Motion Sensors")
+	static void EnableMotionAutoCalibration(int32 ControllerId, bool bEnable);
 	/**
 	 * Remaps the specified gamepad ID to a new user and updates the old user's settings accordingly.
 	 *
@@ -16,6 +16,7 @@ public class WindowsDualsense_ds5w : ModuleRules
 	    if (Target.Platform == UnrealTargetPlatform.Win64)
 	    {
 		    PublicSystemLibraries.Add("hid.lib");
+		    PublicSystemLibraries.Add("cfgmgr32.lib");
 	    }
 	}
 }
\ No newline at end of file